@@ -17,6 +17,7 @@
 #include "BaseTypes.hpp"
 #include "Vector.hpp"
 #include "HashMap.hpp"
+#include "StringPool.hpp"
 #include "Exception.hpp"
 
 #include "SharedPointer.hpp"
@@ -215,7 +216,7 @@ private:
 	Vector<String> m_megs;
 	String m_versionInfo;
 	
-	HashMap<String, Vector<String>> m_optionMap;
+	HashMap<InternedString, Vector<String>> m_optionMap;	// option names interned in StringPool::global()
 	Vector<Argument> m_result;
 	e_int m_curArg;
 	
@@ -247,7 +248,7 @@ public:
 			throw IllegalArgumentException{__func__, __LINE__};
 		
 		m_flags.add(String{L"--"} + flag);
-		String fixMeg = String::format(L"\t%-10s  %-15s%-s", String{L"--"}+flag+L":", String{}, meg);
+		String fixMeg = String::format(EASY_FORMAT(L"\t%-10s  %-15s%-s"), String{L"--"}+flag+L":", String{}, meg);
 		m_megs.add(fixMeg);
 	}
 	
@@ -267,7 +268,7 @@ public:
 			throw IllegalArgumentException{__func__, __LINE__};
 		
 		m_options.add(String{L"-"} + option);
-		String fixMeg = String::format(L"\t%-10s <%-15s%-s", String{L"-"}+option, holder+L">:", meg);
+		String fixMeg = String::format(EASY_FORMAT(L"\t%-10s <%-15s%-s"), String{L"-"}+option, holder+L">:", meg);
 		m_megs.add(fixMeg);
 	}
 	
@@ -424,7 +425,7 @@ public:
 	inline Vector<String>& getOptionValues(const String& option) const {
 		if (option.empty())
 			throw IllegalArgumentException{__func__, __LINE__};
-		return m_optionMap.get(option);
+		return m_optionMap.get(StringPool::global().lookup(option));
 	}
 	
 	/**
@@ -502,8 +503,9 @@ private:
 				String trimMinus = _current().substring(1);
 				Argument arg{Argument::OPTION, trimMinus};
 				if (!m_result.contains(arg)) m_result.add(arg);
+				InternedString optionName = StringPool::global().intern(trimMinus);
 				try {
-					Vector<String>& values = m_optionMap.get(trimMinus);
+					Vector<String>& values = m_optionMap.get(optionName);
 					String option = _current();
 					_advance();
 					if (!_isEnd() && _isOptionValue(_current())) {
@@ -518,8 +520,8 @@ private:
 					}
 				} catch (HasNoSuchElementException& e) {
 					Vector<String> tmpValues;
-					m_optionMap.put(trimMinus, tmpValues);
-					Vector<String>& values = m_optionMap.get(trimMinus);
+					m_optionMap.put(optionName, tmpValues);
+					Vector<String>& values = m_optionMap.get(optionName);
 					String option = _current();
 					_advance();
 					if (!_isEnd() && _isOptionValue(_current())) {
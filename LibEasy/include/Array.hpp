@@ -15,6 +15,7 @@
 #include "Exception.hpp"
 #include "StringBuffer.hpp"
 #include "System.hpp"
+#include "TypeTraits.hpp"
 
 namespace Easy {
 
@@ -504,6 +505,14 @@ private:
 		}
 	}
 }; // Array
+
+template<class E>
+struct IsTriviallyRelocatable<Array<E>> {
+	static constexpr e_bool value = true;
+};
+
+template<class E>
+constexpr e_bool IsTriviallyRelocatable<Array<E>>::value;
 } // Easy
 
 #endif // _EASY_ARRAY_H_
@@ -0,0 +1,700 @@
+/*
+ * 文件名: BTree.hpp
+ *
+ * 日期/时间:
+ *		开始: 2026年10月18日 00:41:09 周日
+ *		结束:
+ *
+ * 版本: 1.0
+ *
+ * 作者: Tes Alone
+ *
+ * 备注:
+*/
+
+#ifndef _EASY_BTREE_H_
+#define _EASY_BTREE_H_
+
+#include "BaseTypes.hpp"
+#include "Exception.hpp"
+#include "Iterator.hpp"
+#include "Array.hpp"
+#include "System.hpp"
+
+namespace Easy {
+
+/*
+	从叶子中的元素取得键: BTreeSet 的元素就是键, BTreeMap 的元素是 MapEntry.
+*/
+template<class K, class E>
+struct BTreeKey {
+	static inline const K& of(const E& item) {return item.m_key;}
+};
+
+template<class K>
+struct BTreeKey<K, K> {
+	static inline const K& of(const K& item) {return item;}
+};
+
+/**
+	\class BTree
+
+	\brief BTreeMap 和 BTreeSet 的实现, 一棵 B+ 树.
+
+	元素按键的顺序连续存放在叶子中, 叶子从左到右连成链表; 内部节点只存放分隔键和子节点指针,
+	键也是连续存放的. 节点的大小约为 NODE_BYTES, 查找时每层只访问一两个缓存行, 顺序遍历只走叶子链表.
+	<br/>
+	除了根, 节点至少是半满的. 插入时节点满了就分裂, 删除时不足半满就向兄弟借一个或与兄弟合并.
+	在最后一个叶子的末尾插入时, 新元素单独放入新叶子, 所以按顺序插入得到的叶子是满的.
+	<br/>
+	K 需实现 compare(), K 和 E 需可以默认构造, 节点中未使用的位置存放默认构造或被移走的对象.
+	<br/>
+	增加或删除元素会使指向元素的指针和迭代器失效.
+
+	@since 1.0
+*/
+template<class K, class E>
+class BTree {
+public:
+	/**
+		\brief 节点大小的目标字节数.
+	*/
+	static constexpr e_int NODE_BYTES = 512;
+
+	/**
+		\brief 叶子最多容纳的元素个数, 在 8 到 64 之间, 总是偶数.
+	*/
+	static constexpr e_int LEAF_SIZE = sizeof(E) >= NODE_BYTES / 8 ? 8
+		: sizeof(E) <= NODE_BYTES / 64 ? 64 : (e_int)(NODE_BYTES / sizeof(E)) / 2 * 2;
+
+	/**
+		\brief 内部节点最多容纳的键个数, 在 8 到 64 之间, 总是偶数.
+	*/
+	static constexpr e_int INNER_SIZE = sizeof(K) >= NODE_BYTES / 8 ? 8
+		: sizeof(K) <= NODE_BYTES / 64 ? 64 : (e_int)(NODE_BYTES / sizeof(K)) / 2 * 2;
+
+private:
+	static constexpr e_int LEAF_MIN  = LEAF_SIZE / 2;
+	static constexpr e_int INNER_MIN = INNER_SIZE / 2;
+
+class Node {
+public:
+	e_int m_count;	// 叶子中的元素个数, 或内部节点中的键个数
+
+	Node() : m_count(0) {}
+}; // Node
+
+class Leaf : public Node {
+public:
+	E     m_items[LEAF_SIZE];
+	Leaf* m_next;
+
+	Leaf() : m_next(nullptr) {}
+}; // Leaf
+
+/*
+	m_children[i] 中的键都不小于 m_keys[i-1], 并且小于 m_keys[i].
+*/
+class Inner : public Node {
+public:
+	K     m_keys[INNER_SIZE];
+	Node* m_children[INNER_SIZE + 1];
+}; // Inner
+
+class BtIterator : public Iterator<E> {
+private:
+	const BTree*  m_tree;
+	const e_char* m_name;
+	e_int m_expectSize;
+	Leaf* m_leaf;
+	e_int m_index;
+public:
+	BtIterator(const BTree* tree, const e_char* name) {
+		m_tree  = tree;
+		m_name  = name;
+		m_expectSize = tree->m_size;
+		m_leaf  = tree->m_first;
+		m_index = 0;
+	}
+
+	~BtIterator() {}
+
+	e_bool isEnd() const override {
+		return m_leaf == nullptr;
+	}
+
+	E& current() const override {
+		if (isEnd())
+			throw IteratorIsEndException{__func__, __LINE__};
+		if (m_tree->m_size != m_expectSize)
+			throw ConcurrentModificationException(__func__, __LINE__, m_name);
+		return m_leaf->m_items[m_index];
+	}
+
+	e_bool advance() override {
+		if (m_leaf == nullptr) return false;
+		if (++m_index == m_leaf->m_count) {
+			m_leaf  = m_leaf->m_next;
+			m_index = 0;
+		}
+		return true;
+	}
+private:
+	BtIterator(BtIterator& copy) =delete;
+	BtIterator(BtIterator&& move) =delete;
+	BtIterator& operator=(BtIterator& copy) =delete;
+	BtIterator& operator=(BtIterator&& move) =delete;
+}; // BtIterator
+
+public:
+	/*
+		build() 的数据源, 依次返回另一棵树的元素.
+	*/
+	class LeafSource {
+	public:
+		explicit LeafSource(const BTree& tree) : m_leaf(tree.m_first), m_index(0) {}
+
+		inline const E& next() {
+			if (m_index == m_leaf->m_count) {
+				m_leaf  = m_leaf->m_next;
+				m_index = 0;
+			}
+			return m_leaf->m_items[m_index++];
+		}
+	private:
+		const Leaf* m_leaf;
+		e_int m_index;
+	}; // LeafSource
+
+	/*
+		build() 的数据源, 依次返回数组的元素.
+	*/
+	class ArraySource {
+	public:
+		explicit ArraySource(const Array<E>& items) : m_items(items), m_index(0) {}
+
+		inline const E& next() {
+			return m_items[m_index++];
+		}
+	private:
+		const Array<E>& m_items;
+		e_int m_index;
+	}; // ArraySource
+
+private:
+	Node* m_root;
+	Leaf* m_first;
+	Leaf* m_last;
+	e_int m_height;		// 根以下的层数, 根是叶子时为 0
+	e_int m_size;
+
+public:
+	BTree() {
+		_init();
+	}
+
+	~BTree() {
+		_dispose();
+	}
+
+	BTree(const BTree& copy) {
+		_init();
+		LeafSource source{copy};
+		build(copy.m_size, source);
+	}
+
+	BTree(BTree&& move) {
+		_steal(move);
+	}
+
+	BTree& operator=(const BTree& copy) {
+		if (this != &copy) {
+			LeafSource source{copy};
+			build(copy.m_size, source);
+		}
+		return *this;
+	}
+
+	BTree& operator=(BTree&& move) {
+		if (this != &move) {
+			_dispose();
+			_steal(move);
+		}
+		return *this;
+	}
+
+	/*
+		用按键严格递增的 count 个元素替换接受者的内容, 不需要比较和分裂, 叶子都是满的.
+		source.next() 依次返回元素. 如果元素不是严格递增的, 接受者为空, 抛出 IllegalArgumentException.
+	*/
+	template<class S>
+	e_void build(e_int count, S& source) {
+		_dispose();
+		_init();
+		if (count <= 0) return;
+
+		e_int leaves = (count + LEAF_SIZE - 1) / LEAF_SIZE;
+		Node** nodes = new Node*[leaves];
+		K* lows      = new K[leaves];
+		Leaf* prev   = nullptr;
+		const E* last = nullptr;
+		for (e_int l=0; l<leaves; l++) {
+			Leaf* leaf = new Leaf();
+			if (prev) prev->m_next = leaf; else m_first = leaf;
+			prev = leaf;
+			// 平均分配, 每个叶子至少半满.
+			e_int n = count / leaves + (l < count % leaves ? 1 : 0);
+			for (e_int j=0; j<n; j++) {
+				leaf->m_items[j] = source.next();
+				leaf->m_count++;
+				if (last && _key(*last).compare(_key(leaf->m_items[j])) >= 0) {
+					delete [] nodes;
+					delete [] lows;
+					_disposeLeaves(m_first);
+					_init();
+					throw IllegalArgumentException{__func__, __LINE__};
+				}
+				last = &leaf->m_items[j];
+			}
+			nodes[l] = leaf;
+			lows[l]  = _key(leaf->m_items[0]);
+		}
+		m_last = prev;
+
+		e_int m = leaves;
+		while (m > 1) {
+			e_int groups = (m + INNER_SIZE) / (INNER_SIZE + 1);
+			e_int pos = 0;
+			for (e_int g=0; g<groups; g++) {
+				e_int n = m / groups + (g < m % groups ? 1 : 0);
+				Inner* inner = new Inner();
+				inner->m_children[0] = nodes[pos];
+				for (e_int j=1; j<n; j++) {
+					inner->m_keys[j-1]   = System::move(lows[pos+j]);
+					inner->m_children[j] = nodes[pos+j];
+				}
+				inner->m_count = n - 1;
+				nodes[g] = inner;
+				if (g != pos) lows[g] = System::move(lows[pos]);
+				pos += n;
+			}
+			m = groups;
+			m_height++;
+		}
+		m_root = nodes[0];
+		m_size = count;
+		delete [] nodes;
+		delete [] lows;
+	}
+
+	/*
+		查找键为 key 的元素, 不存在时返回 nullptr.
+	*/
+	E* find(const K& key) const {
+		if (m_root == nullptr) return nullptr;
+		Node* node = m_root;
+		for (e_int h=m_height; h>0; h--) {
+			Inner* inner = static_cast<Inner*>(node);
+			_prefetch(inner->m_keys, sizeof(inner->m_keys));
+			node = inner->m_children[_upperBound(inner, key)];
+		}
+		Leaf* leaf = static_cast<Leaf*>(node);
+		_prefetch(leaf->m_items, sizeof(leaf->m_items));
+		e_int i = _lowerBound(leaf, key);
+		if (i < leaf->m_count && _key(leaf->m_items[i]).compare(key) == 0) {
+			return &leaf->m_items[i];
+		}
+		return nullptr;
+	}
+
+	/*
+		插入 item, 键已经存在时不插入.
+		返回接受者中键与 item 相等的元素, added 表示 item 是否被移入接受者.
+	*/
+	E* insert(E& item, e_bool& added) {
+		if (m_root == nullptr) {
+			m_root = m_first = m_last = new Leaf();
+			m_height = 0;
+		}
+		K upKey;
+		Node* upNode = nullptr;
+		E* result = _insert(m_root, m_height, item, _key(item), added, upKey, upNode);
+		if (upNode) {
+			Inner* root = new Inner();
+			root->m_keys[0]     = System::move(upKey);
+			root->m_children[0] = m_root;
+			root->m_children[1] = upNode;
+			root->m_count = 1;
+			m_root = root;
+			m_height++;
+		}
+		if (added) m_size++;
+		return result;
+	}
+
+	/*
+		删除键为 key 的元素, 移入 removed. 不存在时返回假.
+	*/
+	e_bool remove(const K& key, E& removed) {
+		if (m_root == nullptr || !_remove(m_root, m_height, key, removed)) {
+			return false;
+		}
+		m_size--;
+		if (m_root->m_count == 0) {
+			if (m_height > 0) {
+				Inner* old = static_cast<Inner*>(m_root);
+				m_root = old->m_children[0];
+				m_height--;
+				delete old;
+			} else {
+				delete static_cast<Leaf*>(m_root);
+				_init();
+			}
+		}
+		return true;
+	}
+
+	inline E* first() const {
+		return m_first ? &m_first->m_items[0] : nullptr;
+	}
+
+	inline E* last() const {
+		return m_last ? &m_last->m_items[m_last->m_count - 1] : nullptr;
+	}
+
+	inline e_int size() const {
+		return m_size;
+	}
+
+	/*
+		name 是迭代器检测到并发修改时报告的容器名.
+	*/
+	inline Iterator<E>* iterator(const e_char* name) const {
+		return new BtIterator{this, name};
+	}
+
+	e_void clean() {
+		_dispose();
+		_init();
+	}
+
+private:
+	static inline const K& _key(const E& item) {
+		return BTreeKey<K, E>::of(item);
+	}
+
+	/*
+		二分查找依次访问节点中相距很远的位置, 每次都是一次缓存缺失.
+		进入节点时先预取整个键数组, 这些缺失就同时发生, 而不是一个接一个.
+	*/
+	static inline e_void _prefetch(const e_void* data, e_int bytes) {
+		for (e_int offset=0; offset<bytes; offset+=64) {
+			__builtin_prefetch(static_cast<const e_byte*>(data) + offset);
+		}
+	}
+
+	/*
+		二分查找每次只根据比较结果选择下一段的起点, 编译器可以用条件传送代替分支,
+		随机查找时不会每层都预测失败.
+	*/
+
+	// 第一个不小于 key 的元素的位置.
+	static inline e_int _lowerBound(const Leaf* leaf, const K& key) {
+		e_int n = leaf->m_count;
+		if (n == 0) return 0;
+		e_int low = 0;
+		while (n > 1) {
+			e_int half = n >> 1;
+			low += _key(leaf->m_items[low + half - 1]).compare(key) < 0 ? half : 0;
+			n -= half;
+		}
+		return low + (_key(leaf->m_items[low]).compare(key) < 0 ? 1 : 0);
+	}
+
+	// 第一个大于 key 的分隔键的位置, 也就是 key 所在子节点的位置.
+	static inline e_int _upperBound(const Inner* inner, const K& key) {
+		e_int n = inner->m_count;
+		e_int low = 0;
+		while (n > 1) {
+			e_int half = n >> 1;
+			low += inner->m_keys[low + half - 1].compare(key) <= 0 ? half : 0;
+			n -= half;
+		}
+		return low + (inner->m_keys[low].compare(key) <= 0 ? 1 : 0);
+	}
+
+	e_void _init() {
+		m_root   = nullptr;
+		m_first  = nullptr;
+		m_last   = nullptr;
+		m_height = 0;
+		m_size   = 0;
+	}
+
+	e_void _steal(BTree& move) {
+		m_root   = move.m_root;
+		m_first  = move.m_first;
+		m_last   = move.m_last;
+		m_height = move.m_height;
+		m_size   = move.m_size;
+		move._init();
+	}
+
+	e_void _dispose() {
+		if (m_root == nullptr) return;
+		_disposeInner(m_root, m_height);
+		_disposeLeaves(m_first);
+	}
+
+	// 只释放内部节点, 叶子通过链表释放.
+	static e_void _disposeInner(Node* node, e_int height) {
+		if (height == 0) return;
+		Inner* inner = static_cast<Inner*>(node);
+		for (e_int i=0; i<=inner->m_count; i++) {
+			_disposeInner(inner->m_children[i], height - 1);
+		}
+		delete inner;
+	}
+
+	static e_void _disposeLeaves(Leaf* leaf) {
+		while (leaf) {
+			Leaf* next = leaf->m_next;
+			delete leaf;
+			leaf = next;
+		}
+	}
+
+	/*
+		key 引用 item 的键, item 被移走之后不再使用.
+		节点分裂时, upKey 和 upNode 返回右半部分的最小键和右半部分; 否则 upNode 为 nullptr.
+	*/
+	E* _insert(Node* node, e_int height, E& item, const K& key, e_bool& added, K& upKey, Node*& upNode) {
+		upNode = nullptr;
+		if (height == 0) {
+			Leaf* leaf = static_cast<Leaf*>(node);
+			_prefetch(leaf->m_items, sizeof(leaf->m_items));
+			e_int i = _lowerBound(leaf, key);
+			if (i < leaf->m_count && _key(leaf->m_items[i]).compare(key) == 0) {
+				added = false;
+				return &leaf->m_items[i];
+			}
+			added = true;
+			if (leaf->m_count < LEAF_SIZE) {
+				return _insertAt(leaf, i, item);
+			}
+
+			// 在最后一个叶子的末尾插入时不平分, 顺序插入的叶子都是满的.
+			e_int mid = (leaf == m_last && i == LEAF_SIZE) ? LEAF_SIZE : LEAF_SIZE / 2;
+			Leaf* right = new Leaf();
+			for (e_int j=mid; j<LEAF_SIZE; j++) {
+				right->m_items[j-mid] = System::move(leaf->m_items[j]);
+			}
+			right->m_count = LEAF_SIZE - mid;
+			leaf->m_count  = mid;
+			right->m_next  = leaf->m_next;
+			leaf->m_next   = right;
+			if (leaf == m_last) m_last = right;
+
+			E* result = (mid == LEAF_SIZE || i > mid) ? _insertAt(right, i - mid, item) : _insertAt(leaf, i, item);
+			upKey  = _key(right->m_items[0]);
+			upNode = right;
+			return result;
+		}
+
+		Inner* inner = static_cast<Inner*>(node);
+		_prefetch(inner->m_keys, sizeof(inner->m_keys));
+		e_int ci = _upperBound(inner, key);
+		K childKey;
+		Node* childNode = nullptr;
+		E* result = _insert(inner->m_children[ci], height - 1, item, key, added, childKey, childNode);
+		if (childNode == nullptr) {
+			return result;
+		}
+		if (inner->m_count < INNER_SIZE) {
+			_insertAt(inner, ci, childKey, childNode);
+			return result;
+		}
+
+		// 连同新键共 INNER_SIZE+1 个键, 中间的键上移, 两边各 INNER_SIZE/2 个.
+		const e_int mid = INNER_SIZE / 2;
+		Inner* right = new Inner();
+		if (ci < mid) {
+			upKey = System::move(inner->m_keys[mid-1]);
+			for (e_int j=mid; j<INNER_SIZE; j++) right->m_keys[j-mid] = System::move(inner->m_keys[j]);
+			for (e_int j=mid; j<=INNER_SIZE; j++) right->m_children[j-mid] = inner->m_children[j];
+			right->m_count = INNER_SIZE - mid;
+			inner->m_count = mid - 1;
+			_insertAt(inner, ci, childKey, childNode);
+		} else if (ci == mid) {
+			upKey = System::move(childKey);
+			right->m_children[0] = childNode;
+			for (e_int j=mid; j<INNER_SIZE; j++) {
+				right->m_keys[j-mid]       = System::move(inner->m_keys[j]);
+				right->m_children[j-mid+1] = inner->m_children[j+1];
+			}
+			right->m_count = INNER_SIZE - mid;
+			inner->m_count = mid;
+		} else {
+			upKey = System::move(inner->m_keys[mid]);
+			for (e_int j=mid+1; j<INNER_SIZE; j++) right->m_keys[j-mid-1] = System::move(inner->m_keys[j]);
+			for (e_int j=mid+1; j<=INNER_SIZE; j++) right->m_children[j-mid-1] = inner->m_children[j];
+			right->m_count = INNER_SIZE - mid - 1;
+			inner->m_count = mid;
+			_insertAt(right, ci - mid - 1, childKey, childNode);
+		}
+		upNode = right;
+		return result;
+	}
+
+	static E* _insertAt(Leaf* leaf, e_int i, E& item) {
+		for (e_int j=leaf->m_count; j>i; j--) {
+			leaf->m_items[j] = System::move(leaf->m_items[j-1]);
+		}
+		leaf->m_items[i] = System::move(item);
+		leaf->m_count++;
+		return &leaf->m_items[i];
+	}
+
+	// 在 i 处插入键, child 成为它右边的子节点.
+	static e_void _insertAt(Inner* inner, e_int i, K& key, Node* child) {
+		for (e_int j=inner->m_count; j>i; j--) {
+			inner->m_keys[j]       = System::move(inner->m_keys[j-1]);
+			inner->m_children[j+1] = inner->m_children[j];
+		}
+		inner->m_keys[i]       = System::move(key);
+		inner->m_children[i+1] = child;
+		inner->m_count++;
+	}
+
+	// 删除键 i 和它右边的子节点.
+	static e_void _removeAt(Inner* inner, e_int i) {
+		for (e_int j=i; j<inner->m_count-1; j++) {
+			inner->m_keys[j]       = System::move(inner->m_keys[j+1]);
+			inner->m_children[j+1] = inner->m_children[j+2];
+		}
+		inner->m_count--;
+	}
+
+	e_bool _remove(Node* node, e_int height, const K& key, E& removed) {
+		if (height == 0) {
+			Leaf* leaf = static_cast<Leaf*>(node);
+			e_int i = _lowerBound(leaf, key);
+			if (i == leaf->m_count || _key(leaf->m_items[i]).compare(key) != 0) {
+				return false;
+			}
+			removed = System::move(leaf->m_items[i]);
+			for (e_int j=i+1; j<leaf->m_count; j++) {
+				leaf->m_items[j-1] = System::move(leaf->m_items[j]);
+			}
+			leaf->m_count--;
+			return true;
+		}
+
+		Inner* inner = static_cast<Inner*>(node);
+		e_int ci = _upperBound(inner, key);
+		if (!_remove(inner->m_children[ci], height - 1, key, removed)) {
+			return false;
+		}
+		if (height == 1) {
+			if (inner->m_children[ci]->m_count < LEAF_MIN) _fixLeaf(inner, ci);
+		} else {
+			if (inner->m_children[ci]->m_count < INNER_MIN) _fixInner(inner, ci);
+		}
+		return true;
+	}
+
+	// 叶子 ci 不足半满: 向左或右兄弟借一个元素, 兄弟也只有半满时合并.
+	e_void _fixLeaf(Inner* parent, e_int ci) {
+		Leaf* child = static_cast<Leaf*>(parent->m_children[ci]);
+		Leaf* left  = ci > 0 ? static_cast<Leaf*>(parent->m_children[ci-1]) : nullptr;
+		Leaf* right = ci < parent->m_count ? static_cast<Leaf*>(parent->m_children[ci+1]) : nullptr;
+
+		if (left && left->m_count > LEAF_MIN) {
+			for (e_int j=child->m_count; j>0; j--) {
+				child->m_items[j] = System::move(child->m_items[j-1]);
+			}
+			child->m_items[0] = System::move(left->m_items[left->m_count-1]);
+			child->m_count++;
+			left->m_count--;
+			parent->m_keys[ci-1] = _key(child->m_items[0]);
+		} else if (right && right->m_count > LEAF_MIN) {
+			child->m_items[child->m_count++] = System::move(right->m_items[0]);
+			for (e_int j=1; j<right->m_count; j++) {
+				right->m_items[j-1] = System::move(right->m_items[j]);
+			}
+			right->m_count--;
+			parent->m_keys[ci] = _key(right->m_items[0]);
+		} else {
+			_mergeLeaves(parent, left ? ci - 1 : ci);
+		}
+	}
+
+	// 把叶子 i+1 并入叶子 i.
+	e_void _mergeLeaves(Inner* parent, e_int i) {
+		Leaf* left  = static_cast<Leaf*>(parent->m_children[i]);
+		Leaf* right = static_cast<Leaf*>(parent->m_children[i+1]);
+		for (e_int j=0; j<right->m_count; j++) {
+			left->m_items[left->m_count++] = System::move(right->m_items[j]);
+		}
+		left->m_next = right->m_next;
+		if (right == m_last) m_last = left;
+		delete right;
+		_removeAt(parent, i);
+	}
+
+	// 内部节点 ci 不足半满: 经过父节点向兄弟借一个键, 兄弟也只有半满时合并.
+	e_void _fixInner(Inner* parent, e_int ci) {
+		Inner* child = static_cast<Inner*>(parent->m_children[ci]);
+		Inner* left  = ci > 0 ? static_cast<Inner*>(parent->m_children[ci-1]) : nullptr;
+		Inner* right = ci < parent->m_count ? static_cast<Inner*>(parent->m_children[ci+1]) : nullptr;
+
+		if (left && left->m_count > INNER_MIN) {
+			child->m_children[child->m_count+1] = child->m_children[child->m_count];
+			for (e_int j=child->m_count; j>0; j--) {
+				child->m_keys[j]     = System::move(child->m_keys[j-1]);
+				child->m_children[j] = child->m_children[j-1];
+			}
+			child->m_keys[0]     = System::move(parent->m_keys[ci-1]);
+			child->m_children[0] = left->m_children[left->m_count];
+			child->m_count++;
+			parent->m_keys[ci-1] = System::move(left->m_keys[left->m_count-1]);
+			left->m_count--;
+		} else if (right && right->m_count > INNER_MIN) {
+			child->m_keys[child->m_count]       = System::move(parent->m_keys[ci]);
+			child->m_children[child->m_count+1] = right->m_children[0];
+			child->m_count++;
+			parent->m_keys[ci] = System::move(right->m_keys[0]);
+			for (e_int j=1; j<right->m_count; j++) {
+				right->m_keys[j-1] = System::move(right->m_keys[j]);
+			}
+			for (e_int j=1; j<=right->m_count; j++) {
+				right->m_children[j-1] = right->m_children[j];
+			}
+			right->m_count--;
+		} else {
+			e_int i = left ? ci - 1 : ci;
+			left  = static_cast<Inner*>(parent->m_children[i]);
+			right = static_cast<Inner*>(parent->m_children[i+1]);
+			left->m_keys[left->m_count] = System::move(parent->m_keys[i]);
+			for (e_int j=0; j<right->m_count; j++) {
+				left->m_keys[left->m_count+1+j] = System::move(right->m_keys[j]);
+			}
+			for (e_int j=0; j<=right->m_count; j++) {
+				left->m_children[left->m_count+1+j] = right->m_children[j];
+			}
+			left->m_count += right->m_count + 1;
+			delete right;
+			_removeAt(parent, i);
+		}
+	}
+}; // BTree
+
+template<class K, class E> constexpr e_int BTree<K, E>::NODE_BYTES;
+template<class K, class E> constexpr e_int BTree<K, E>::LEAF_SIZE;
+template<class K, class E> constexpr e_int BTree<K, E>::INNER_SIZE;
+template<class K, class E> constexpr e_int BTree<K, E>::LEAF_MIN;
+template<class K, class E> constexpr e_int BTree<K, E>::INNER_MIN;
+
+} // Easy
+
+#endif // _EASY_BTREE_H_
@@ -0,0 +1,339 @@
+/*
+ * 文件名: BTreeMap.hpp
+ *
+ * 日期/时间:
+ *		开始: 2026年10月18日 01:52:14 周日
+ *		结束:
+ *
+ * 版本: 1.0
+ *
+ * 作者: Tes Alone
+ *
+ * 备注:
+*/
+
+#ifndef _EASY_BTREEMAP_H_
+#define _EASY_BTREEMAP_H_
+
+#include "BaseTypes.hpp"
+#include "Exception.hpp"
+#include "MapEntry.hpp"
+#include "Iterator.hpp"
+#include "Array.hpp"
+#include "Container.hpp"
+#include "System.hpp"
+#include "BTree.hpp"
+#include "BTreeSet.hpp"
+
+namespace Easy {
+
+/**
+	\class BTreeMap
+
+	\brief B+ 树实现的有序 map.
+
+	接口与 TreeMap 相同. 键/值连续存放在叶子中, 内部节点只存放键,
+	查找时每层只有一两次缓存缺失, 而红黑树每层一次; 每个键/值也不需要单独的节点和三个指针.
+	<br/>
+	与 TreeMap 不同, put() 和 remove() 会移动其他键/值, 使 get() 等返回的引用失效.
+	<br/>
+	已经排好序的键/值应使用 BTreeMap(const Array<MapEntry<K, V>>&) 一次建成.
+
+	@since 1.0
+*/
+template<class K, class V>
+class BTreeMap {
+
+typedef BTree<K, MapEntry<K, V>> Tree;
+
+class KeySource {
+public:
+	explicit KeySource(const Tree& tree) : m_entries(tree) {}
+
+	inline const K& next() {
+		return m_entries.next().m_key;
+	}
+private:
+	typename Tree::LeafSource m_entries;
+}; // KeySource
+
+private:
+	Tree m_tree;
+
+public:
+	/**
+		\brief 构造函数.
+	*/
+	BTreeMap() {}
+
+	/**
+		\brief 构造函数.
+
+		从按键排好序的键/值批量建立 map, 不需要比较和分裂.
+
+		@param sorted 按键严格递增的键/值.
+		@throw 如果 sorted 的键不是严格递增的, 抛出 IllegalArgumentException.
+	*/
+	explicit BTreeMap(const Array<MapEntry<K, V>>& sorted) {
+		typename Tree::ArraySource source{sorted};
+		m_tree.build(sorted.length(), source);
+	}
+
+	/**
+		\brief 等于函数.
+
+		集合元素需实现 equals() 方法.
+
+		@param other 一个集合.
+		@return 如果接受者和 other 的元素对应相等, 返回真; 否则, 返回假.
+	*/
+	inline e_bool equals(const BTreeMap<K,V>& other) const {
+		return Container::equals<BTreeMap<K,V>, BTreeMap<K,V>, MapEntry<K,V>>(*this, other);
+	}
+
+	/**
+		\brief 比较函数.
+
+		集合元素需实现 compare() 方法.
+
+		@param other 集合对象.
+		@return 如果接受者的元素按顺序大于 other 的元素, 返回 1; 等于返回 0; 小于返回 -1.
+	*/
+	inline e_int compare(const BTreeMap<K,V>& other) const {
+		return Container::compare<BTreeMap<K,V>, BTreeMap<K,V>, MapEntry<K,V>>(*this, other);
+	}
+
+	/**
+	 * \brief 哈希函数.
+	 *
+	 * @return 接受者的哈希值.
+	*/
+	inline e_int hashCode() const {return Long::hashCode(reinterpret_cast<e_long>(this));}
+
+	/**
+	 * \brief 转到字符串.
+	 *
+	 * 集合的元素需实现 toString() 方法.
+	 *
+	 * @return 接受者的字符串表示.
+	*/
+	inline String toString() const {
+		return System::move(Container::toString<BTreeMap<K,V>, MapEntry<K,V>>(*this));
+	}
+
+	/**
+		\brief 添加键与值.
+
+		如果接受者中包含与 key 等价的键, 函数不会再次添加.
+
+		@param key 要添加的键.
+		@param value 要添加的值.
+		@return 被添加的键.
+	*/
+	inline K& put(const K& key, const V& value) {
+		MapEntry<K, V> entry{key, value};
+		return _put(entry);
+	}
+
+	/**
+		\brief 添加键与值.
+
+		如果接受者中包含与 key 等价的键, 函数不会再次添加.
+
+		@param key 要添加的键.
+		@param value 要添加的值.
+		@return 被添加的键.
+	*/
+	inline K& put(K&& key, const V& value) {
+		MapEntry<K, V> entry{System::move(key), value};
+		return _put(entry);
+	}
+
+	/**
+		\brief 添加键与值.
+
+		如果接受者中包含与 key 等价的键, 函数不会再次添加.
+
+		@param key 要添加的键.
+		@param value 要添加的值.
+		@return 被添加的键.
+	*/
+	inline K& put(const K& key, V&& value) {
+		MapEntry<K, V> entry{key, System::move(value)};
+		return _put(entry);
+	}
+
+	/**
+		\brief 添加键与值.
+
+		如果接受者中包含与 key 等价的键, 函数不会再次添加.
+
+		@param key 要添加的键.
+		@param value 要添加的值.
+		@return 被添加的键.
+	*/
+	inline K& put(K&& key, V&& value) {
+		MapEntry<K, V> entry{System::move(key), System::move(value)};
+		return _put(entry);
+	}
+
+	/**
+	 * \brief 根据键获取值.
+	 *
+	 * @param key 键
+	 * @return key 对应的值.
+	 * @throw 如果接受者不包含 key, 抛出 HasNoSuchElementException.
+	*/
+	V& get(const K& key) const {
+		MapEntry<K, V>* entry = m_tree.find(key);
+		if (entry == nullptr)
+			throw  HasNoSuchElementException{__func__, __LINE__, String{L"BTreeMap"}};
+		return entry->m_value;
+	}
+
+	/**
+	 * \brief 根据键获取值.
+	 *
+	 * @param key 键
+	 * @return key 对应的值.
+	 * @throw 如果接受者不包含 key, 抛出 HasNoSuchElementException.
+	*/
+	V& operator[](const K& key) const {
+		return get(key);
+	}
+
+	/**
+	 * \brief 根据键获取值, 不包含时不抛出异常.
+	 *
+	 * @param key 键
+	 * @return 指向 key 对应的值的指针, 如果接受者不包含 key, 返回 nullptr.
+	 *         put() 及 remove() 之后指针可能失效.
+	*/
+	inline V* tryGet(const K& key) const {
+		MapEntry<K, V>* entry = m_tree.find(key);
+		return entry ? &entry->m_value : nullptr;
+	}
+
+	/**
+	 * \brief 根据键查找键/值, 不包含时不抛出异常.
+	 *
+	 * @param key 键
+	 * @return 指向接受者中的键/值的指针, 如果接受者不包含 key, 返回 nullptr. 不能通过指针修改键.
+	*/
+	inline MapEntry<K, V>* find(const K& key) const {
+		return m_tree.find(key);
+	}
+
+	/**
+	 * \brief 删除键与值.
+	 *
+	 * @param key 键, 用于搜索值.
+	 * @return 被删除的键/值的值.
+	 * @throw 如果接受者不包含 key, 抛出 HasNoSuchElementException.
+	*/
+	V remove(const K& key) {
+		MapEntry<K, V> removed;
+		if (!m_tree.remove(key, removed)) {
+			throw  HasNoSuchElementException{__func__, __LINE__, String{L"BTreeMap"}};
+		}
+		return System::move(removed.m_value);
+	}
+
+	/**
+		\brief 判断接受者是否包含指定键.
+
+		@param key 欲查找的键.
+		@return 如果接受者包含 key, 返回真; 否则, 返回假.
+	*/
+	inline e_bool contains(const K& key) const {
+		return m_tree.find(key) != nullptr;
+	}
+
+	/**
+	 * \brief 获取最大键的值.
+	 *
+	 * @return 接受者中的最大键的值.
+	 * @throw 如果接受者空, 抛出 EmptyContainerException.
+	*/
+	V& max() const {
+		MapEntry<K, V>* _max = m_tree.last();
+		if (_max == nullptr) {
+			throw  EmptyContainerException{__func__, __LINE__, String{L"BTreeMap"}};
+		}
+		return _max->m_value;
+	}
+
+	/**
+	 * \brief 获取最小键的值.
+	 *
+	 * @return 接受者中的最小键的值.
+	 * @throw 如果接受者空, 抛出 EmptyContainerException.
+	*/
+	V& min() const {
+		MapEntry<K, V>* _min = m_tree.first();
+		if (_min == nullptr) {
+			throw  EmptyContainerException{__func__, __LINE__, String{L"BTreeMap"}};
+		}
+		return _min->m_value;
+	}
+
+	/**
+	 * \brief 获取元素个数.
+	 *
+	 * @return 接受者包含的元素个数.
+	*/
+	inline e_int size() const {
+		return m_tree.size();
+	}
+
+	/**
+	 * \brief 检查集合是否为空.
+	 *
+	 * @return 如果集合为空, 返回真; 否则, 返回假.
+	*/
+	inline e_bool empty() const {
+		return m_tree.size() == 0;
+	}
+
+	/**
+	 * \brief 清空容器.
+	*/
+	inline e_void clean() {
+		m_tree.clean();
+	}
+
+	/**
+	 * \brief 获取迭代器.
+	 *
+	 * 迭代器按键从小到大的顺序遍历叶子链表.
+	 *
+	 * @return 接受者的迭代器.
+	*/
+	inline Iterator<MapEntry<K, V>>* iterator() const {
+		return m_tree.iterator(L"BTreeMap");
+	}
+
+	/**
+	 * \brief 获取键集合.
+	 *
+	 * 键已经有序, 集合直接批量建立.
+	 *
+	 * @return 接受者的所有键.
+	*/
+	BTreeSet<K> keySet() const {
+		BTreeSet<K> set;
+		KeySource source{m_tree};
+		set.m_tree.build(m_tree.size(), source);
+		return System::move(set);
+	}
+
+private:
+	inline K& _put(MapEntry<K, V>& entry) {
+		e_bool added;
+		return m_tree.insert(entry, added)->m_key;
+	}
+}; // BTreeMap
+
+} // Easy
+
+#endif // _EASY_BTREEMAP_H_
@@ -0,0 +1,243 @@
+/*
+ * 文件名: BTreeSet.hpp
+ *
+ * 日期/时间:
+ *		开始: 2026年10月18日 01:26:37 周日
+ *		结束:
+ *
+ * 版本: 1.0
+ *
+ * 作者: Tes Alone
+ *
+ * 备注:
+*/
+
+#ifndef _EASY_BTREESET_H_
+#define _EASY_BTREESET_H_
+
+#include "BaseTypes.hpp"
+#include "Exception.hpp"
+#include "Iterator.hpp"
+#include "Array.hpp"
+#include "Container.hpp"
+#include "System.hpp"
+#include "BTree.hpp"
+
+namespace Easy {
+
+/**
+	\class BTreeSet
+
+	\brief B+ 树实现的有序集合.
+
+	接口与 TreeSet 相同. 元素连续存放在宽节点中, 查找和顺序遍历的缓存缺失比红黑树少得多,
+	每个元素也不需要单独的节点和三个指针, 大的集合占用的内存约为 TreeSet 的一半或更少.
+	<br/>
+	与 TreeSet 不同, add() 和 remove() 会移动其他元素, 使指向元素的引用失效.
+	<br/>
+	已经排好序的元素应使用 BTreeSet(const Array<E>&) 一次建成, 比逐个 add() 快, 叶子也是满的.
+
+	@since 1.0
+*/
+template<class E>
+class BTreeSet {
+template<class K, class V> friend class BTreeMap;
+
+private:
+	BTree<E, E> m_tree;
+
+public:
+	/**
+		\brief 构造函数.
+	*/
+	BTreeSet() {}
+
+	/**
+		\brief 构造函数.
+
+		从排好序的元素批量建立集合, 不需要比较和分裂.
+
+		@param sorted 严格递增的元素.
+		@throw 如果 sorted 不是严格递增的, 抛出 IllegalArgumentException.
+	*/
+	explicit BTreeSet(const Array<E>& sorted) {
+		typename BTree<E, E>::ArraySource source{sorted};
+		m_tree.build(sorted.length(), source);
+	}
+
+	/**
+		\brief 等于函数.
+
+		集合元素需实现 equals() 方法.
+
+		@param other 一个集合.
+		@return 如果接受者和 other 的元素对应相等, 返回真; 否则, 返回假.
+	*/
+	inline e_bool equals(const BTreeSet<E>& other) const {
+		return Container::equals<BTreeSet<E>, BTreeSet<E>, E>(*this, other);
+	}
+
+	/**
+		\brief 比较函数.
+
+		集合元素需实现 compare() 方法.
+
+		@param other 集合对象.
+		@return 如果接受者的元素按顺序大于 other 的元素, 返回 1; 等于返回 0; 小于返回 -1.
+	*/
+	inline e_int compare(const BTreeSet<E>& other) const {
+		return Container::compare<BTreeSet<E>, BTreeSet<E>, E>(*this, other);
+	}
+
+	/**
+	 * \brief 哈希函数.
+	 *
+	 * @return 接受者的哈希值.
+	*/
+	inline e_int hashCode() const {return Long::hashCode(reinterpret_cast<e_long>(this));}
+
+	/**
+	 * \brief 转到字符串.
+	 *
+	 * 集合的元素需实现 toString() 方法.
+	 *
+	 * @return 接受者的字符串表示.
+	*/
+	inline String toString() const {
+		return System::move(Container::toString<BTreeSet<E>, E>(*this));
+	}
+
+	/**
+		\brief 添加元素.
+
+		如果接受者中包含等价元素, 函数不会再次添加元素.
+
+		@param item 要添加的元素.
+		@return 添加在接受者中的于 item 等价的元素
+	*/
+	E& add(const E& item) {
+		E copy = item;
+		e_bool added;
+		return *m_tree.insert(copy, added);
+	}
+
+	/**
+		\brief 添加元素.
+
+		如果接受者中包含等价元素, 函数不会再次添加元素.
+
+		@param item 要添加的元素.
+		@return 添加在接受者中的于 item 等价的元素
+	*/
+	E& add(E&& item) {
+		e_bool added;
+		return *m_tree.insert(item, added);
+	}
+
+	/**
+	 * \brief 删除元素.
+	 *
+	 * @param item 与要删除的元素等价的元素.
+	 * @return 被删除的元素.
+	 * @throw 如果接受者不包含元素 item, 抛出 HasNoSuchElementException.
+	*/
+	E remove(const E& item) {
+		E removed;
+		if (!m_tree.remove(item, removed)) {
+			throw  HasNoSuchElementException{__func__, __LINE__, String{L"BTreeSet"}};
+		}
+		return System::move(removed);
+	}
+
+	/**
+	 * \brief 获取元素.
+	 *
+	 * @param item 与欲获取元素等价的元素.
+	 * @return 接受者中与 item 等价的元素.
+	 * @throw 如果接受者空或不包含 item, 抛出 HasNoSuchElementException.
+	*/
+	E& get(const E& item) const {
+		E* found = m_tree.find(item);
+		if (found == nullptr)
+			throw  HasNoSuchElementException{__func__, __LINE__, String{L"BTreeSet"}};
+		return *found;
+	}
+
+	/**
+		\brief 判断接受者是否包含指定元素.
+
+		@param item 欲查找的项.
+		@return 如果接受者包含 item, 返回真; 否则, 返回假.
+	*/
+	inline e_bool contains(const E& item) const {
+		return m_tree.find(item) != nullptr;
+	}
+
+	/**
+	 * \brief 获取最大值.
+	 *
+	 * @return 接受者中的最大元素.
+	 * @throw 如果接受者空, 抛出 EmptyContainerException.
+	*/
+	E& max() const {
+		E* _max = m_tree.last();
+		if (_max == nullptr) {
+			throw  EmptyContainerException{__func__, __LINE__, String{L"BTreeSet"}};
+		}
+		return *_max;
+	}
+
+	/**
+	 * \brief 获取最小值.
+	 *
+	 * @return 接受者中的最小元素.
+	 * @throw 如果接受者空, 抛出 EmptyContainerException.
+	*/
+	E& min() const {
+		E* _min = m_tree.first();
+		if (_min == nullptr) {
+			throw  EmptyContainerException{__func__, __LINE__, String{L"BTreeSet"}};
+		}
+		return *_min;
+	}
+
+	/**
+	 * \brief 获取元素个数.
+	 *
+	 * @return 接受者包含的元素个数.
+	*/
+	inline e_int size() const {
+		return m_tree.size();
+	}
+
+	/**
+	 * \brief 检查集合是否为空.
+	 *
+	 * @return 如果集合为空, 返回真; 否则, 返回假.
+	*/
+	inline e_bool empty() const {
+		return m_tree.size() == 0;
+	}
+
+	/**
+	 * \brief 清空容器.
+	*/
+	inline e_void clean() {
+		m_tree.clean();
+	}
+
+	/**
+	 * \brief 获取迭代器.
+	 *
+	 * 迭代器按从小到大的顺序遍历叶子链表.
+	 *
+	 * @return 接受者的迭代器.
+	*/
+	inline Iterator<E>* iterator() const {
+		return m_tree.iterator(L"BTreeSet");
+	}
+}; // BTreeSet
+
+} // Easy
+
+#endif // _EASY_BTREESET_H_
@@ -16,6 +16,7 @@
 #include "System.hpp"
 #include "Math.hpp"
 #include "EasyC.hpp"
+#include "TypeTraits.hpp"
 
 namespace Easy {
 
@@ -485,6 +486,14 @@ private:
 	e_int _binarySearch(E item, e_int start, e_int end)  const;
 }; // BasicArray
 
+template<class E>
+struct IsTriviallyRelocatable<BasicArray<E>> {
+	static constexpr e_bool value = true;
+};
+
+template<class E>
+constexpr e_bool IsTriviallyRelocatable<BasicArray<E>>::value;
+
 /**
  * \brief BasicArray template instances.
  * 
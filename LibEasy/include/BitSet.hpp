@@ -164,9 +164,9 @@ public:
 		StringBuffer sb;
 		e_int len = _bits.length() - 1;
 		for (e_int i=0; i<len; i++) {
-			sb.append(String::format(L"%064s", ULong::toBinaryString(_bits[i])).reverse());
+			sb.append(String::format(EASY_FORMAT(L"%064s"), ULong::toBinaryString(_bits[i])).reverse());
 		}
-		String tail = String::format(L"%064s", ULong::toBinaryString(_bits[len]));
+		String tail = String::format(EASY_FORMAT(L"%064s"), ULong::toBinaryString(_bits[len]));
 		if (_tail != 0) {
 			sb.append(tail.substring(64-_tail, 64).reverse());
 		} else {
@@ -0,0 +1,675 @@
+/*
+ * 文件名: ConcurrentHashMap.hpp
+ *
+ * 日期/时间:
+ *		开始: 2026年10月17日 23:41:26 周六
+ *		结束:
+ *
+ * 版本: 1.0
+ *
+ * 作者: Tes Alone
+ *
+ * 备注:
+*/
+
+#ifndef _EASY_CONCURRENTHASHMAP_H_
+#define _EASY_CONCURRENTHASHMAP_H_
+
+#include <windows.h>
+
+#include "BaseTypes.hpp"
+#include "Exception.hpp"
+#include "String.hpp"
+#include "Integer.hpp"
+
+extern "C" {
+
+void WINAPI InitializeSRWLock (PSRWLOCK);
+void WINAPI AcquireSRWLockExclusive (PSRWLOCK);
+BOOLEAN WINAPI TryAcquireSRWLockExclusive (PSRWLOCK);
+void WINAPI ReleaseSRWLockExclusive (PSRWLOCK);
+
+}
+
+namespace Easy {
+
+/**
+	\class Epoch
+
+	\brief 读端无锁的延迟回收.
+
+	读者在 enter() 和 exit() 之间访问共享的节点; 写者把节点从共享结构中摘下后调用 synchronize(),
+	synchronize() 返回时, 摘下之前进入的读者都已经退出, 节点可以释放.
+	<br/>
+	读者只在自己线程的计数槽上做原子加减, 从不等待写者; 等待只发生在 synchronize() 中.
+	纪元的奇偶决定读者记在哪一个计数上, synchronize() 翻转纪元后只需等待旧的计数归零.
+	<br/>
+	读者不能在 enter() 和 exit() 之间调用 synchronize(), 否则永远等待自己.
+
+	@since 1.0
+*/
+class Epoch {
+public:
+	/**
+		\brief 计数槽个数, 线程按首次进入的顺序轮流使用.
+	*/
+	static constexpr e_int SLOTS = 64;
+
+	Epoch();
+
+	/**
+		\brief 读者进入.
+
+		@return 传给 exit() 的凭据.
+	*/
+	inline e_int enter() {
+		e_int slot = _slot();
+		for (;;) {
+			e_int phase = (e_int)(__atomic_load_n(&m_epoch, __ATOMIC_SEQ_CST) & 1);
+			__atomic_fetch_add(&m_slots[slot].m_readers[phase], 1, __ATOMIC_SEQ_CST);
+			// 计数之后纪元没有翻转, 此后的 synchronize() 一定能看到这个计数.
+			if ((e_int)(__atomic_load_n(&m_epoch, __ATOMIC_SEQ_CST) & 1) == phase)
+				return slot * 2 + phase;
+			__atomic_fetch_sub(&m_slots[slot].m_readers[phase], 1, __ATOMIC_RELEASE);
+		}
+	}
+
+	/**
+		\brief 读者退出.
+
+		@param token enter() 返回的凭据.
+	*/
+	inline e_void exit(e_int token) {
+		__atomic_fetch_sub(&m_slots[token >> 1].m_readers[token & 1], 1, __ATOMIC_RELEASE);
+	}
+
+	/**
+		\brief 等待调用之前进入的读者全部退出.
+	*/
+	e_void synchronize();
+
+	e_int hashCode() const;
+	String toString() const;
+
+private:
+	struct Slot {
+		e_long m_readers[2];
+		e_byte m_pad[64 - 2 * sizeof(e_long)];	// 每个槽独占一个缓存行
+	};
+
+	Slot    m_slots[SLOTS];
+	e_long  m_epoch;
+	SRWLOCK m_lock;
+
+	static e_int _slot();
+
+	Epoch(const Epoch& copy) = delete;
+	Epoch(Epoch&& move) = delete;
+	Epoch& operator=(const Epoch& copy) = delete;
+	Epoch& operator=(Epoch&& move) = delete;
+}; // Epoch
+
+/**
+	\class ConcurrentHashMap
+
+	\brief 线程安全的哈希表.
+
+	键是唯一的, put() 替换已有的值.
+	<br/>
+	读操作 (get(), tryGet(), contains()) 不加锁: 节点发布之后只有 m_next 会改变,
+	写者替换或删除节点时先把它从链表中摘下, 再交给 Epoch 延迟释放, 所以读者看到的节点总是完整的.
+	<br/>
+	写操作按键的哈希值分到 STRIPES 把锁中的一把, 不同分片上的写互不阻塞.
+	putIfAbsent() 和 computeIfAbsent() 在分片锁内检查并插入, 是原子的.
+	扩容时持有全部分片锁, 把节点复制到新表后发布新表, 正在读旧表的读者不受影响.
+	<br/>
+	读操作返回值的副本, 不返回引用, 因为引用的节点可能随时被替换.
+	size() 是各分片计数之和, 有并发写时只是近似值.
+
+	@since 1.0
+*/
+template<class K, class V>
+class ConcurrentHashMap {
+
+class Node {
+public:
+	K      m_key;
+	V      m_value;
+	e_int  m_hashCode;
+	Node*  m_next;		// 读者无锁遍历, 写者持有分片锁修改, 都通过 __atomic 访问
+	Node*  m_retired;	// 摘下之后, 在待回收链表中的下一个节点
+
+	Node(const K& key, const V& value, e_int h, Node* next) :
+		m_key(key), m_value(value), m_hashCode(h), m_next(next), m_retired(nullptr) {}
+}; // Node
+
+class Table {
+public:
+	Node** m_buckets;
+	e_int  m_capacity;
+	Table* m_retired;
+
+	explicit Table(e_int capacity) {
+		m_buckets  = new Node*[capacity];
+		m_capacity = capacity;
+		m_retired  = nullptr;
+		for (e_int i=0; i<capacity; i++) {
+			m_buckets[i] = nullptr;
+		}
+	}
+
+	// 释放表及表中的节点.
+	~Table() {
+		for (e_int i=0; i<m_capacity; i++) {
+			Node* cur = m_buckets[i];
+			while (cur) {
+				Node* old = cur;
+				cur = cur->m_next;
+				delete old;
+			}
+		}
+		delete [] m_buckets;
+	}
+}; // Table
+
+struct Stripe {
+	SRWLOCK m_lock;
+	e_int   m_size;
+	e_byte  m_pad[64 - sizeof(SRWLOCK) - sizeof(e_int)];
+};
+
+class StripeGuard {
+public:
+	explicit StripeGuard(Stripe& stripe) : m_stripe(&stripe) {
+		AcquireSRWLockExclusive(&stripe.m_lock);
+	}
+
+	~StripeGuard() {
+		unlock();
+	}
+
+	e_void unlock() {
+		if (m_stripe) {
+			ReleaseSRWLockExclusive(&m_stripe->m_lock);
+			m_stripe = nullptr;
+		}
+	}
+private:
+	Stripe* m_stripe;
+}; // StripeGuard
+
+class ReadGuard {
+public:
+	explicit ReadGuard(Epoch& epoch) : m_epoch(epoch), m_token(epoch.enter()) {}
+
+	~ReadGuard() {
+		m_epoch.exit(m_token);
+	}
+private:
+	Epoch& m_epoch;
+	e_int  m_token;
+}; // ReadGuard
+
+public:
+	/**
+		\brief 写锁的分片数.
+	*/
+	static constexpr e_int STRIPES = 64;
+
+	/**
+		\brief 待回收的节点达到这个数目时, 写者回收一次.
+	*/
+	static constexpr e_int RECLAIM_BATCH = 1024;
+
+private:
+	Table*  m_table;
+	Stripe  m_stripes[STRIPES];
+	mutable Epoch m_epoch;
+	Node*   m_retiredNodes;
+	Table*  m_retiredTables;
+	e_int   m_retiredCount;
+	SRWLOCK m_reclaimLock;
+
+public:
+	/**
+		\brief 构造函数.
+
+		容量会被调整为不小于 initCapacity 及 STRIPES 的 2 的幂.
+
+		@param initCapacity 初始容量.
+	*/
+	explicit ConcurrentHashMap(e_int initCapacity=STRIPES) {
+		e_int capacity = STRIPES;
+		while (capacity < initCapacity && capacity < (1 << 30)) {
+			capacity <<= 1;
+		}
+		m_table = new Table(capacity);
+		for (e_int i=0; i<STRIPES; i++) {
+			InitializeSRWLock(&m_stripes[i].m_lock);
+			m_stripes[i].m_size = 0;
+		}
+		m_retiredNodes  = nullptr;
+		m_retiredTables = nullptr;
+		m_retiredCount  = 0;
+		InitializeSRWLock(&m_reclaimLock);
+	}
+
+	/**
+		\brief 析构函数.
+
+		析构时不能有其他线程访问接受者.
+	*/
+	~ConcurrentHashMap() {
+		delete m_table;
+		_free(m_retiredNodes, m_retiredTables);
+	}
+
+	/**
+		\brief 获取值.
+
+		@param key 键.
+		@param value 如果接受者包含 key, 复制 key 对应的值到 value; 否则, value 不变.
+		@return 如果接受者包含 key, 返回真; 否则, 返回假.
+		@throw 如果 key.hashCode() 为负数, 抛出 IllegalHashCodeException.
+	*/
+	e_bool tryGet(const K& key, V& value) const {
+		e_int hash = _hash(key);
+		ReadGuard guard{m_epoch};
+		const Node* node = _find(key, hash);
+		if (node == nullptr) {
+			return false;
+		}
+		value = node->m_value;
+		return true;
+	}
+
+	/**
+		\brief 获取值.
+
+		@param key 键.
+		@return key 对应的值的副本.
+		@throw 如果 key.hashCode() 为负数, 抛出 IllegalHashCodeException.
+		@throw 如果接受者不包含 key, 抛出 HasNoSuchElementException.
+	*/
+	V get(const K& key) const {
+		e_int hash = _hash(key);
+		ReadGuard guard{m_epoch};
+		const Node* node = _find(key, hash);
+		if (node == nullptr) {
+			throw HasNoSuchElementException{__func__, __LINE__, String{L"ConcurrentHashMap"}};
+		}
+		return node->m_value;
+	}
+
+	/**
+		\brief 判断接受者是否包含指定键.
+
+		@param key 欲查找的键.
+		@return 如果接受者包含 key, 返回真; 否则, 返回假.
+		@throw 如果 key.hashCode() 为负数, 抛出 IllegalHashCodeException.
+	*/
+	e_bool contains(const K& key) const {
+		e_int hash = _hash(key);
+		ReadGuard guard{m_epoch};
+		return _find(key, hash) != nullptr;
+	}
+
+	/**
+		\brief 添加键/值.
+
+		如果接受者已经包含 key, 替换它的值.
+
+		@param key 键.
+		@param value 值.
+		@return 如果 key 是新加入的, 返回真; 如果替换了已有的值, 返回假.
+		@throw 如果 key.hashCode() 为负数, 抛出 IllegalHashCodeException.
+	*/
+	e_bool put(const K& key, const V& value) {
+		e_int hash = _hash(key);
+		Stripe& stripe = _stripe(hash);
+		Table* grow = nullptr;
+		e_bool added;
+		{
+			StripeGuard guard{stripe};
+			Node** link = _search(key, hash);
+			Node* old   = *link;
+			if (old) {
+				// 读者可能正在读 old, 不能修改它, 换上带新值的节点.
+				__atomic_store_n(link, new Node(old->m_key, value, hash, old->m_next), __ATOMIC_RELEASE);
+				_retire(old);
+				added = false;
+			} else {
+				__atomic_store_n(link, new Node(key, value, hash, nullptr), __ATOMIC_RELEASE);
+				grow  = _added(stripe);
+				added = true;
+			}
+		}
+		_afterWrite(grow);
+		return added;
+	}
+
+	/**
+		\brief 键不存在时添加键/值.
+
+		检查和添加是原子的: 多个线程用同一个键调用时, 恰好有一个返回真.
+
+		@param key 键.
+		@param value 值.
+		@return 如果添加了 key, 返回真; 如果接受者已经包含 key, 不做任何改变, 返回假.
+		@throw 如果 key.hashCode() 为负数, 抛出 IllegalHashCodeException.
+	*/
+	e_bool putIfAbsent(const K& key, const V& value) {
+		e_int hash = _hash(key);
+		if (contains(key)) {
+			return false;
+		}
+		Stripe& stripe = _stripe(hash);
+		Table* grow = nullptr;
+		{
+			StripeGuard guard{stripe};
+			Node** link = _search(key, hash);
+			if (*link) {
+				return false;
+			}
+			__atomic_store_n(link, new Node(key, value, hash, nullptr), __ATOMIC_RELEASE);
+			grow = _added(stripe);
+		}
+		_afterWrite(grow);
+		return true;
+	}
+
+	/**
+		\brief 键不存在时计算并添加值.
+
+		compute 只在 key 不存在时调用, 并且持有 key 所在分片的锁,
+		所以多个线程用同一个键调用时, compute 只执行一次, 所有线程得到同一个值.
+		compute 不能访问接受者, 否则可能死锁; 它抛出的异常会传给调用者, 接受者不变.
+
+		@param key 键.
+		@param compute 以 key 为参数, 返回 V 的函数或函数对象.
+		@return key 对应的值的副本, 已有的或新计算的.
+		@throw 如果 key.hashCode() 为负数, 抛出 IllegalHashCodeException.
+	*/
+	template<class F>
+	V computeIfAbsent(const K& key, F compute) {
+		e_int hash = _hash(key);
+		{
+			ReadGuard guard{m_epoch};
+			const Node* node = _find(key, hash);
+			if (node) {
+				return node->m_value;
+			}
+		}
+		Stripe& stripe = _stripe(hash);
+		StripeGuard guard{stripe};
+		Node** link = _search(key, hash);
+		if (*link) {
+			return (*link)->m_value;
+		}
+		V value = compute(key);
+		__atomic_store_n(link, new Node(key, value, hash, nullptr), __ATOMIC_RELEASE);
+		Table* grow = _added(stripe);
+		guard.unlock();
+		_afterWrite(grow);
+		return value;
+	}
+
+	/**
+		\brief 删除键/值.
+
+		@param key 键.
+		@return 如果接受者包含 key, 删除后返回真; 否则, 返回假.
+		@throw 如果 key.hashCode() 为负数, 抛出 IllegalHashCodeException.
+	*/
+	e_bool remove(const K& key) {
+		e_int hash = _hash(key);
+		Stripe& stripe = _stripe(hash);
+		{
+			StripeGuard guard{stripe};
+			Node** link = _search(key, hash);
+			Node* node  = *link;
+			if (node == nullptr) {
+				return false;
+			}
+			__atomic_store_n(link, node->m_next, __ATOMIC_RELEASE);
+			__atomic_store_n(&stripe.m_size, stripe.m_size - 1, __ATOMIC_RELAXED);
+			_retire(node);
+		}
+		_afterWrite(nullptr);
+		return true;
+	}
+
+	/**
+		\brief 清空接受者.
+
+		容量恢复为 STRIPES, 旧的节点在读者退出后释放.
+	*/
+	e_void clean() {
+		Table* table = new Table(STRIPES);
+		_lockAll();
+		Table* old = m_table;
+		for (e_int i=0; i<STRIPES; i++) {
+			__atomic_store_n(&m_stripes[i].m_size, 0, __ATOMIC_RELAXED);
+		}
+		__atomic_store_n(&m_table, table, __ATOMIC_RELEASE);
+		_unlockAll();
+		_retire(old);
+		_reclaim(true);
+	}
+
+	/**
+		\brief 获取元素个数.
+
+		@return 接受者包含的键/值个数, 有并发写时是近似值.
+	*/
+	e_int size() const {
+		e_int total = 0;
+		for (e_int i=0; i<STRIPES; i++) {
+			total += __atomic_load_n(&m_stripes[i].m_size, __ATOMIC_RELAXED);
+		}
+		return total;
+	}
+
+	/**
+		\brief 检查接受者是否为空.
+
+		@return 如果 size() == 0, 返回真.
+	*/
+	inline e_bool empty() const {
+		return size() == 0;
+	}
+
+	/**
+		\brief 获取容量.
+
+		@return 当前表的桶数.
+	*/
+	inline e_int capacity() const {
+		return __atomic_load_n(&m_table, __ATOMIC_ACQUIRE)->m_capacity;
+	}
+
+	inline e_int hashCode() const {return Long::hashCode(reinterpret_cast<e_long>(this));}
+
+	String toString() const {
+		return String{L"ConcurrentHashMap: "} + Integer::toString(size());
+	}
+
+private:
+	static inline e_int _hash(const K& key) {
+		e_int hash = key.hashCode();
+		if (hash < 0) {
+			throw IllegalHashCodeException{__func__, __LINE__, hash};
+		}
+		return hash;
+	}
+
+	/*
+		哈希值乘以 2^64 / 黄金分割比后取高 32 位. 容量不小于 STRIPES 且都是 2 的幂,
+		所以同一个桶的键总在同一个分片, 扩容不改变分片.
+	*/
+	static inline e_int _index(e_int hash, e_int capacity) {
+		return (e_int)(((e_ulong)(e_uint)hash * 0x9e3779b97f4a7c15ULL) >> 32) & (capacity - 1);
+	}
+
+	inline Stripe& _stripe(e_int hash) {
+		return m_stripes[_index(hash, STRIPES)];
+	}
+
+	// 读者调用, 必须在 ReadGuard 之内.
+	Node* _find(const K& key, e_int hash) const {
+		Table* table = __atomic_load_n(&m_table, __ATOMIC_ACQUIRE);
+		Node* cur = __atomic_load_n(&table->m_buckets[_index(hash, table->m_capacity)], __ATOMIC_ACQUIRE);
+		while (cur) {
+			if (cur->m_hashCode == hash && cur->m_key.equals(key)) {
+				return cur;
+			}
+			cur = __atomic_load_n(&cur->m_next, __ATOMIC_ACQUIRE);
+		}
+		return nullptr;
+	}
+
+	/*
+		写者调用, 必须持有 hash 所在分片的锁. 扩容需要全部分片锁, 所以这期间表不会改变.
+		返回指向匹配节点的链接, 没有匹配时返回链表末尾的空链接.
+	*/
+	Node** _search(const K& key, e_int hash) {
+		Table* table = m_table;
+		Node** link  = &table->m_buckets[_index(hash, table->m_capacity)];
+		while (*link) {
+			if ((*link)->m_hashCode == hash && (*link)->m_key.equals(key)) {
+				break;
+			}
+			link = &(*link)->m_next;
+		}
+		return link;
+	}
+
+	/*
+		增加分片计数, 元素总数超过容量的 3/4 时返回需要扩容的表.
+		只有分片超过它平均的那一份时才去累加各分片的计数.
+	*/
+	Table* _added(Stripe& stripe) {
+		e_int count = stripe.m_size + 1;
+		__atomic_store_n(&stripe.m_size, count, __ATOMIC_RELAXED);
+		Table* table = m_table;
+		e_long limit = (e_long)table->m_capacity * 3 / 4;
+		if ((e_long)count * STRIPES > limit && size() > limit) {
+			return table;
+		}
+		return nullptr;
+	}
+
+	// 释放分片锁之后调用.
+	e_void _afterWrite(Table* grow) {
+		if (grow) {
+			_grow(grow);
+		}
+		if (__atomic_load_n(&m_retiredCount, __ATOMIC_RELAXED) >= RECLAIM_BATCH) {
+			_reclaim(false);
+		}
+	}
+
+	e_void _grow(Table* seen) {
+		_lockAll();
+		Table* old = m_table;
+		if (old != seen) {	// 其他线程已经扩容
+			_unlockAll();
+			return;
+		}
+
+		Table* table = nullptr;
+		try {
+			table = new Table(old->m_capacity * 2);
+			for (e_int i=0; i<old->m_capacity; i++) {
+				for (Node* cur=old->m_buckets[i]; cur; cur=cur->m_next) {
+					Node** head = &table->m_buckets[_index(cur->m_hashCode, table->m_capacity)];
+					*head = new Node(cur->m_key, cur->m_value, cur->m_hashCode, *head);
+				}
+			}
+		} catch (...) {
+			delete table;
+			_unlockAll();
+			throw;
+		}
+
+		__atomic_store_n(&m_table, table, __ATOMIC_RELEASE);
+		_unlockAll();
+		_retire(old);
+		_reclaim(true);
+	}
+
+	e_void _lockAll() {
+		for (e_int i=0; i<STRIPES; i++) {
+			AcquireSRWLockExclusive(&m_stripes[i].m_lock);
+		}
+	}
+
+	e_void _unlockAll() {
+		for (e_int i=STRIPES-1; i>=0; i--) {
+			ReleaseSRWLockExclusive(&m_stripes[i].m_lock);
+		}
+	}
+
+	e_void _retire(Node* node) {
+		Node* head = __atomic_load_n(&m_retiredNodes, __ATOMIC_RELAXED);
+		do {
+			node->m_retired = head;
+		} while (!__atomic_compare_exchange_n(&m_retiredNodes, &head, node, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+		__atomic_fetch_add(&m_retiredCount, 1, __ATOMIC_RELAXED);
+	}
+
+	e_void _retire(Table* table) {
+		Table* head = __atomic_load_n(&m_retiredTables, __ATOMIC_RELAXED);
+		do {
+			table->m_retired = head;
+		} while (!__atomic_compare_exchange_n(&m_retiredTables, &head, table, true, __ATOMIC_RELEASE, __ATOMIC_RELAXED));
+	}
+
+	/*
+		取走待回收的节点和表, 等待正在读的线程退出后释放.
+		wait 为假时, 如果其他线程正在回收就直接返回.
+	*/
+	e_void _reclaim(e_bool wait) {
+		if (wait) {
+			AcquireSRWLockExclusive(&m_reclaimLock);
+		} else if (!TryAcquireSRWLockExclusive(&m_reclaimLock)) {
+			return;
+		}
+		Node* nodes   = __atomic_exchange_n(&m_retiredNodes, (Node*)nullptr, __ATOMIC_ACQUIRE);
+		Table* tables = __atomic_exchange_n(&m_retiredTables, (Table*)nullptr, __ATOMIC_ACQUIRE);
+		if (nodes || tables) {
+			m_epoch.synchronize();
+			__atomic_fetch_sub(&m_retiredCount, _free(nodes, tables), __ATOMIC_RELAXED);
+		}
+		ReleaseSRWLockExclusive(&m_reclaimLock);
+	}
+
+	// 返回释放的单个节点数.
+	static e_int _free(Node* nodes, Table* tables) {
+		e_int count = 0;
+		while (nodes) {
+			Node* old = nodes;
+			nodes = nodes->m_retired;
+			delete old;
+			count++;
+		}
+		while (tables) {
+			Table* old = tables;
+			tables = tables->m_retired;
+			delete old;
+		}
+		return count;
+	}
+
+	ConcurrentHashMap(const ConcurrentHashMap& copy) = delete;
+	ConcurrentHashMap(ConcurrentHashMap&& move) = delete;
+	ConcurrentHashMap& operator=(const ConcurrentHashMap& copy) = delete;
+	ConcurrentHashMap& operator=(ConcurrentHashMap&& move) = delete;
+}; // ConcurrentHashMap
+
+template<class K, class V> constexpr e_int ConcurrentHashMap<K, V>::STRIPES;
+template<class K, class V> constexpr e_int ConcurrentHashMap<K, V>::RECLAIM_BATCH;
+
+} // Easy
+
+#endif // _EASY_CONCURRENTHASHMAP_H_
@@ -21,6 +21,7 @@
 
 #include "BaseTypes.hpp"
 #include "String.hpp"
+#include "StringBuffer.hpp"
 
 namespace Easy {
 	
@@ -850,7 +851,26 @@ class Console {
 		 * */
 		template<class ...T>
 		inline static e_void printfln(const String& fmt, const T& ...args) {
-			outln(String::format(fmt, args...));
+			StringBuffer sb{fmt.length() + 16};
+			sb.appendFormat(fmt, args...);
+			out(sb.toCStr());
+			outln();
+		}
+		
+		/**
+		 * \brief Output formated string.
+		 * 
+		 * Same as printfln(const String&, const T&...), but fmt is parsed at compile time.
+		 * 
+		 * @param fmt format made by EASY_FORMAT().
+		 * @param args
+		 * */
+		template<class S, class ...T>
+		inline static e_void printfln(FormatString<S> fmt, const T& ...args) {
+			StringBuffer sb{64};
+			sb.appendFormat(fmt, args...);
+			out(sb.toCStr());
+			outln();
 		}
 		
 		/**
@@ -865,7 +885,24 @@ class Console {
 		 * */
 		template<class ...T>
 		inline static e_void printf(const String& fmt, const T& ...args) {
-			out(String::format(fmt, args...));
+			StringBuffer sb{fmt.length() + 16};
+			sb.appendFormat(fmt, args...);
+			out(sb.toCStr());
+		}
+		
+		/**
+		 * \brief Output formated string.
+		 * 
+		 * Same as printf(const String&, const T&...), but fmt is parsed at compile time.
+		 * 
+		 * @param fmt format made by EASY_FORMAT().
+		 * @param args
+		 * */
+		template<class S, class ...T>
+		inline static e_void printf(FormatString<S> fmt, const T& ...args) {
+			StringBuffer sb{64};
+			sb.appendFormat(fmt, args...);
+			out(sb.toCStr());
 		}
 		
 		/**
@@ -87,8 +87,12 @@
 		<li>Easy::Heap</li>
 		<li>Easy::HashSet</li>
 		<li>Easy::HashMap</li>
+		<li>Easy::FlatHashMap</li>
+		<li>Easy::ConcurrentHashMap</li>
 		<li>Easy::TreeSet</li>
 		<li>Easy::TreeMap</li>
+		<li>Easy::BTreeSet</li>
+		<li>Easy::BTreeMap</li>
 		<li>Easy::BitSet</li>
 		<li>Easy::Container</li>
 	</ul>
@@ -121,8 +125,11 @@
 		<li>Easy::ArgsParser</li>
 		<li>Easy::StringBuffer</li>
 		<li>Easy::Iterator</li>
+		<li>Easy::IsTriviallyRelocatable</li>
+		<li>Easy::NodePool / Easy::PoolAllocator / Easy::ThreadLocalPoolAllocator</li>
 		<li>Easy::BigMemory</li>
 		<li>Easy::Thread</li>
+		<li>Easy::Random</li>
 	</ul>
 	
 	<h4>Exceptions</h4>
@@ -210,17 +217,23 @@ namespace Easy {
 #include "Character.hpp"
 #include "String.hpp"
 #include "String.tcc"
+#include "StringView.hpp"
+#include "Utf8String.hpp"
+#include "StringPool.hpp"
 #include "Bytes.hpp"
 
 #include "StringBuffer.hpp"
+#include "Searcher.hpp"
 
 #include "Math.hpp"
+#include "Random.hpp"
 #include "Date.hpp"
 
 #include "AutoPointer.hpp"
 #include "SharedPointer.hpp"
 #include "Console.hpp"
 #include "System.hpp"
+#include "TypeTraits.hpp"
 #include "Functor.hpp"
 
 #include "ANSIFileInputStream.hpp"
@@ -243,10 +256,15 @@ namespace Easy {
 #include "Stack.hpp"
 #include "Queue.hpp"
 #include "Heap.hpp"
+#include "NodePool.hpp"
 #include "TreeSet.hpp"
 #include "TreeMap.hpp"
+#include "BTreeSet.hpp"
+#include "BTreeMap.hpp"
 #include "HashSet.hpp"
 #include "HashMap.hpp"
+#include "FlatHashMap.hpp"
+#include "ConcurrentHashMap.hpp"
 #include "MapEntry.hpp"
 #include "BitSet.hpp"
 
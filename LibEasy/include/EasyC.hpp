@@ -19,7 +19,26 @@
 
 using namespace Easy;
 
+/*
+	e_memcopy/e_memmove 在第一次调用时根据 CPUID 选择复制函数,
+	e_setmemlevel() 可以强制使用较低的指令集, 用于测试和性能比较;
+	16 字节以内的复制不受级别影响.
+*/
+#define E_MEM_SCALAR 0
+#define E_MEM_SSE2   1
+#define E_MEM_AVX2   2
+#define E_MEM_AVX512 3
+
 e_void e_memmove(e_void* des, e_void* src, e_int count);
 e_void e_memcopy(e_void* des, const e_void* src, e_int count);
 
+e_int  e_memlevel();
+e_void e_setmemlevel(e_int level);
+
+/*
+	e_hash 是 wyhash 风格的 64 位非加密哈希, 每轮处理 48 字节, 三路独立乘法可以并行执行.
+	相同的 data/count/seed 总是得到相同的结果.
+*/
+e_ulong e_hash(const e_void* data, e_int count, e_ulong seed=0);
+
 #endif // _EASY_EASYC_H_
@@ -22,6 +22,7 @@
 namespace Easy {
 
 class String;
+class Utf8String;
 
 /**
  * \class FileReader
@@ -29,6 +30,9 @@ class String;
  * \brief Text files input stream.
  * 
  * Only supports UTF-8 encoding. <br/>
+ * In FileReader::WIDE mode the C runtime decodes the file to e_char;
+ * in FileReader::UTF8 mode bytes are read as is, so lines can be read
+ * as Utf8String without transcoding. <br/>
  * This class can be wrapped by SharedPointer.
  * 
  * @author Tes Alone
@@ -38,8 +42,25 @@ class FileReader : public EnableSharedFromThis<FileReader>  {
 private:
 	FILE* m_file;
 	e_bool m_closed;
+	e_int  m_mode;
 	String m_filePath;
 public:
+
+	/**
+	 * \brief Wide char mode.
+	 * 
+	 * The file is opened in text mode and decoded to e_char by the C runtime.
+	 * This is the default mode.
+	*/
+	static const e_int WIDE = 0;
+
+	/**
+	 * \brief UTF-8 mode.
+	 * 
+	 * The file is opened in binary mode and read byte by byte, a leading BOM is skipped.
+	 * Line ends are not translated, but readLine() and readLineUtf8() drop the '\\r' before '\\n'.
+	*/
+	static const e_int UTF8 = 1;
 	
 	/**
 	 * \brief ctor.
@@ -47,10 +68,11 @@ public:
 	 * Open file as a input stream.
 	 * 
 	 * @param file .
-	 * @throw if file's full path is empty, throws IllegalArgumentException.
+	 * @param mode FileReader::WIDE or FileReader::UTF8, default FileReader::WIDE.
+	 * @throw if file's full path is empty or mode is unknown, throws IllegalArgumentException.
 	 * @throw if open failed, throws FileOpenFailedException.
 	*/
-	FileReader(const File& file);
+	FileReader(const File& file, e_int mode=WIDE);
 
 	/**
 	 * \brief ctor.
@@ -58,10 +80,11 @@ public:
 	 * Open file indicates by filePath as a input stream.
 	 * 
 	 * @param filePath .
-	 * @throw if filePath is empty, throws IllegalArgumentException.
+	 * @param mode FileReader::WIDE or FileReader::UTF8, default FileReader::WIDE.
+	 * @throw if filePath is empty or mode is unknown, throws IllegalArgumentException.
 	 * @throw if open failed, throws FileOpenFailedException.
 	*/
-	FileReader(const String& filePath);
+	FileReader(const String& filePath, e_int mode=WIDE);
 
 	/**
 	 * \brief dtor.
@@ -79,6 +102,7 @@ public:
 	 * 
 	 * @return the read char or -1.
 	 * @throw if read failed, throws IOException.
+	 * @throw if receiver is in FileReader::UTF8 mode, throws UnsupportedOperationException.
 	*/
 	e_int read();
 
@@ -91,8 +115,22 @@ public:
 	 * @param buf reading buffer.
 	 * @return reading length.
 	 * @throw if read failed, throws IOException.
+	 * @throw if receiver is in FileReader::UTF8 mode, throws UnsupportedOperationException.
 	*/
 	e_int read(CharArray& buf);
+
+	/**
+	 * \brief Read one or more bytes.
+	 * 
+	 * Read raw UTF-8 bytes, the last byte may be in the middle of a char.
+	 * If reading reaches eof, return reading length, maybe 0.
+	 * 
+	 * @param buf reading buffer.
+	 * @return reading length.
+	 * @throw if read failed, throws IOException.
+	 * @throw if receiver is in FileReader::WIDE mode, throws UnsupportedOperationException.
+	*/
+	e_int read(ByteArray& buf);
 	
 	/**
 	 * \brief Read one line.
@@ -100,9 +138,29 @@ public:
 	 * @return next line.
 	 * @throw if read failed, throws IOException.
 	 * @throw if reach eof, throws  FileReachEOFException.
+	 * @throw if the line is not valid UTF-8 in FileReader::UTF8 mode, throws IllegalArgumentException.
 	*/
 	String readLine();
 
+	/**
+	 * \brief Read one line as UTF-8.
+	 * 
+	 * In FileReader::UTF8 mode the line is not transcoded.
+	 * 
+	 * @return next line.
+	 * @throw if read failed, throws IOException.
+	 * @throw if reach eof, throws  FileReachEOFException.
+	 * @throw if the line is not valid UTF-8 in FileReader::UTF8 mode, throws IllegalArgumentException.
+	*/
+	Utf8String readLineUtf8();
+
+	/**
+	 * \brief Get reading mode.
+	 * 
+	 * @return FileReader::WIDE or FileReader::UTF8.
+	*/
+	inline e_int getMode() const {return m_mode;}
+
 	/**
 	 * \brief Close stream.
 	 * 
@@ -121,6 +179,8 @@ public:
 
 	String toString() const override;
 private:
+	e_void _open(e_int mode);
+
 	FileReader(FileReader& copy)  = delete;
 	FileReader(FileReader&& move)  = delete;
 	FileReader& operator=(FileReader& copy)  = delete;
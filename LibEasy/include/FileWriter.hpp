@@ -22,6 +22,7 @@
 namespace Easy {
 
 class String;
+class Utf8String;
 
 /**
  * \class FileWriter
@@ -29,6 +30,9 @@ class String;
  * \brief Text files output stream.
  * 
  * Only supports UTF-8 encoding.<br/>
+ * In FileWriter::WIDE mode the C runtime encodes e_char to UTF-8;
+ * in FileWriter::UTF8 mode Utf8String is written as is, and String is
+ * encoded by Utf8String. <br/>
  * This class can be wrapped by SharedPointer.
  * 
  * @author Tes Alone
@@ -38,8 +42,25 @@ class FileWriter : public EnableSharedFromThis<FileWriter>  {
 private:
 	FILE* m_file;
 	e_bool m_closed;
+	e_int  m_mode;
 	String m_filePath;
 public:
+
+	/**
+	 * \brief Wide char mode.
+	 * 
+	 * The file is opened in text mode and encoded by the C runtime.
+	 * This is the default mode.
+	*/
+	static const e_int WIDE = 0;
+
+	/**
+	 * \brief UTF-8 mode.
+	 * 
+	 * The file is opened in binary mode and starts with a BOM, like in FileWriter::WIDE mode.
+	 * '\\n' is not translated to "\\r\\n".
+	*/
+	static const e_int UTF8 = 1;
 	
 	/**
 	 * \brief ctor.
@@ -47,10 +68,11 @@ public:
 	 * Create a file writer from a file.
 	 * 
 	 * @param file from which receiver create.
-	 * @throw if file's full path is empty, throws IllegalArgumentException.
+	 * @param mode FileWriter::WIDE or FileWriter::UTF8, default FileWriter::WIDE.
+	 * @throw if file's full path is empty or mode is unknown, throws IllegalArgumentException.
 	 * @throw if writer create failed, throws FileOpenFailedException.
 	 * */
-	FileWriter(const File& file);
+	FileWriter(const File& file, e_int mode=WIDE);
 	
 	/**
 	 * \brief ctor.
@@ -58,10 +80,11 @@ public:
 	 * Create a file writer from a file indicates by filePath.
 	 * 
 	 * @param file from which receiver create.
-	 * @throw if filePath is empty, throws IllegalArgumentException.
+	 * @param mode FileWriter::WIDE or FileWriter::UTF8, default FileWriter::WIDE.
+	 * @throw if filePath is empty or mode is unknown, throws IllegalArgumentException.
 	 * @throw if writer create failed, throws FileOpenFailedException.
 	 * */
-	FileWriter(const String& filePath);
+	FileWriter(const String& filePath, e_int mode=WIDE);
 	
 	/**
 	 * \brief dtor.
@@ -75,6 +98,8 @@ public:
 	 * \brief Write a char.
 	 * 
 	 * Write a char to receiver, and advance writing pos by one.
+	 * In FileWriter::UTF8 mode a single UTF-16 surrogate is written as U+FFFD,
+	 * write surrogate pairs as a String instead.
 	 * 
 	 * @param c char to write.
 	 * @throw if read failed, throws IOException.
@@ -104,6 +129,26 @@ public:
 	 * @throw if write failed, throws IOException.
 	*/
 	e_void write(const String& str, e_int length=-1);
+
+	/**
+	 * \brief Write UTF-8 string.
+	 * 
+	 * Write a Utf8String to receiver, in FileWriter::UTF8 mode without transcoding.
+	 * 
+	 * @param str string to write.
+	 * @param length writing length in bytes, default -1, indicates str.length().
+	 * @throw if length<0 or length>str.length(), or length is in the middle of a char,
+	 * 		throws IllegalArgumentException.
+	 * @throw if write failed, throws IOException.
+	*/
+	e_void write(const Utf8String& str, e_int length=-1);
+
+	/**
+	 * \brief Get writing mode.
+	 * 
+	 * @return FileWriter::WIDE or FileWriter::UTF8.
+	*/
+	inline e_int getMode() const {return m_mode;}
 	
 	/**
 	 * \brief Flush cache.
@@ -123,6 +168,9 @@ public:
 
 	String toString() const override;
 private:
+	e_void _open(e_int mode);
+	e_void _writeBytes(const e_byte* bytes, e_int length);
+
 	FileWriter(FileWriter& copy)  = delete;
 	FileWriter(FileWriter&& move)  = delete;
 	FileWriter& operator=(FileWriter& copy)  = delete;	
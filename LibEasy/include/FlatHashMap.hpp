@@ -0,0 +1,632 @@
+/*
+ * 文件名: FlatHashMap.hpp
+ *
+ * 日期/时间:
+ *		开始: 2026年10月17日 23:02:51 周六
+ *		结束:
+ *
+ * 版本: 1.0
+ *
+ * 作者: Tes Alone
+ *
+ * 备注:
+*/
+
+#ifndef _EASY_FLATHASHMAP_H_
+#define _EASY_FLATHASHMAP_H_
+
+#include <new>
+#include <cstring>
+#include <emmintrin.h>
+
+#include "BaseTypes.hpp"
+#include "Exception.hpp"
+#include "Iterator.hpp"
+#include "MapEntry.hpp"
+#include "Container.hpp"
+#include "AutoPointer.hpp"
+#include "System.hpp"
+
+#include "HashSet.hpp"
+
+namespace Easy {
+
+/**
+	\class FlatHashMap
+
+	\brief 开放寻址的哈希表映射.
+
+	接口和 HashMap 相同, 但表项直接存放在一个连续数组中, 不为每个表项分配节点.
+	<br/>
+	每个槽位另有一个控制字节: 空、已删除, 或者哈希值的高 7 位. 槽位每 16 个分为一组,
+	查找时用 SSE2 一次比较一组的 16 个控制字节, 只有高 7 位相同的槽位才调用 equals();
+	组内有空槽位时查找结束, 否则按三角数步长探测下一组. 容量是 2 的幂, 定位不需要除法.
+	<br/>
+	和 HashMap 不同, 键是唯一的: put() 一个已有的键会替换它的值.
+	<br/>
+	K 需要实现 equals() 和 hashCode(), 每次扩容时重新调用 hashCode(), 哈希值不保存在表中.
+
+	@since 1.0
+*/
+template<class K, class V>
+class FlatHashMap {
+
+typedef MapEntry<K, V> Entry;
+
+class FmIterator : public Iterator<MapEntry<K,V>> {
+public:
+	FmIterator(const FlatHashMap* map) {
+		m_map        = map;
+		m_index      = 0;
+		m_expectSize = map->m_size;
+		_seek();
+	}
+
+	e_bool isEnd() const override {
+		return m_index >= m_map->m_capacity;
+	}
+
+	MapEntry<K,V>& current() const override {
+		if (isEnd())
+			throw IteratorIsEndException{__func__, __LINE__};
+		if (m_map->size() != m_expectSize)
+			throw ConcurrentModificationException(__func__, __LINE__, L"FlatHashMap");
+		return m_map->m_slots[m_index];
+	}
+
+	e_bool advance() override {
+		if (isEnd()) return false;
+		m_index++;
+		_seek();
+		return true;
+	}
+
+	~FmIterator() {}
+
+private:
+	const FlatHashMap* m_map;
+	e_int m_index;
+	e_int m_expectSize;
+
+	// 移到 m_index 开始的第一个有表项的槽位, 整组为空时一次跳过.
+	e_void _seek() {
+		const e_byte* ctrl = m_map->m_ctrl;
+		e_int capacity     = m_map->m_capacity;
+		while (m_index < capacity) {
+			if ((m_index & (GROUP-1)) == 0) {
+				e_uint full = ~_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(ctrl+m_index))) & 0xffff;
+				if (full == 0) {
+					m_index += GROUP;
+					continue;
+				}
+				m_index += __builtin_ctz(full);
+				return;
+			}
+			if (_isFull(ctrl[m_index])) return;
+			m_index++;
+		}
+	}
+
+	FmIterator(FmIterator& copy) = delete;
+	FmIterator(FmIterator&& move) = delete;
+	FmIterator& operator=(FmIterator& copy) = delete;
+	FmIterator& operator=(FmIterator&& move) = delete;
+};
+
+private:
+	/*
+		控制字节: 非负数是有表项的槽位, 值为哈希值的高 7 位;
+		EMPTY 和 DELETED 的最高位都是 1, movemask 直接得到可以插入的槽位.
+	*/
+	enum : e_byte {EMPTY = -128, DELETED = -2};
+	enum {GROUP = 16};
+
+	e_byte* m_ctrl;
+	Entry*  m_slots;
+	e_int   m_capacity;	// 2 的幂, 不小于 GROUP
+	e_int   m_size;
+	e_int   m_deleted;	// DELETED 槽位个数
+
+	// 有表项和已删除的槽位不超过 7/8, 保证每条探测序列都能遇到空槽位.
+	inline e_int _maxLoad() const {return m_capacity - m_capacity / 8;}
+
+	static inline e_bool _isFull(e_byte ctrl) {return (ctrl & 0x80) == 0;}
+
+public:
+	/**
+	 * \brief ctor.
+	 *
+	 * initCapacity 向上取为 2 的幂, 小于 16 时取 16.
+	 *
+	 * @param initCapacity init capacity, default 16.
+	*/
+	explicit FlatHashMap(e_int initCapacity=16) {
+		_init(_roundUp(initCapacity));
+	}
+
+	/**
+		\brief dtor.
+	*/
+	inline ~FlatHashMap() {
+		_dispose();
+	}
+
+	/**
+		\brief copy ctor.
+
+		@param copy
+	*/
+	FlatHashMap(const FlatHashMap& copy) {
+		_init(copy.m_capacity);
+		_copy(copy);
+	}
+
+	/**
+		\brief move ctor.
+
+		@param move
+	*/
+	FlatHashMap(FlatHashMap&& move) {
+		_steal(move);
+	}
+
+	/**
+		\brief copy assignment.
+
+		@param copy
+	*/
+	FlatHashMap& operator=(const FlatHashMap& copy) {
+		if (this != &copy) {
+			_dispose();
+			_init(copy.m_capacity);
+			_copy(copy);
+		}
+		return *this;
+	}
+
+	/**
+		\brief move assignment.
+
+		@param move
+	*/
+	FlatHashMap& operator=(FlatHashMap&& move) {
+		if (this != &move) {
+			_dispose();
+			_steal(move);
+		}
+		return *this;
+	}
+
+	/**
+	 * \brief Check equality.
+	 *
+	 * 同 HashMap::equals().
+	 *
+	 * @param other .
+	 * @return compared result.
+	 * */
+	inline e_bool equals(const FlatHashMap<K,V>& other) const {
+		return Container::equals<FlatHashMap<K,V>, FlatHashMap<K,V>, MapEntry<K,V>>(*this, other);
+	}
+
+	/**
+	 * \brief Check order.
+	 *
+	 * 同 HashMap::compare().
+	 *
+	 * @param other .
+	 * @return compared result.
+	 * */
+	inline e_int compare(const FlatHashMap<K,V>& other) const {
+		return Container::compare<FlatHashMap<K,V>, FlatHashMap<K,V>, MapEntry<K,V>>(*this, other);
+	}
+
+	/**
+	 * \brief get hash code.
+	 *
+	 * @return receiver`s hash code.
+	 * */
+	inline e_int hashCode() const {return Long::hashCode(reinterpret_cast<e_long>(this));}
+
+	/**
+	 * \brief To string represent．
+	 *
+	 * Element types need implement toString().
+	 *
+	 * @return receiver`s string represent.
+	*/
+	inline String toString() const {
+		return System::move(Container::toString<FlatHashMap<K,V>, MapEntry<K,V>>(*this));
+	}
+
+	/**
+		\brief Add key-value pair.
+
+		如果已有相同的键, 替换它的值.
+
+		@param key .
+		@param value .
+		@return key in receiver after putting.
+		@throw if key's hashCode() is negative, throws IllegalHashCodeException.
+	*/
+	inline K& put(const K& key, const V& value) {
+		return _put(key, value);
+	}
+
+	/**
+		\brief Add key-value pair.
+
+		@see FlatHashMap::put(const K&, const V&).
+	*/
+	inline K& put(const K& key, V&& value) {
+		return _put(key, System::move(value));
+	}
+
+	/**
+		\brief Add key-value pair.
+
+		@see FlatHashMap::put(const K&, const V&).
+	*/
+	inline K& put(K&& key, const V& value) {
+		return _put(System::move(key), value);
+	}
+
+	/**
+		\brief Add key-value pair.
+
+		@see FlatHashMap::put(const K&, const V&).
+	*/
+	inline K& put(K&& key, V&& value) {
+		return _put(System::move(key), System::move(value));
+	}
+
+	/**
+	 * \brief Delete key-value pair.
+	 *
+	 * @param key deleted key.
+	 * @return deleted value.
+	 * @throw if key's hashCode() is negative, throws IllegalHashCodeException.
+	 * @throw if receiver not contain key, throws HasNoSuchElementException.
+	*/
+	V remove(const K& key) {
+		e_int slot = _find(key, _hash(key));
+		if (slot < 0)
+			throw HasNoSuchElementException{__func__, __LINE__, String{L"FlatHashMap"}};
+
+		V value = System::move(m_slots[slot].m_value);
+		m_slots[slot].~Entry();
+		m_size--;
+
+		// 组内还有空槽位时, 不会有探测序列越过这一组, 可以直接标为空.
+		const e_byte* group = m_ctrl + (slot & ~(GROUP-1));
+		if (_matchEmpty(_mm_loadu_si128((const __m128i*)group)) != 0) {
+			m_ctrl[slot] = EMPTY;
+		} else {
+			m_ctrl[slot] = DELETED;
+			m_deleted++;
+		}
+		return System::move(value);
+	}
+
+	/**
+	 * \brief Get value.
+	 *
+	 * @param key key of key-value pair.
+	 * @return value of key-value pair.
+	 * @throw if key's hashCode() is negative, throws IllegalHashCodeException.
+	 * @throw if receiver not contain key, throws HasNoSuchElementException.
+	*/
+	inline V& get(const K& key) const {
+		return get(key, key.hashCode());
+	}
+
+	/**
+	 * \brief Get value by a precomputed hash code.
+	 *
+	 * @param key key of key-value pair.
+	 * @param hash key.hashCode(), computed once by the caller and reusable across maps.
+	 * @return value of key-value pair.
+	 * @throw if hash is negative, throws IllegalHashCodeException.
+	 * @throw if receiver not contain key, throws HasNoSuchElementException.
+	*/
+	V& get(const K& key, e_int hash) const {
+		e_int slot = _find(key, _check(hash));
+		if (slot < 0)
+			throw HasNoSuchElementException{__func__, __LINE__, String{L"FlatHashMap"}};
+		return m_slots[slot].m_value;
+	}
+
+	/**
+	 * \brief Get value.
+	 *
+	 * @see FlatHashMap::get().
+	*/
+	inline V& operator[](const K& key) const {
+		return get(key);
+	}
+
+	/**
+		\brief Check whether contains key.
+
+		@param key .
+		@return if receiver contains key, return true; otherwise return false.
+		@throw if key.hashCode() is negative, throws IllegalHashCodeException.
+	*/
+	inline e_bool contains(const K& key) const {
+		return _find(key, _hash(key)) >= 0;
+	}
+
+	/**
+		\brief Check whether contains key by a precomputed hash code.
+
+		@param key .
+		@param hash key.hashCode(), computed once by the caller and reusable across maps.
+		@return if receiver contains key, return true; otherwise return false.
+		@throw if hash is negative, throws IllegalHashCodeException.
+	*/
+	inline e_bool contains(const K& key, e_int hash) const {
+		return _find(key, _check(hash)) >= 0;
+	}
+
+	/**
+	 * \brief Get value without throwing on a missing key.
+	 *
+	 * @param key key of key-value pair.
+	 * @return pointer to the value, or nullptr if receiver not contain key.
+	 *         The pointer is invalidated by put(), remove() and trimCapacity().
+	 * @throw if key's hashCode() is negative, throws IllegalHashCodeException.
+	*/
+	inline V* tryGet(const K& key) const {
+		return tryGet(key, key.hashCode());
+	}
+
+	/**
+	 * \brief Get value by a precomputed hash code without throwing on a missing key.
+	 *
+	 * @param key key of key-value pair.
+	 * @param hash key.hashCode(), computed once by the caller and reusable across maps.
+	 * @return pointer to the value, or nullptr if receiver not contain key.
+	 * @throw if hash is negative, throws IllegalHashCodeException.
+	*/
+	V* tryGet(const K& key, e_int hash) const {
+		e_int slot = _find(key, _check(hash));
+		return slot >= 0 ? &m_slots[slot].m_value : nullptr;
+	}
+
+	/**
+	 * \brief Trim capacity to fix receiver's length.
+	 *
+	 * 容量缩小为能容纳全部表项的最小的 2 的幂, 同时清除已删除的槽位.
+	 *
+	 * @return receiver after trimming.
+	*/
+	FlatHashMap& trimCapacity() {
+		e_int capacity = GROUP;
+		while (capacity - capacity / 8 <= m_size) capacity *= 2;
+		if (capacity != m_capacity || m_deleted != 0)
+			_rehash(capacity);
+		return *this;
+	}
+
+	/**
+	 * \brief Get size.
+	 *
+	 * @return receiver's size.
+	*/
+	inline e_int size() const {
+		return m_size;
+	}
+
+	/**
+	 * \brief Check whether is empty.
+	 *
+	 * @return receiver's size == 0.
+	*/
+	inline e_bool empty() const {
+		return m_size == 0;
+	}
+
+	/**
+	 * \brief Get capacity used.
+	 *
+	 * @return count of slots, always a power of 2.
+	*/
+	inline e_int capacity() const {
+		return m_capacity;
+	}
+
+	/**
+	 * \brief Clean buffer.
+	 *
+	 * Clean buffer and reinitialize.
+	*/
+	inline e_void clean() {
+		_dispose();
+		_init(GROUP);
+	}
+
+	/**
+	 * \brief Get %iterator.
+	 *
+	 * 按槽位顺序访问, 和插入顺序无关.
+	 * <b>The %iterator's status will change after receiver changed after this method called.</b>
+	 *
+	 * @return receiver's %iterator.
+	 * @sa Iterator
+	*/
+	inline Iterator<MapEntry<K,V>>* iterator() const {
+		return new FmIterator{this};
+	}
+
+	/**
+	 * \brief Get key set.
+	 *
+	 * @return receiver's key set.
+	 * */
+	HashSet<K> keySet() const {
+		HashSet<K> set;
+		AutoPointer<Iterator<MapEntry<K, V>>> iter{this->iterator()};
+		while (!iter->isEnd()) {
+			set.add(iter->current().m_key);
+			iter->advance();
+		}
+		return System::move(set);
+	}
+
+private:
+	static e_int _roundUp(e_int capacity) {
+		e_int result = GROUP;
+		while (result < capacity) result *= 2;
+		return result;
+	}
+
+	static inline e_int _check(e_int hash) {
+		if (hash < 0)
+			throw IllegalHashCodeException{__func__, __LINE__, hash};
+		return hash;
+	}
+
+	static inline e_int _hash(const K& key) {
+		return _check(key.hashCode());
+	}
+
+	/*
+		hashCode() 常常是键本身 (如 Integer), 先乘以 2^64 / 黄金分割比打散:
+		高 7 位作为控制字节, 第 25 位起选择组, 两者互不重叠.
+	*/
+	static inline e_ulong _mix(e_int hash) {
+		return (e_ulong)(e_uint)hash * 0x9e3779b97f4a7c15ULL;
+	}
+
+	static inline e_byte _h2(e_ulong mixed) {
+		return (e_byte)(mixed >> 57);
+	}
+
+	inline e_int _firstGroup(e_ulong mixed) const {
+		return (e_int)(mixed >> 25) & (m_capacity / GROUP - 1);
+	}
+
+	static inline e_uint _match(__m128i ctrl, e_byte h2) {
+		return _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(h2)));
+	}
+
+	static inline e_uint _matchEmpty(__m128i ctrl) {
+		return _mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(EMPTY)));
+	}
+
+	// 查找 key 所在的槽位, 没有找到返回 -1.
+	e_int _find(const K& key, e_int hash) const {
+		e_ulong mixed = _mix(hash);
+		e_byte h2     = _h2(mixed);
+		e_int mask    = m_capacity / GROUP - 1;
+		e_int group   = _firstGroup(mixed);
+
+		for (e_int step=1; ; step++) {
+			const e_byte* ctrl = m_ctrl + group * GROUP;
+			__m128i c = _mm_loadu_si128((const __m128i*)ctrl);
+			for (e_uint match = _match(c, h2); match != 0; match &= match - 1) {
+				e_int slot = group * GROUP + __builtin_ctz(match);
+				if (m_slots[slot].m_key.equals(key))
+					return slot;
+			}
+			if (_matchEmpty(c) != 0)
+				return -1;
+			group = (group + step) & mask;
+		}
+	}
+
+	// 沿探测序列找第一个空的或已删除的槽位.
+	e_int _findFree(e_ulong mixed) const {
+		e_int mask  = m_capacity / GROUP - 1;
+		e_int group = _firstGroup(mixed);
+
+		for (e_int step=1; ; step++) {
+			e_uint free = _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(m_ctrl + group * GROUP)));
+			if (free != 0)
+				return group * GROUP + __builtin_ctz(free);
+			group = (group + step) & mask;
+		}
+	}
+
+	template<class KK, class VV>
+	K& _put(KK&& key, VV&& value) {
+		e_int hash = _hash(key);
+		e_int slot = _find(key, hash);
+		if (slot >= 0) {
+			m_slots[slot].m_value = static_cast<VV&&>(value);
+			return m_slots[slot].m_key;
+		}
+
+		if (m_size + m_deleted >= _maxLoad()) {
+			// 已删除的槽位较多时, 原容量重建就能腾出空间.
+			_rehash(m_size >= _maxLoad() / 2 ? m_capacity * 2 : m_capacity);
+		}
+
+		e_ulong mixed = _mix(hash);
+		slot = _findFree(mixed);
+		new (m_slots + slot) Entry(static_cast<KK&&>(key), static_cast<VV&&>(value));
+		if (m_ctrl[slot] == DELETED) m_deleted--;
+		m_ctrl[slot] = _h2(mixed);
+		m_size++;
+		return m_slots[slot].m_key;
+	}
+
+	e_void _init(e_int capacity) {
+		m_capacity = capacity;
+		m_size     = 0;
+		m_deleted  = 0;
+		m_ctrl     = new e_byte[capacity];
+		m_slots    = static_cast<Entry*>(::operator new(sizeof(Entry) * capacity));
+		::memset(m_ctrl, EMPTY, capacity);
+	}
+
+	e_void _steal(FlatHashMap& move) {
+		m_ctrl     = move.m_ctrl;
+		m_slots    = move.m_slots;
+		m_capacity = move.m_capacity;
+		m_size     = move.m_size;
+		m_deleted  = move.m_deleted;
+		move._init(GROUP);
+	}
+
+	e_void _copy(const FlatHashMap& copy) {
+		for (e_int i=0; i<copy.m_capacity; i++) {
+			if (_isFull(copy.m_ctrl[i]))
+				_put(copy.m_slots[i].m_key, copy.m_slots[i].m_value);
+		}
+	}
+
+	e_void _dispose() {
+		for (e_int i=0; i<m_capacity; i++) {
+			if (_isFull(m_ctrl[i])) m_slots[i].~Entry();
+		}
+		delete [] m_ctrl;
+		::operator delete(m_slots);
+	}
+
+	e_void _rehash(e_int newCapacity) {
+		e_byte* oldCtrl   = m_ctrl;
+		Entry*  oldSlots  = m_slots;
+		e_int oldCapacity = m_capacity;
+		e_int oldSize     = m_size;
+
+		_init(newCapacity);
+		for (e_int i=0; i<oldCapacity; i++) {
+			if (!_isFull(oldCtrl[i])) continue;
+			Entry& entry  = oldSlots[i];
+			e_ulong mixed = _mix(entry.m_key.hashCode());
+			e_int slot    = _findFree(mixed);
+			new (m_slots + slot) Entry(System::move(entry.m_key), System::move(entry.m_value));
+			m_ctrl[slot] = _h2(mixed);
+			entry.~Entry();
+		}
+		m_size = oldSize;
+
+		delete [] oldCtrl;
+		::operator delete(oldSlots);
+	}
+}; // FlatHashMap
+
+} // Easy
+
+#endif // _EASY_FLATHASHMAP_H_
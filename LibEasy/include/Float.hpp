@@ -19,6 +19,8 @@
 
 namespace Easy {
 
+class StringBuffer;
+
 /**
  * \class Float
  * 
@@ -32,6 +34,11 @@ private:
 	e_float m_value;
 public:
 
+	/**
+		\brief Max chars written by writeTo(), a '-' and 21 digits in plain notation.
+	*/
+	static const e_int MAX_CHARS = 22;
+
 	/**
 		\brief Constant PI.
 		
@@ -172,11 +179,64 @@ public:
 	/**
 	 * \brief To string．
 	 * 
+	 * Shortest decimal that parses back to the same e_float, e.g. 0.1 is "0.1" not "0.100000001".
+	 * Plain notation is used when the decimal point is between 1e-6 and 1e21,
+	 * otherwise scientific notation like "1.5e-7", "3.4e38". NaN and infinities are
+	 * "NaN", "Infinity" and "-Infinity", negative zero is "-0".
+	 * 
 	 * @param f .
 	 * @returns f's string represent.
 	*/
 	static String toString(e_float f);
 	
+	/**
+	 * \brief Write to a caller buffer.
+	 * 
+	 * Same chars as toString(e_float), but no String is built and no '\\0' is written.
+	 * 
+	 * @param f .
+	 * @param out at least Float::MAX_CHARS chars.
+	 * @return count of chars written.
+	*/
+	static e_int writeTo(e_float f, e_char* out);
+	
+	/**
+	 * \brief Write ASCII chars to a caller buffer.
+	 * 
+	 * Same as writeTo(e_float, e_char*), for UTF-8 or ANSI text.
+	*/
+	static e_int writeTo(e_float f, e_byte* out);
+	
+	/**
+	 * \brief Append to a StringBuffer.
+	 * 
+	 * @param sb .
+	 * @param f .
+	 * @return sb.
+	*/
+	static StringBuffer& appendTo(StringBuffer& sb, e_float f);
+	
+	/**
+	 * \brief Append receiver to a StringBuffer.
+	 * 
+	 * @param sb .
+	 * @return sb.
+	*/
+	inline StringBuffer& appendTo(StringBuffer& sb) const {return appendTo(sb, m_value);}
+	
+	/**
+	 * \brief Append an array.
+	 * 
+	 * Same as Integer::appendTo(StringBuffer&, const IntArray&, const StringView&),
+	 * values are formatted into a stack chunk before appended to sb.
+	 * 
+	 * @param sb .
+	 * @param values .
+	 * @param separator put between two values, can be empty.
+	 * @return sb.
+	*/
+	static StringBuffer& appendTo(StringBuffer& sb, const FloatArray& values, const StringView& separator);
+	
 	/**
 	 * \brief To hex string.
 	 * 
@@ -234,15 +294,38 @@ public:
 	/**
 	 * \brief Parse string to e_float.
 	 * 
-	 * str needs match: "-?[0-9]*\.[0-9]+" 、"-?[0-9]+[eE]-?[0-9]+"、"-?[0-9]*\.[0-9]+[eE]-?[0-9]+".
+	 * str needs match: "[+-]?[0-9]+(\.[0-9]*)?([eE][+-]?[0-9]+)?" or "[+-]?\.[0-9]+([eE][+-]?[0-9]+)?",
+	 * "NaN", "Infinity" and "-Infinity" are accepted too, so every toString() result parses back.
+	 * The result is correctly rounded to nearest, any count of digits is allowed.
 	 * 
 	 * @param str 
 	 * @return a e_float value.
 	 * @throw if str is illegal, throws NumberFormatException.
-	 * @throw if str's exponent is bigger or less than Float::maxExp() and Float::minExp(), respectively, throws FloatExpException.
+	 * @throw if str is not zero but rounds to zero, or is finite but rounds to infinity, throws FloatExpException.
 	*/
 	static e_float parse(const String& str);
 	
+	/**
+	 * \brief Parse chars to e_float without throwing.
+	 * 
+	 * Same syntax and rounding as parse(const String&), but chs needs not be a String
+	 * or end with '\\0', e.g. a field of a StringView or a line buffer.
+	 * Values out of range are not errors here, result is then ±Infinity or ±0.
+	 * 
+	 * @param chs .
+	 * @param length length of chs.
+	 * @param result set only when chs is legal.
+	 * @return -1 if chs is legal, otherwise position of the first illegal char (length if chs ends too early).
+	*/
+	static e_int parse(const e_char* chs, e_int length, e_float& result);
+	
+	/**
+	 * \brief Parse ASCII chars to e_float without throwing.
+	 * 
+	 * Same as parse(const e_char*, e_int, e_float&), for UTF-8 or ANSI text.
+	*/
+	static e_int parse(const e_byte* chs, e_int length, e_float& result);
+	
 }; // Float
 
 /**
@@ -258,6 +341,11 @@ private:
 	e_double m_value;
 public:
 
+	/**
+		\brief Max chars written by writeTo(), "-0.00000" and 17 digits.
+	*/
+	static const e_int MAX_CHARS = 25;
+
 	/**
 		\brief Constant PI.
 		
@@ -398,11 +486,64 @@ public:
 	/**
 	 * \brief To string．
 	 * 
+	 * Shortest decimal that parses back to the same e_double, e.g. 0.1 is "0.1" not "0.100000001".
+	 * Plain notation is used when the decimal point is between 1e-6 and 1e21,
+	 * otherwise scientific notation like "1.5e-7", "3.4e38". NaN and infinities are
+	 * "NaN", "Infinity" and "-Infinity", negative zero is "-0".
+	 * 
 	 * @param d .
 	 * @returns d's string represent.
 	*/
 	static String toString(e_double d);
 	
+	/**
+	 * \brief Write to a caller buffer.
+	 * 
+	 * Same chars as toString(e_double), but no String is built and no '\\0' is written.
+	 * 
+	 * @param d .
+	 * @param out at least Double::MAX_CHARS chars.
+	 * @return count of chars written.
+	*/
+	static e_int writeTo(e_double d, e_char* out);
+	
+	/**
+	 * \brief Write ASCII chars to a caller buffer.
+	 * 
+	 * Same as writeTo(e_double, e_char*), for UTF-8 or ANSI text.
+	*/
+	static e_int writeTo(e_double d, e_byte* out);
+	
+	/**
+	 * \brief Append to a StringBuffer.
+	 * 
+	 * @param sb .
+	 * @param d .
+	 * @return sb.
+	*/
+	static StringBuffer& appendTo(StringBuffer& sb, e_double d);
+	
+	/**
+	 * \brief Append receiver to a StringBuffer.
+	 * 
+	 * @param sb .
+	 * @return sb.
+	*/
+	inline StringBuffer& appendTo(StringBuffer& sb) const {return appendTo(sb, m_value);}
+	
+	/**
+	 * \brief Append an array.
+	 * 
+	 * Same as Integer::appendTo(StringBuffer&, const IntArray&, const StringView&),
+	 * values are formatted into a stack chunk before appended to sb.
+	 * 
+	 * @param sb .
+	 * @param values .
+	 * @param separator put between two values, can be empty.
+	 * @return sb.
+	*/
+	static StringBuffer& appendTo(StringBuffer& sb, const DoubleArray& values, const StringView& separator);
+	
 	/**
 	 * \brief To hex string.
 	 * 
@@ -461,14 +602,37 @@ public:
 	/**
 	 * \brief Parse string to e_double.
 	 * 
-	 * str needs match: "-?[0-9]*\.[0-9]+" 、"-?[0-9]+[eE]-?[0-9]+"、"-?[0-9]*\.[0-9]+[eE]-?[0-9]+".
+	 * str needs match: "[+-]?[0-9]+(\.[0-9]*)?([eE][+-]?[0-9]+)?" or "[+-]?\.[0-9]+([eE][+-]?[0-9]+)?",
+	 * "NaN", "Infinity" and "-Infinity" are accepted too, so every toString() result parses back.
+	 * The result is correctly rounded to nearest, any count of digits is allowed.
 	 * 
 	 * @param str 
 	 * @return a e_double value.
 	 * @throw if str is illegal, throws NumberFormatException.
-	 * @throw if str's exponent is bigger or less than Double::maxExp() and Double::minExp(), respectively, throws FloatExpException.
+	 * @throw if str is not zero but rounds to zero, or is finite but rounds to infinity, throws FloatExpException.
 	*/
 	static e_double parse(const String& str);
+	
+	/**
+	 * \brief Parse chars to e_double without throwing.
+	 * 
+	 * Same syntax and rounding as parse(const String&), but chs needs not be a String
+	 * or end with '\\0', e.g. a field of a StringView or a line buffer.
+	 * Values out of range are not errors here, result is then ±Infinity or ±0.
+	 * 
+	 * @param chs .
+	 * @param length length of chs.
+	 * @param result set only when chs is legal.
+	 * @return -1 if chs is legal, otherwise position of the first illegal char (length if chs ends too early).
+	*/
+	static e_int parse(const e_char* chs, e_int length, e_double& result);
+	
+	/**
+	 * \brief Parse ASCII chars to e_double without throwing.
+	 * 
+	 * Same as parse(const e_char*, e_int, e_double&), for UTF-8 or ANSI text.
+	*/
+	static e_int parse(const e_byte* chs, e_int length, e_double& result);
 }; // Double
 
 } // Easy
@@ -18,6 +18,7 @@
 #include "Container.hpp"
 #include "AutoPointer.hpp"
 #include "System.hpp"
+#include "NodePool.hpp"
 
 #include "HashSet.hpp"
 //#include "Console.hpp"
@@ -31,10 +32,15 @@ namespace Easy {
 	
 	This class allows same keys exists.
 	
+	Lookups compare the cached hash code before calling equals(), so keys with a
+	cheap precomputed hashCode(), such as InternedString, are found with no content comparison.
+	
+	A is the node allocation policy, see List.
+	
 	@author Tes Alone
 	@since 1.0
 */
-template<class K, class V>
+template<class K, class V, class A = HeapAllocator>
 class HashMap {
 
 class Node {
@@ -42,6 +48,9 @@ public:
 	MapEntry<K, V> m_entry;
 	Node* m_next;
 	e_int m_hashCode;
+
+	static inline e_void* operator new(size_t size) {return A::allocate(size);}
+	static inline e_void operator delete(e_void* node, size_t size) {A::deallocate(node, size);}
 	
 	Node(const MapEntry<K, V>& entry, e_int h) {
 		m_entry    = entry;
@@ -63,12 +72,23 @@ private:
 	const HashMap* m_map; // for access modify problem.
 	e_int m_expectSize; // for access modify problem.
 public:
-	HmIterator(const HashMap* map, Node** table, e_int capacity, e_int length) {
+	HmIterator(const HashMap* map, e_int length) {
 		m_map 	   = map;
-		m_table    = table;
-		m_capacity = capacity;
-		m_index	   = 0;
 		m_expectSize = length;
+		m_segments   = 0;
+		if (map->m_oldTable) {
+			// buckets not migrated yet are still in the old table; the migrated ones are new buckets
+			// [0, m_moved) and [m_oldCapacity, m_oldCapacity+m_moved), the others are not initialized.
+			_addSegment(map->m_oldTable, map->m_moved, map->m_oldCapacity);
+			_addSegment(map->m_table, 0, map->m_moved);
+			_addSegment(map->m_table, map->m_oldCapacity, map->m_oldCapacity + map->m_moved);
+		} else {
+			_addSegment(map->m_table, 0, map->m_capacity);
+		}
+		m_segment  = 0;
+		m_table    = m_tables[0];
+		m_index    = m_begins[0];
+		m_capacity = m_ends[0];
 		_getCur();
 	}
 	
@@ -100,15 +120,32 @@ private:
 	e_int  m_capacity;
 	e_int  m_index;
 	Node*  m_cur;
+	Node** m_tables[3];
+	e_int  m_begins[3];
+	e_int  m_ends[3];
+	e_int  m_segments;
+	e_int  m_segment;
+	
+	e_void _addSegment(Node** table, e_int begin, e_int end) {
+		m_tables[m_segments] = table;
+		m_begins[m_segments] = begin;
+		m_ends[m_segments]   = end;
+		m_segments++;
+	}
 	
 	e_void _getCur() {
-		for (e_int i=m_index; i<m_capacity; i++) {
-			if (m_table[i] != nullptr) {
-				m_cur = m_table[i];
-				return;
-			} else {
-				m_index++;
+		for (;;) {
+			for (; m_index<m_capacity; m_index++) {
+				if (m_table[m_index] != nullptr) {
+					m_cur = m_table[m_index];
+					return;
+				}
 			}
+			if (++m_segment == m_segments)
+				break;
+			m_table    = m_tables[m_segment];
+			m_index    = m_begins[m_segment];
+			m_capacity = m_ends[m_segment];
 		}
 		m_cur = nullptr;
 	}
@@ -123,10 +160,22 @@ private:
 	Node** m_table;
 	e_int  m_capacity;
 	e_int  m_size;
+	Node** m_oldTable;    // table being migrated in incremental mode, otherwise nullptr.
+	e_int  m_oldCapacity;
+	e_int  m_moved;       // buckets [0, m_moved) of m_oldTable are migrated.
+	e_bool m_incremental;
 	
 	constexpr e_int threshold() {return (e_int) (m_capacity * 0.75);}
 	
 public:
+	/**
+	 * \brief Buckets migrated by each put() and remove() in incremental rehash mode.
+	 * 
+	 * Growing starts when size() exceeds 3/4 of the old capacity and the next growth needs
+	 * as many puts again, so any step >= 2 finishes migrating before the next growth.
+	*/
+	static constexpr e_int REHASH_STEP = 8;
+	
 	/**
 	 * \brief ctor.
 	 * 
@@ -138,6 +187,7 @@ public:
 		if (initCapacity < 16)
 			initCapacity = 16;		
 		_init(initCapacity);
+		m_incremental = false;
 	}
 	
 	/**
@@ -154,6 +204,7 @@ public:
 	*/
 	inline HashMap(const HashMap& copy) {
 		_init();
+		m_incremental = copy.m_incremental;
 		_copy(copy);
 	}
 	
@@ -163,15 +214,7 @@ public:
 		@param move
 	*/
 	HashMap(HashMap&& move) {
-		m_table         = move.m_table;
-		m_capacity      = move.m_capacity;
-		m_size 		 	= move.m_size;
-		move.m_table 	= new Node*[16];
-		move.m_capacity = 16;
-		move.m_size 	= 0;
-		for (e_int i=0; i<move.m_capacity; i++) {
-			move.m_table[i] = nullptr;
-		}
+		_steal(move);
 	}
 	
 	/**
@@ -182,6 +225,7 @@ public:
 	HashMap& operator=(const HashMap& copy) {
 		_dispose();
 		_init();
+		m_incremental = copy.m_incremental;
 		_copy(copy);		
 		return *this;
 	}
@@ -193,15 +237,7 @@ public:
 	*/
 	HashMap& operator=(HashMap&& move) {
 		_dispose();
-		m_table         = move.m_table;
-		m_capacity      = move.m_capacity;
-		m_size 		 	= move.m_size;
-		move.m_table 	= new Node*[16];
-		move.m_capacity = 16;
-		move.m_size 	= 0;
-		for (e_int i=0; i<move.m_capacity; i++) {
-			move.m_table[i] = nullptr;
-		}
+		_steal(move);
 		return *this;
 	}
 	
@@ -216,8 +252,8 @@ public:
 	 * @param other .
 	 * @return  compared result.
 	 * */
-	inline e_bool equals(const HashMap<K,V>& other) const {
-		return Container::equals<HashMap<K,V>, HashMap<K,V>, MapEntry<K,V>>(*this, other);
+	inline e_bool equals(const HashMap<K, V, A>& other) const {
+		return Container::equals<HashMap<K, V, A>, HashMap<K, V, A>, MapEntry<K,V>>(*this, other);
 	}
 
 	/**
@@ -232,8 +268,8 @@ public:
 	 * @param other .
 	 * @return compared result.
 	 * */
-	inline e_int compare(const HashMap<K,V>& other) const {
-		return Container::compare<HashMap<K,V>, HashMap<K, V>, MapEntry<K,V>>(*this, other);
+	inline e_int compare(const HashMap<K, V, A>& other) const {
+		return Container::compare<HashMap<K, V, A>, HashMap<K, V, A>, MapEntry<K,V>>(*this, other);
 	}
 
 	/**
@@ -253,7 +289,7 @@ public:
 	 * @return receiver`s string represent.
 	*/
 	inline String toString() const {
-		return System::move(Container::toString<HashMap<K,V>, MapEntry<K,V>>(*this));
+		return System::move(Container::toString<HashMap<K, V, A>, MapEntry<K,V>>(*this));
 	}
 	
 	/**
@@ -265,31 +301,12 @@ public:
 		@throw if key's hashCode() is negative, throws IllegalHashCodeException.
 	*/
 	K& put(const K& key, const V& value) {
-		if (m_size > threshold()) {
-			_rehash(m_capacity*2);
-		}
-		
 		e_int hash = key.hashCode();
 		if (hash < 0) {
 			throw IllegalHashCodeException{__func__, __LINE__, hash};
 		}
-		e_int slot = hash % m_capacity;
-		
-		if (m_table[slot] == nullptr) {
-			m_table[slot] = new Node(System::move(MapEntry<K, V>{key, value}), hash);
-			m_size++;
-			return m_table[slot]->m_entry.m_key;
-		} else {
-			Node* cur = m_table[slot];
-			Node* prev = cur;
-			while (cur) {
-				prev = cur;
-				cur = cur->m_next;
-			}
-			prev->m_next = new Node(System::move(MapEntry<K, V>{key, value}), hash);
-			m_size++;
-			return prev->m_next->m_entry.m_key;
-		}
+		_grow();
+		return _append(new Node(MapEntry<K, V>{key, value}, hash))->m_entry.m_key;
 	}
 	
 	/**
@@ -301,31 +318,12 @@ public:
 		@throw if key's hashCode() is negative, throws IllegalHashCodeException.
 	*/
 	K& put(const K& key, V&& value) {
-		if (m_size > threshold()) {
-			_rehash(m_capacity*2);
-		}
-		
 		e_int hash = key.hashCode();
 		if (hash < 0) {
 			throw IllegalHashCodeException{__func__, __LINE__, hash};
 		}
-		e_int slot = hash % m_capacity;
-		
-		if (m_table[slot] == nullptr) {
-			m_table[slot] = new Node(System::move(MapEntry<K, V>{key, System::move(value)}), hash);
-			m_size++;
-			return m_table[slot]->m_entry.m_key;
-		} else {
-			Node* cur = m_table[slot];
-			Node* prev = cur;
-			while (cur) {
-				prev = cur;
-				cur = cur->m_next;
-			}
-			prev->m_next = new Node(System::move(MapEntry<K, V>{key, System::move(value)}), hash);
-			m_size++;
-			return prev->m_next->m_entry.m_key;
-		}
+		_grow();
+		return _append(new Node(MapEntry<K, V>{key, System::move(value)}, hash))->m_entry.m_key;
 	}
 	
 	/**
@@ -337,31 +335,12 @@ public:
 		@throw if key's hashCode() is negative, throws IllegalHashCodeException.
 	*/
 	K& put(K&& key, const V& value) {
-		if (m_size > threshold()) {
-			_rehash(m_capacity*2);
-		}
-		
 		e_int hash = key.hashCode();
 		if (hash < 0) {
 			throw IllegalHashCodeException{__func__, __LINE__, hash};
 		}
-		e_int slot = hash % m_capacity;
-		
-		if (m_table[slot] == nullptr) {
-			m_table[slot] = new Node(System::move(MapEntry<K, V>{System::move(key), value}), hash);
-			m_size++;
-			return m_table[slot]->m_entry.m_key;
-		} else {
-			Node* cur = m_table[slot];
-			Node* prev = cur;
-			while (cur) {
-				prev = cur;
-				cur = cur->m_next;
-			}
-			prev->m_next = new Node(System::move(MapEntry<K, V>{System::move(key), value}), hash);
-			m_size++;
-			return prev->m_next->m_entry.m_key;
-		}
+		_grow();
+		return _append(new Node(MapEntry<K, V>{System::move(key), value}, hash))->m_entry.m_key;
 	}
 	
 	/**
@@ -373,31 +352,12 @@ public:
 		@throw if key's hashCode() is negative, throws IllegalHashCodeException.
 	*/
 	K& put(K&& key, V&& value) {
-		if (m_size > threshold()) {
-			_rehash(m_capacity*2);
-		}
-		
 		e_int hash = key.hashCode();
 		if (hash < 0) {
 			throw IllegalHashCodeException{__func__, __LINE__, hash};
 		}
-		e_int slot = hash % m_capacity;
-		
-		if (m_table[slot] == nullptr) {
-			m_table[slot] = new Node(System::move(MapEntry<K, V>{System::move(key), System::move(value)}), hash);
-			m_size++;
-			return m_table[slot]->m_entry.m_key;
-		} else {
-			Node* cur = m_table[slot];
-			Node* prev = cur;
-			while (cur) {
-				prev = cur;
-				cur = cur->m_next;
-			}
-			prev->m_next = new Node(System::move(MapEntry<K, V>{System::move(key), System::move(value)}), hash);
-			m_size++;
-			return prev->m_next->m_entry.m_key;
-		}
+		_grow();
+		return _append(new Node(MapEntry<K, V>{System::move(key), System::move(value)}, hash))->m_entry.m_key;
 	}
 	
 	/**
@@ -413,30 +373,26 @@ public:
 		if (hash < 0) {
 			throw IllegalHashCodeException{__func__, __LINE__, hash};
 		}
-		e_int slot = hash % m_capacity;
-		Node* cur = m_table[slot];
-		Node* prev = cur;
-		while (cur) {
-			if (cur->m_entry.m_key.equals(key)) {
+		Node** link = _bucket(hash);
+		while (*link) {
+			if ((*link)->m_hashCode == hash && (*link)->m_entry.m_key.equals(key)) {
 				break;
 			}
-			prev = cur;
-			cur = cur->m_next;
+			link = &(*link)->m_next;
 		}
 		
+		Node* cur = *link;
 		if (cur == nullptr) {
 			throw  HasNoSuchElementException{__func__, __LINE__, String{L"HashMap"}};
 		}
-		
-		if (cur == m_table[slot]) {
-			m_table[slot] = cur->m_next;
-		} else {
-			prev->m_next = cur->m_next;
-		}
+		*link = cur->m_next;
 		
 		MapEntry<K,V> _moveEntry = System::move(cur->m_entry);
 		delete cur;
 		m_size--;
+		if (m_oldTable) {
+			_migrate(REHASH_STEP);
+		}
 		return System::move(_moveEntry.m_value);
 	}
 	
@@ -449,23 +405,64 @@ public:
 	 * @throw if receiver not contain key, throws HasNoSuchElementException.
 	*/
 	V& get(const K& key) const {
-		e_int hash = key.hashCode();
-		if (hash < 0) {
-			throw IllegalHashCodeException{__func__, __LINE__, hash};
-		}
-		e_int slot = hash % m_capacity;
-		Node* cur = m_table[slot];
-		while (cur) {
-			if (cur->m_entry.m_key.equals(key)) {
-				break;
-			}
-			cur = cur->m_next;
-		}
-		if (cur == nullptr) {
+		return get(key, key.hashCode());
+	}
+	
+	/**
+	 * \brief Get value by a precomputed hash code.
+	 * 
+	 * @param key key of key-value pair.
+	 * @param hash key.hashCode(), computed once by the caller and reusable across maps.
+	 * @return value of key-value pair.
+	 * @throw if hash is negative, throws IllegalHashCodeException.
+	 * @throw if receiver not contain key, throws HasNoSuchElementException.
+	*/
+	V& get(const K& key, e_int hash) const {
+		Node* node = _find(key, hash);
+		if (node == nullptr) {
 			throw  HasNoSuchElementException{__func__, __LINE__, String{L"HashMap"}};
 		}
-		
-		return cur->m_entry.m_value;
+		return node->m_entry.m_value;
+	}
+	
+	/**
+	 * \brief Get value without throwing on a missing key.
+	 * 
+	 * Prefer this to get() when misses are common: a miss costs one failed probe instead of an exception.
+	 * 
+	 * @param key key of key-value pair.
+	 * @return pointer to the value, or nullptr if receiver not contain key.
+	 *         The pointer is invalidated by put(), remove() and trimCapacity().
+	 * @throw if key's hashCode() is negative, throws IllegalHashCodeException.
+	*/
+	inline V* tryGet(const K& key) const {
+		return tryGet(key, key.hashCode());
+	}
+	
+	/**
+	 * \brief Get value by a precomputed hash code without throwing on a missing key.
+	 * 
+	 * @param key key of key-value pair.
+	 * @param hash key.hashCode(), computed once by the caller and reusable across maps.
+	 * @return pointer to the value, or nullptr if receiver not contain key.
+	 * @throw if hash is negative, throws IllegalHashCodeException.
+	*/
+	V* tryGet(const K& key, e_int hash) const {
+		Node* node = _find(key, hash);
+		return node ? &node->m_entry.m_value : nullptr;
+	}
+	
+	/**
+	 * \brief Find key-value pair without throwing on a missing key.
+	 * 
+	 * @param key key of key-value pair.
+	 * @return pointer to the stored key-value pair, or nullptr if receiver not contain key.
+	 *         The key must not be modified through the pointer.
+	 * @throw if key's hashCode() is negative, throws IllegalHashCodeException.
+	*/
+	MapEntry<K, V>* find(const K& key) const {
+		Node* node = _find(key, key.hashCode());
+		return node ? &node->m_entry : nullptr;
 	}
 	
 	/**
@@ -487,20 +484,20 @@ public:
 		@return if receiver contains key, return true; otherwise return false.
 		@throw if key.hashCode() is negative, throws IllegalHashCodeException.
 	*/
-	e_bool contains(const K& key) const {
-		e_int hash = key.hashCode();
-		if (hash < 0) {
-			throw IllegalHashCodeException{__func__, __LINE__, hash};
-		}
-		e_int slot = hash % m_capacity;
-		Node* cur  = m_table[slot];
-		while (cur) {
-			if (cur->m_entry.m_key.equals(key)) {
-				return true;
-			}
-			cur = cur->m_next;
-		}
-		return false;
+	inline e_bool contains(const K& key) const {
+		return _find(key, key.hashCode()) != nullptr;
+	}
+	
+	/**
+		\brief Check whether contains key by a precomputed hash code.
+
+		@param key .
+		@param hash key.hashCode(), computed once by the caller and reusable across maps.
+		@return if receiver contains key, return true; otherwise return false.
+		@throw if hash is negative, throws IllegalHashCodeException.
+	*/
+	inline e_bool contains(const K& key, e_int hash) const {
+		return _find(key, hash) != nullptr;
 	}
 	
 	/**
@@ -517,6 +514,73 @@ public:
 		return *this;
 	}
 	
+	/**
+	 * \brief Reserve capacity for n entries.
+	 * 
+	 * After reserve(n), putting until size() reaches n never rehashes.
+	 * Capacity is never reduced, use trimCapacity() for that.
+	 * 
+	 * @param n expected count of entries.
+	 * @return receiver.
+	 * @throw if n is negative, throws IllegalArgumentException.
+	*/
+	HashMap& reserve(e_int n) {
+		if (n < 0) {
+			throw IllegalArgumentException{__func__, __LINE__};
+		}
+		// put() grows when size() > threshold() before inserting, n + n/3 + 1 keeps the n-th put below it.
+		e_long need = (e_long)n + n / 3 + 1;
+		if (need > Integer::MAX) {
+			need = Integer::MAX;
+		}
+		if (need > m_capacity) {
+			_rehash((e_int)need);
+		}
+		return *this;
+	}
+	
+	/**
+	 * \brief Set rehash mode.
+	 * 
+	 * By default, when size() exceeds 3/4 of capacity(), put() doubles the table and moves
+	 * every entry at once, a pause proportional to size().
+	 * <br/>
+	 * In incremental mode, growing only allocates the new table; every put() and remove() then
+	 * migrates REHASH_STEP buckets of the old table, and lookups consult whichever table holds
+	 * the key's bucket. The total work is the same, but no single put() pays for the whole table.
+	 * <br/>
+	 * Turning incremental mode off finishes any migration in progress.
+	 * 
+	 * @param incremental true for incremental mode.
+	 * @return receiver.
+	*/
+	HashMap& setIncrementalRehash(e_bool incremental) {
+		m_incremental = incremental;
+		if (!incremental) {
+			_finishRehash();
+		}
+		return *this;
+	}
+	
+	/**
+	 * \brief Check whether in incremental rehash mode.
+	 * 
+	 * @return true if incremental mode.
+	 * @see setIncrementalRehash().
+	*/
+	inline e_bool isIncrementalRehash() const {
+		return m_incremental;
+	}
+	
+	/**
+	 * \brief Check whether an incremental rehash is in progress.
+	 * 
+	 * @return true if some entries are still in the old table.
+	*/
+	inline e_bool isRehashing() const {
+		return m_oldTable != nullptr;
+	}
+	
 	/**
 	 * \brief Get size.
 	 * 
@@ -563,7 +627,7 @@ public:
 	 * @sa Iterator
 	*/
 	inline Iterator<MapEntry<K,V>>* iterator() const {
-		return new HmIterator{this, m_table, m_capacity, m_size};
+		return new HmIterator{this, m_size};
 	}
 	
 	/**
@@ -571,8 +635,8 @@ public:
 	 * 
 	 * @return receiver's key set.
 	 * */
-	 HashSet<K> keySet() const {
-	 	HashSet<K> set;
+	 HashSet<K, A> keySet() const {
+	 	HashSet<K, A> set;
 		AutoPointer<Iterator<MapEntry<K, V>>> iter{this->iterator()};
 		while (!iter->isEnd()) {
 			set.add(iter->current().m_key);
@@ -584,11 +648,30 @@ public:
 private:
 	e_void _init(e_int initCapacity=16) {
 		m_capacity = initCapacity;
-		m_table = new Node*[m_capacity];
+		m_table = _newTable(m_capacity);
 		m_size  = 0;
-		for (e_int i=0; i<m_capacity; i++) {
-			m_table[i] = nullptr;
+		m_oldTable    = nullptr;
+		m_oldCapacity = 0;
+		m_moved       = 0;
+	}
+	
+	static Node** _newTable(e_int capacity) {
+		Node** table = new Node*[capacity];
+		for (e_int i=0; i<capacity; i++) {
+			table[i] = nullptr;
 		}
+		return table;
+	}
+	
+	e_void _steal(HashMap& move) {
+		m_table         = move.m_table;
+		m_capacity      = move.m_capacity;
+		m_size 		 	= move.m_size;
+		m_oldTable      = move.m_oldTable;
+		m_oldCapacity   = move.m_oldCapacity;
+		m_moved         = move.m_moved;
+		m_incremental   = move.m_incremental;
+		move._init();
 	}
 	
 	e_void _copy(const HashMap& copy) {
@@ -599,56 +682,144 @@ private:
 		}
 	}
 	
-	e_void _dispose() {
-		for (e_int i=0; i<m_capacity; i++) {
-			Node* cur = m_table[i];
+	Node* _find(const K& key, e_int hash) const {
+		if (hash < 0) {
+			throw IllegalHashCodeException{__func__, __LINE__, hash};
+		}
+		Node* cur = *_bucket(hash);
+		while (cur) {
+			if (cur->m_hashCode == hash && cur->m_entry.m_key.equals(key)) {
+				return cur;
+			}
+			cur = cur->m_next;
+		}
+		return nullptr;
+	}
+	
+	// Head of the bucket which holds the nodes with hash code hash.
+	inline Node** _bucket(e_int hash) const {
+		if (m_oldTable) {
+			e_int slot = hash % m_oldCapacity;
+			if (slot >= m_moved) {
+				return m_oldTable + slot;
+			}
+		}
+		return m_table + hash % m_capacity;
+	}
+	
+	Node* _append(Node* node) {
+		Node** link = _bucket(node->m_hashCode);
+		while (*link) {
+			link = &(*link)->m_next;
+		}
+		*link = node;
+		m_size++;
+		return node;
+	}
+	
+	e_void _grow() {
+		if (m_oldTable) {
+			_migrate(REHASH_STEP);
+		} else if (m_size > threshold()) {
+			if (m_incremental) {
+				m_oldTable    = m_table;
+				m_oldCapacity = m_capacity;
+				m_moved       = 0;
+				// The new table is not zero-filled, that alone would be a pause proportional to the capacity;
+				// _migrate() initializes both buckets an old bucket splits into.
+				m_table       = new Node*[m_capacity*2];
+				m_capacity    = m_capacity*2;
+				_migrate(REHASH_STEP);
+			} else {
+				_rehash(m_capacity*2);
+			}
+		}
+	}
+	
+	/*
+		Old bucket i only splits into new buckets i and i+m_oldCapacity, and nothing touches
+		them until it is migrated, so they are initialized here and the nodes are relinked
+		in their original order.
+	*/
+	e_void _migrate(e_int buckets) {
+		e_int end = (buckets < m_oldCapacity - m_moved) ? m_moved + buckets : m_oldCapacity;
+		for (; m_moved<end; m_moved++) {
+			Node** low  = m_table + m_moved;
+			Node** high = low + m_oldCapacity;
+			Node* cur   = m_oldTable[m_moved];
+			*low  = nullptr;
+			*high = nullptr;
+			while (cur) {
+				Node* next = cur->m_next;
+				cur->m_next = nullptr;
+				if (cur->m_hashCode % m_capacity == m_moved) {
+					*low = cur;
+					low  = &cur->m_next;
+				} else {
+					*high = cur;
+					high  = &cur->m_next;
+				}
+				cur = next;
+			}
+		}
+		if (m_moved == m_oldCapacity) {
+			delete [] m_oldTable;
+			m_oldTable    = nullptr;
+			m_oldCapacity = 0;
+			m_moved       = 0;
+		}
+	}
+	
+	inline e_void _finishRehash() {
+		if (m_oldTable) {
+			_migrate(m_oldCapacity);
+		}
+	}
+	
+	static e_void _free(Node** table, e_int capacity) {
+		for (e_int i=0; i<capacity; i++) {
+			Node* cur = table[i];
 			while (cur) {
 				Node* old = cur;
 				cur = cur->m_next;
 				delete old;
 			}
 		}
-		
-		delete [] m_table;
+		delete [] table;
 	}
 	
+	e_void _dispose() {
+		_finishRehash(); // new buckets are only initialized by _migrate().
+		_free(m_table, m_capacity);
+	}
+	
+	// Moves every node at once, nodes are relinked rather than copied.
 	e_void _rehash(e_int newCapacity) {
-		e_int oldCapacity = m_capacity;
-		m_capacity = newCapacity;
-		
-		Node** newTable = new Node*[m_capacity];
+		_finishRehash();
+		Node** newTable = _newTable(newCapacity);
 		
 		for (e_int i=0; i<m_capacity; i++) {
-			newTable[i] = nullptr;
-		}
-		
-		for (e_int i=0; i<oldCapacity; i++) {
-			if (m_table[i] != nullptr) {
-				Node* cur = m_table[i];
-				while (cur) {
-					e_int newSlot = cur->m_hashCode % m_capacity;
-					if (newTable[newSlot] == nullptr) {
-						newTable[newSlot] = new Node((MapEntry<K,V>&&)cur->m_entry, cur->m_hashCode);
-					} else {
-						Node* newCur = newTable[newSlot];
-						Node* prev = newCur;
-						while (newCur) {
-							prev = newCur;
-							newCur = newCur->m_next;
-						}
-						prev->m_next = new Node((MapEntry<K,V>&&)cur->m_entry, cur->m_hashCode);
-					}
-					Node* old = cur;
-					cur = cur->m_next;
-					delete old;
+			Node* cur = m_table[i];
+			while (cur) {
+				Node* next = cur->m_next;
+				Node** link = newTable + cur->m_hashCode % newCapacity;
+				while (*link) {
+					link = &(*link)->m_next;
 				}
+				cur->m_next = nullptr;
+				*link = cur;
+				cur = next;
 			}
 		}
 		
 		delete [] m_table;
-		m_table = newTable;
+		m_table    = newTable;
+		m_capacity = newCapacity;
 	}
 }; // HashMap
+
+template<class K, class V, class A> constexpr e_int HashMap<K, V, A>::REHASH_STEP;
+
 } // Easy
 
 #endif // _EASY_HASHMAP_H_
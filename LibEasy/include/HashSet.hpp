@@ -20,6 +20,7 @@
 #include "System.hpp"
 #include "AutoPointer.hpp"
 #include "Container.hpp"
+#include "NodePool.hpp"
 
 //#include "Console.hpp"
 
@@ -29,9 +30,13 @@ namespace Easy {
 	\class HashSet
 	
 	\brief 哈希表实现.
+	
+	查找时先比较保存的哈希值再调用 equals(), InternedString 这类哈希值预先算好的元素不需要比较内容.
+	<br/>
+	A 为节点分配策略, 见 List.
 */
 
-template<class E>
+template<class E, class A = HeapAllocator>
 class HashSet {
 	
 class Node {
@@ -39,6 +44,9 @@ public:
 	E     m_item;
 	Node* m_next;
 	e_int m_hashCode;
+
+	static inline e_void* operator new(size_t size) {return A::allocate(size);}
+	static inline e_void operator delete(e_void* node, size_t size) {A::deallocate(node, size);}
 	
 	Node(const E& item, e_int h) {
 		m_item     = item;
@@ -60,12 +68,23 @@ private:
 	const HashSet* m_set;
 	e_int m_expectSize;
 public:
-	HsIterator(const HashSet* set, Node** table, e_int capacity, e_int length) {
+	HsIterator(const HashSet* set, e_int length) {
 		m_set 	   = set;
-		m_table    = table;
-		m_capacity = capacity;
-		m_index	   = 0;
 		m_expectSize = length;
+		m_segments   = 0;
+		if (set->m_oldTable) {
+			// 尚未迁移的桶仍在旧表中; 已迁移的桶是新表的 [0, m_moved) 和 [m_oldCapacity, m_oldCapacity+m_moved),
+			// 新表的其他桶还没有初始化.
+			_addSegment(set->m_oldTable, set->m_moved, set->m_oldCapacity);
+			_addSegment(set->m_table, 0, set->m_moved);
+			_addSegment(set->m_table, set->m_oldCapacity, set->m_oldCapacity + set->m_moved);
+		} else {
+			_addSegment(set->m_table, 0, set->m_capacity);
+		}
+		m_segment  = 0;
+		m_table    = m_tables[0];
+		m_index    = m_begins[0];
+		m_capacity = m_ends[0];
 		_getCur();
 	}
 	
@@ -97,15 +116,32 @@ private:
 	e_int  m_capacity;
 	e_int  m_index;
 	Node*  m_cur;
+	Node** m_tables[3];
+	e_int  m_begins[3];
+	e_int  m_ends[3];
+	e_int  m_segments;
+	e_int  m_segment;
+	
+	e_void _addSegment(Node** table, e_int begin, e_int end) {
+		m_tables[m_segments] = table;
+		m_begins[m_segments] = begin;
+		m_ends[m_segments]   = end;
+		m_segments++;
+	}
 	
 	e_void _getCur() {
-		for (e_int i=m_index; i<m_capacity; i++) {
-			if (m_table[i] != nullptr) {
-				m_cur = m_table[i];
-				return;
-			} else {
-				m_index++;
+		for (;;) {
+			for (; m_index<m_capacity; m_index++) {
+				if (m_table[m_index] != nullptr) {
+					m_cur = m_table[m_index];
+					return;
+				}
 			}
+			if (++m_segment == m_segments)
+				break;
+			m_table    = m_tables[m_segment];
+			m_index    = m_begins[m_segment];
+			m_capacity = m_ends[m_segment];
 		}
 		m_cur = nullptr;
 	}
@@ -120,10 +156,22 @@ private:
 	Node** m_table;
 	e_int m_capacity;
 	e_int m_size;
+	Node** m_oldTable;	// 渐进式 rehash 时正在迁移的旧表, 否则为 nullptr.
+	e_int m_oldCapacity;
+	e_int m_moved;		// 旧表中 [0, m_moved) 的桶已经迁移.
+	e_bool m_incremental;
 	
 	constexpr e_int threshold() {return (e_int) (m_capacity * 0.75);}
 	
 public:
+	/**
+	 * \brief 渐进式 rehash 时, 每次 add() 及 remove() 迁移的桶数.
+	 * 
+	 * 元素个数超过旧容量的 3/4 时开始扩容, 再次扩容还需要同样多次 add(),
+	 * 所以只要不小于 2, 下次扩容前一定已经迁移完毕.
+	*/
+	static constexpr e_int REHASH_STEP = 8;
+	
 	/**
 	 * \brief 构造函数.
 	 *
@@ -134,6 +182,7 @@ public:
 		if (initCapacity < 16)
 			initCapacity = 16;
 		_init(initCapacity);
+		m_incremental = false;
 	}
 	
 		/**
@@ -150,6 +199,7 @@ public:
 	*/
 	inline HashSet(const HashSet& copy) {
 		_init();
+		m_incremental = copy.m_incremental;
 		_copy(copy);
 	}
 	
@@ -159,16 +209,7 @@ public:
 		@param move
 	*/
 	inline HashSet(HashSet&& move) {
-		m_table         = move.m_table;
-		m_capacity      = move.m_capacity;
-		m_size 		 	= move.m_size;
-		move.m_table 	= new Node*[16];
-		move.m_capacity = 16;
-		move.m_size 	= 0;
-		for (e_int i=0; i<move.m_capacity; i++) {
-			move.m_table[i] = nullptr;
-		}
-		
+		_steal(move);
 	}
 	
 	/**
@@ -179,6 +220,7 @@ public:
 	HashSet& operator=(const HashSet& copy) {
 		_dispose();
 		_init();
+		m_incremental = copy.m_incremental;
 		_copy(copy);
 		return *this;
 	}
@@ -190,15 +232,7 @@ public:
 	*/
 	HashSet& operator=(HashSet&& move) {
 		_dispose();
-		m_table         = move.m_table;
-		m_capacity      = move.m_capacity;
-		m_size 		 	= move.m_size;
-		move.m_table 	= new Node*[16];
-		move.m_capacity = 16;
-		move.m_size 	= 0;
-		for (e_int i=0; i<move.m_capacity; i++) {
-			move.m_table[i] = nullptr;
-		}
+		_steal(move);
 		return *this;
 	}
 	
@@ -210,8 +244,8 @@ public:
 		@param other 一个集合.
 		@return 如果接受者和 other 的元素对应相等, 返回真; 否则, 返回假.
 	*/
-	inline e_bool equals(const HashSet<E>& other) const {
-		return Container::equals<HashSet<E>, HashSet<E>, E>(*this, other);
+	inline e_bool equals(const HashSet<E, A>& other) const {
+		return Container::equals<HashSet<E, A>, HashSet<E, A>, E>(*this, other);
 	}
 
 	/**
@@ -222,8 +256,8 @@ public:
 		@param other 集合对象.
 		@return 如果接受者的元素按顺序大于 other 的元素, 返回 1; 等于返回 0; 小于返回 -1.
 	*/
-	inline e_int compare(const HashSet<E>& other) const {
-		return Container::compare<HashSet<E>, HashSet<E>, E>(*this, other);
+	inline e_int compare(const HashSet<E, A>& other) const {
+		return Container::compare<HashSet<E, A>, HashSet<E, A>, E>(*this, other);
 	}
 
 	/**
@@ -241,7 +275,7 @@ public:
 	 * @return 接受者的字符串表示.
 	*/
 	inline String toString() const {
-		return System::move(Container::toString<HashSet<E>, E>(*this));
+		return System::move(Container::toString<HashSet<E, A>, E>(*this));
 	}
 	
 	/**
@@ -253,31 +287,12 @@ public:
 		@return 被添加的元素.
 	*/
 	E& add(const E& item) {
-		if (m_size > threshold()) {
-			_rehash(m_capacity*2);
-		}
-		
 		e_int hash = item.hashCode();
 		if (hash < 0) {
 			throw IllegalHashCodeException{__func__, __LINE__, hash};
 		}
-		e_int slot = hash % m_capacity;
-		
-		if (m_table[slot] == nullptr) {
-			m_table[slot] = new Node(item, hash);
-			m_size++;
-			return m_table[slot]->m_item;
-		} else {
-			Node* cur = m_table[slot];
-			Node* prev = cur;
-			while (cur) {
-				prev = cur;
-				cur = cur->m_next;
-			}
-			prev->m_next = new Node(item, hash);
-			m_size++;
-			return prev->m_next->m_item;
-		}
+		_grow();
+		return _append(new Node(item, hash))->m_item;
 	}
 	
 	/**
@@ -289,31 +304,12 @@ public:
 		@return 被添加的元素.
 	*/
 	E& add(E&& item) {
-		if (m_size > threshold()) {
-			_rehash(m_capacity*2);
-		}
-
 		e_int hash = item.hashCode();
 		if (hash < 0) {
 			throw IllegalHashCodeException{__func__, __LINE__, hash};
 		}
-		e_int slot = hash % m_capacity;
-		
-		if (m_table[slot] == nullptr) {
-			m_table[slot] = new Node(System::move(item), hash);
-			m_size++;
-			return m_table[slot]->m_item;
-		} else {
-			Node* cur  = m_table[slot];
-			Node* prev = cur;
-			while (cur) {
-				prev = cur;
-				cur  = cur->m_next;
-			}
-			prev->m_next = new Node(System::move(item), hash);
-			m_size++;
-			return prev->m_next->m_item;
-		}
+		_grow();
+		return _append(new Node(System::move(item), hash))->m_item;
 	}
 	
 	/**
@@ -330,30 +326,26 @@ public:
 		if (hash < 0) {
 			throw IllegalHashCodeException{__func__, __LINE__, hash};
 		}
-		e_int slot = hash % m_capacity;
-		Node* cur = m_table[slot];
-		Node* prev = cur;
-		while (cur) {
-			if (cur->m_item.equals(item)) {
+		Node** link = _bucket(hash);
+		while (*link) {
+			if ((*link)->m_hashCode == hash && (*link)->m_item.equals(item)) {
 				break;
 			}
-			prev = cur;
-			cur = cur->m_next;
+			link = &(*link)->m_next;
 		}
 		
+		Node* cur = *link;
 		if (cur == nullptr) {
 			throw  HasNoSuchElementException{__func__, __LINE__, String{L"HashSet"}};
 		}
-		
-		if (cur == m_table[slot]) {
-			m_table[slot] = cur->m_next;
-		} else {
-			prev->m_next = cur->m_next;
-		}
+		*link = cur->m_next;
 		
 		E moveItem = System::move(cur->m_item);
 		delete cur;
 		m_size--;
+		if (m_oldTable) {
+			_migrate(REHASH_STEP);
+		}
 		return System::move(moveItem);
 	}
 
@@ -365,23 +357,38 @@ public:
 	 * @throw 如果接受者空或不包含 item, 抛出 HasNoSuchElementException.
 	*/
 	E& get(const E& item) const {
-		e_int hash = item.hashCode();
-		if (hash < 0) {
-			throw IllegalHashCodeException{__func__, __LINE__, hash};
-		}
-		e_int slot = hash % m_capacity;
-		Node* cur = m_table[slot];
-		while (cur) {
-			if (cur->m_item.equals(item)) {
-				break;
-			}
-			cur = cur->m_next;
-		}
-		if (cur == nullptr) {
+		Node* node = _find(item, item.hashCode());
+		if (node == nullptr) {
 			throw  HasNoSuchElementException{__func__, __LINE__, String{L"HashSet"}};
 		}
-		
-		return cur->m_item;
+		return node->m_item;
+	}
+	
+	/**
+	 * \brief 查找元素, 不包含时不抛出异常.
+	 * 
+	 * 查找经常失败时应使用此方法代替 get(): 失败只是一次探测, 不必构造和捕获异常.
+	 * 
+	 * @param item 与欲获取元素等价的元素.
+	 * @return 指向接受者中与 item 等价的元素的指针, 如果接受者不包含 item, 返回 nullptr.
+	 *         add(), remove() 及 trimCapacity() 之后指针失效; 不能通过指针修改元素的哈希值.
+	 * @throw 如果 item.hashCode() 为负数, 抛出 IllegalHashCodeException.
+	*/
+	inline E* find(const E& item) const {
+		return find(item, item.hashCode());
+	}
+	
+	/**
+	 * \brief 以预先计算的哈希值查找元素, 不包含时不抛出异常.
+	 * 
+	 * @param item 与欲获取元素等价的元素.
+	 * @param hash item.hashCode(), 由调用者计算一次, 可以在多个容器中重复使用.
+	 * @return 指向接受者中与 item 等价的元素的指针, 如果接受者不包含 item, 返回 nullptr.
+	 * @throw 如果 hash 为负数, 抛出 IllegalHashCodeException.
+	*/
+	E* find(const E& item, e_int hash) const {
+		Node* node = _find(item, hash);
+		return node ? &node->m_item : nullptr;
 	}
 	
 	/**
@@ -392,20 +399,20 @@ public:
 		@param item 欲查找的项.
 		@return 如果接受者包含 item, 返回真; 否则, 返回假.
 	*/
-	e_bool contains(const E& item) const {
-		e_int hash = item.hashCode();
-		if (hash < 0) {
-			throw IllegalHashCodeException{__func__, __LINE__, hash};
-		}
-		e_int slot = hash % m_capacity;
-		Node* cur  = m_table[slot];
-		while (cur) {
-			if (cur->m_item.equals(item)) {
-				return true;
-			}
-			cur = cur->m_next;
-		}
-		return false;
+	inline e_bool contains(const E& item) const {
+		return _find(item, item.hashCode()) != nullptr;
+	}
+	
+	/**
+		\brief 以预先计算的哈希值判断接受者是否包含指定元素.
+		
+		@param item 欲查找的项.
+		@param hash item.hashCode(), 由调用者计算一次, 可以在多个容器中重复使用.
+		@return 如果接受者包含 item, 返回真; 否则, 返回假.
+		@throw 如果 hash 为负数, 抛出 IllegalHashCodeException.
+	*/
+	inline e_bool contains(const E& item, e_int hash) const {
+		return _find(item, hash) != nullptr;
 	}
 	
 	/**
@@ -422,6 +429,71 @@ public:
 		return *this;
 	}
 	
+	/**
+		\brief 预留容量.
+		
+		调用 reserve(n) 后, 元素个数增加到 n 之前不会再 rehash. 此函数不会缩减容量, 缩减请用 trimCapacity().
+		
+		@param n 预计的元素个数.
+		@return 接受者.
+		@throw 如果 n 为负数, 抛出 IllegalArgumentException.
+	*/
+	HashSet& reserve(e_int n) {
+		if (n < 0) {
+			throw IllegalArgumentException{__func__, __LINE__};
+		}
+		// add() 在插入前检查 size() > threshold(), n + n/3 + 1 保证第 n 次 add() 不会扩容.
+		e_long need = (e_long)n + n / 3 + 1;
+		if (need > Integer::MAX) {
+			need = Integer::MAX;
+		}
+		if (need > m_capacity) {
+			_rehash((e_int)need);
+		}
+		return *this;
+	}
+	
+	/**
+		\brief 设置 rehash 方式.
+		
+		默认情况下, 元素个数超过 capacity() 的 3/4 时, add() 把表扩大一倍并一次移动全部元素,
+		停顿时间与元素个数成正比.
+		<br/>
+		渐进式 rehash 扩容时只分配新表, 之后每次 add() 及 remove() 迁移旧表的 REHASH_STEP 个桶,
+		查找时根据元素所在的桶查找新表或旧表. 总工作量不变, 但不会有哪一次 add() 承担整个表的迁移.
+		<br/>
+		关闭渐进式 rehash 时, 会先完成正在进行的迁移.
+		
+		@param incremental 为真时使用渐进式 rehash.
+		@return 接受者.
+	*/
+	HashSet& setIncrementalRehash(e_bool incremental) {
+		m_incremental = incremental;
+		if (!incremental) {
+			_finishRehash();
+		}
+		return *this;
+	}
+	
+	/**
+		\brief 是否使用渐进式 rehash.
+		
+		@return 使用渐进式 rehash 时返回真.
+		@see setIncrementalRehash().
+	*/
+	inline e_bool isIncrementalRehash() const {
+		return m_incremental;
+	}
+	
+	/**
+		\brief 是否正在进行渐进式 rehash.
+		
+		@return 如果还有元素在旧表中, 返回真.
+	*/
+	inline e_bool isRehashing() const {
+		return m_oldTable != nullptr;
+	}
+	
 	/**
 	 * \brief 获取元素个数.
 	 * 
@@ -465,17 +537,36 @@ public:
 	 * @return 接受者的迭代器.
 	*/
 	inline Iterator<E>* iterator() const {
-		return new HsIterator{this, m_table, m_capacity, m_size};
+		return new HsIterator{this, m_size};
 	}
 private:
 	e_void _init(e_int initCapacity=16) {
 		m_capacity = initCapacity;
 		m_size = 0;
 		
-		m_table = new Node*[m_capacity];
-		for (e_int i=0; i<m_capacity; i++) {
-			m_table[i] = nullptr;
+		m_table = _newTable(m_capacity);
+		m_oldTable    = nullptr;
+		m_oldCapacity = 0;
+		m_moved       = 0;
+	}
+	
+	static Node** _newTable(e_int capacity) {
+		Node** table = new Node*[capacity];
+		for (e_int i=0; i<capacity; i++) {
+			table[i] = nullptr;
 		}
+		return table;
+	}
+	
+	e_void _steal(HashSet& move) {
+		m_table         = move.m_table;
+		m_capacity      = move.m_capacity;
+		m_size 		 	= move.m_size;
+		m_oldTable      = move.m_oldTable;
+		m_oldCapacity   = move.m_oldCapacity;
+		m_moved         = move.m_moved;
+		m_incremental   = move.m_incremental;
+		move._init();
 	}
 	
 	e_void _copy(const HashSet& copy) {
@@ -486,56 +577,142 @@ private:
 		}
 	}
 	
-	e_void _dispose() {
-		for (e_int i=0; i<m_capacity; i++) {
-			Node* cur = m_table[i];
+	Node* _find(const E& item, e_int hash) const {
+		if (hash < 0) {
+			throw IllegalHashCodeException{__func__, __LINE__, hash};
+		}
+		Node* cur = *_bucket(hash);
+		while (cur) {
+			if (cur->m_hashCode == hash && cur->m_item.equals(item)) {
+				return cur;
+			}
+			cur = cur->m_next;
+		}
+		return nullptr;
+	}
+	
+	// 哈希值为 hash 的元素所在的桶.
+	inline Node** _bucket(e_int hash) const {
+		if (m_oldTable) {
+			e_int slot = hash % m_oldCapacity;
+			if (slot >= m_moved) {
+				return m_oldTable + slot;
+			}
+		}
+		return m_table + hash % m_capacity;
+	}
+	
+	Node* _append(Node* node) {
+		Node** link = _bucket(node->m_hashCode);
+		while (*link) {
+			link = &(*link)->m_next;
+		}
+		*link = node;
+		m_size++;
+		return node;
+	}
+	
+	e_void _grow() {
+		if (m_oldTable) {
+			_migrate(REHASH_STEP);
+		} else if (m_size > threshold()) {
+			if (m_incremental) {
+				m_oldTable    = m_table;
+				m_oldCapacity = m_capacity;
+				m_moved       = 0;
+				// 不清零新表, 否则清零本身就是与容量成正比的停顿; 旧表的桶分到哪两个新桶, _migrate() 就初始化哪两个.
+				m_table       = new Node*[m_capacity*2];
+				m_capacity    = m_capacity*2;
+				_migrate(REHASH_STEP);
+			} else {
+				_rehash(m_capacity*2);
+			}
+		}
+	}
+	
+	/*
+		旧表的第 i 个桶只会分到新表的第 i 和第 i+m_oldCapacity 个桶, 迁移之前不会访问这两个桶,
+		所以在这里初始化它们, 节点按原来的顺序重新链接.
+	*/
+	e_void _migrate(e_int buckets) {
+		e_int end = (buckets < m_oldCapacity - m_moved) ? m_moved + buckets : m_oldCapacity;
+		for (; m_moved<end; m_moved++) {
+			Node** low  = m_table + m_moved;
+			Node** high = low + m_oldCapacity;
+			Node* cur   = m_oldTable[m_moved];
+			*low  = nullptr;
+			*high = nullptr;
+			while (cur) {
+				Node* next = cur->m_next;
+				cur->m_next = nullptr;
+				if (cur->m_hashCode % m_capacity == m_moved) {
+					*low = cur;
+					low  = &cur->m_next;
+				} else {
+					*high = cur;
+					high  = &cur->m_next;
+				}
+				cur = next;
+			}
+		}
+		if (m_moved == m_oldCapacity) {
+			delete [] m_oldTable;
+			m_oldTable    = nullptr;
+			m_oldCapacity = 0;
+			m_moved       = 0;
+		}
+	}
+	
+	inline e_void _finishRehash() {
+		if (m_oldTable) {
+			_migrate(m_oldCapacity);
+		}
+	}
+	
+	static e_void _free(Node** table, e_int capacity) {
+		for (e_int i=0; i<capacity; i++) {
+			Node* cur = table[i];
 			while (cur) {
 				Node* old = cur;
 				cur = cur->m_next;
 				delete old;
 			}
 		}
-		
-		delete [] m_table;
+		delete [] table;
+	}
+	
+	e_void _dispose() {
+		_finishRehash(); // 新表的桶只由 _migrate() 初始化.
+		_free(m_table, m_capacity);
 	}
 	
+	// 一次移动全部节点, 节点只是重新链接, 不复制元素.
 	e_void _rehash(e_int newCapacity) {
-		e_int oldCapacity = m_capacity;
-		m_capacity = newCapacity;
-		
-		Node** newTable = new Node*[m_capacity];
+		_finishRehash();
+		Node** newTable = _newTable(newCapacity);
 		
 		for (e_int i=0; i<m_capacity; i++) {
-			newTable[i] = nullptr;
-		}
-		
-		for (e_int i=0; i<oldCapacity; i++) {
-			if (m_table[i] != nullptr) {
-				Node* cur = m_table[i];
-				while (cur) {
-					e_int newSlot = cur->m_hashCode % m_capacity;
-					if (newTable[newSlot] == nullptr) {
-						newTable[newSlot] = new Node((E&&)cur->m_item, cur->m_hashCode);
-					} else {
-						Node* newCur = newTable[newSlot];
-						Node* prev = newCur;
-						while (newCur) {
-							prev = newCur;
-							newCur = newCur->m_next;
-						}
-						prev->m_next = new Node((E&&)cur->m_item, cur->m_hashCode);
-					}
-					Node* old = cur;
-					cur = cur->m_next;
-					delete old;
+			Node* cur = m_table[i];
+			while (cur) {
+				Node* next = cur->m_next;
+				Node** link = newTable + cur->m_hashCode % newCapacity;
+				while (*link) {
+					link = &(*link)->m_next;
 				}
+				cur->m_next = nullptr;
+				*link = cur;
+				cur = next;
 			}
 		}
 		
 		delete [] m_table;
-		m_table = newTable;
+		m_table    = newTable;
+		m_capacity = newCapacity;
 	}
 }; // HashSet
+
+template<class E, class A> constexpr e_int HashSet<E, A>::REHASH_STEP;
+
 } // Easy
 
 #endif // _EASY_HASHSET_H_
@@ -12,6 +12,7 @@
 #define _EASY_IOUTILITY_H_
 
 #include "String.hpp"
+#include "Utf8String.hpp"
 #include "BasicArray.hpp"
 #include "File.hpp"
 
@@ -58,6 +59,30 @@ public:
 	 * @throw if file close failed, throws FileCloseFailedException.
 	 * */
 	static String read(const File& file);
+
+	/**
+	 * \brief Read text file as UTF-8.
+	 * 
+	 * %File encoding must be UTF-8, the content is not transcoded.
+	 * A leading BOM is skipped, line ends are not translated.
+	 * 
+	 * @param file file path.
+	 * @return content of file.
+	 * @throw if file is empty or the content is not valid UTF-8, throws IllegalArgumentException.
+	 * @throw if file open failed, throws FileOpenFailedException.
+	 * @throw if reach a IO error, throws IOException.
+	 * @throw if file close failed, throws FileCloseFailedException.
+	 * */
+	static Utf8String readUtf8(const String& file);
+
+	/**
+	 * \brief Read text file as UTF-8.
+	 * 
+	 * @param file .
+	 * @return content of file.
+	 * @throw see IOUtility::readUtf8(const String&).
+	 * */
+	static Utf8String readUtf8(const File& file);
 	
 	/**
 	 * \brief Read binary file.
@@ -114,6 +139,22 @@ public:
 	 * @throw if file close failed, throws FileCloseFailedException.
 	 * */
 	static e_void write(const File& file, const String& content);
+
+	/**
+	 * \brief Save UTF-8 string to text file.
+	 * 
+	 * Saved file's encoding is UTF-8 with BOM, the content is not transcoded.
+	 * <br/>
+	 * If file already exists, the content of the file will be erased.
+	 * 
+	 * @param file save path.
+	 * @param content .
+	 * @throw if file is empty, throws IllegalArgumentException.
+	 * @throw if file open failed, throws FileOpenFailedException.
+	 * @throw if reach a IO error, throws IOException.
+	 * @throw if file close failed, throws FileCloseFailedException.
+	 * */
+	static e_void write(const String& file, const Utf8String& content);
 	
 	/**
 	 * \brief Save binary data to file.
@@ -22,6 +22,8 @@
 #include "Math.hpp"
 
 namespace Easy {
+
+class StringBuffer;
 	
 /**
 	\class Integer
@@ -41,6 +43,11 @@ class Integer {
 			\brief Min signed 32-bits integer.
 		*/
 		static const e_int MIN = INT32_MIN;
+		
+		/**
+			\brief Max chars written by writeTo(), a '-' and 32 binary digits.
+		*/
+		static const e_int MAX_CHARS = 33;
 
 		/**
 			\brief Ctor.
@@ -157,6 +164,57 @@ class Integer {
 		*/
 		static String toBinaryString(e_int i);
 		
+		/**
+		 * \brief Write to a caller buffer.
+		 * 
+		 * Same digits as toString(i, radix), but no String is built and no '\\0' is written.
+		 * Decimal digits are written two at a time from a lookup table.
+		 * 
+		 * @param i .
+		 * @param out at least Integer::MAX_CHARS chars.
+		 * @param radix can be 2,8,10 or 16, if not these, use radix 10.
+		 * @return count of chars written.
+		*/
+		static e_int writeTo(e_int i, e_char* out, e_int radix=10);
+		
+		/**
+		 * \brief Write ASCII digits to a caller buffer.
+		 * 
+		 * Same as writeTo(e_int, e_char*, e_int), for UTF-8 or ANSI text.
+		*/
+		static e_int writeTo(e_int i, e_byte* out, e_int radix=10);
+		
+		/**
+		 * \brief Append to a StringBuffer.
+		 * 
+		 * @param sb .
+		 * @param i .
+		 * @param radix can be 2,8,10 or 16, if not these, use radix 10.
+		 * @return sb.
+		*/
+		static StringBuffer& appendTo(StringBuffer& sb, e_int i, e_int radix=10);
+		
+		/**
+		 * \brief Append receiver to a StringBuffer in radix 10.
+		 * 
+		 * @param sb .
+		 * @return sb.
+		*/
+		inline StringBuffer& appendTo(StringBuffer& sb) const {return appendTo(sb, m_value);}
+		
+		/**
+		 * \brief Append an array in radix 10.
+		 * 
+		 * Values are formatted into a stack chunk and the chunk is appended to sb when full,
+		 * so a whole column costs a few StringBuffer::append() calls.
+		 * 
+		 * @param sb .
+		 * @param values .
+		 * @param separator put between two values, can be empty.
+		 * @return sb.
+		*/
+		static StringBuffer& appendTo(StringBuffer& sb, const IntArray& values, const StringView& separator);
+		
 		/**
 			\brief Convert string to e_int.
 			
@@ -207,6 +265,30 @@ class Integer {
 			@throw if s not in between Integer::MAX and  Integer::MIN, throw NumberOverflowException. 
 		*/
 		static e_int parse(const String& chs, e_int radix);
+		
+		/**
+			\brief Parse delimited decimal fields without throwing.
+			
+			chs is split at every delimiter, each field must match [-+]?[0-9]+.
+			Empty fields are errors too, so "1,,2" and "1,2," have 3 fields.
+			Chars are checked 16 at a time with SSE2 and digits are converted 8 at a time.
+			
+			@param chs .
+			@param length length of chs, 0 gives no field.
+			@param delimiter .
+			@param values resized to count of fields, bad fields are 0.
+			@param errors resized to count of fields, -1 for a good field, otherwise position in chs of
+				its first illegal char, the digit that overflows, or its end if it has no digit.
+			@return count of bad fields.
+		*/
+		static e_int parse(const e_char* chs, e_int length, e_char delimiter, IntArray& values, IntArray& errors);
+		
+		/**
+			\brief Parse delimited ASCII decimal fields without throwing.
+			
+			Same as parse(const e_char*, e_int, e_char, IntArray&, IntArray&), for UTF-8 or ANSI text.
+		*/
+		static e_int parse(const e_byte* chs, e_int length, e_byte delimiter, IntArray& values, IntArray& errors);
 	private:
 		e_int m_value;
 };
@@ -229,6 +311,11 @@ class Long {
 			\brief 最小 64 位有符号整数值.
 		*/
 		static const e_long MIN = INT64_MIN;
+		
+		/**
+			\brief writeTo() 最多写入的字符数, 一个 '-' 和 64 个二进制位.
+		*/
+		static const e_int MAX_CHARS = 65;
 
 		/**
 			\brief 构造函数.
@@ -338,6 +425,55 @@ class Long {
 		*/
 		static String toBinaryString(e_long l);
 		
+		/**
+			\brief 写入调用者的缓存.
+			
+			同 Integer::writeTo(), 不产生 String, 不写入 '\\0'.
+			
+			@param l  64 位有符号整数值.
+			@param out 至少 Long::MAX_CHARS 个字符.
+			@param radix 可以为 2, 8, 10 或 16, 其他值按 10 处理.
+			@return 写入的字符数.
+		*/
+		static e_int writeTo(e_long l, e_char* out, e_int radix=10);
+		
+		/**
+			\brief 写入 ASCII 字符.
+			
+			同 Long::writeTo(e_long, e_char*, e_int), 用于 UTF-8 或 ANSI 文本.
+		*/
+		static e_int writeTo(e_long l, e_byte* out, e_int radix=10);
+		
+		/**
+			\brief 追加到字符串缓存.
+			
+			@param sb 字符串缓存.
+			@param l  64 位有符号整数值.
+			@param radix 可以为 2, 8, 10 或 16, 其他值按 10 处理.
+			@return sb.
+		*/
+		static StringBuffer& appendTo(StringBuffer& sb, e_long l, e_int radix=10);
+		
+		/**
+			\brief 以十进制追加接受者.
+			
+			@param sb 字符串缓存.
+			@return sb.
+		*/
+		inline StringBuffer& appendTo(StringBuffer& sb) const {return appendTo(sb, m_value);}
+		
+		/**
+			\brief 以十进制追加数组.
+			
+			同 Integer::appendTo(StringBuffer&, const IntArray&, const StringView&).
+			
+			@param sb 字符串缓存.
+			@param values 数组.
+			@param separator 两个数之间的分隔符, 可以为空.
+			@return sb.
+		*/
+		static StringBuffer& appendTo(StringBuffer& sb, const LongArray& values, const StringView& separator);
+		
 		/**
 			\brief 字符串到 e_long 值.
 			
@@ -352,6 +488,27 @@ class Long {
 		static e_long parseOct(const String& s);
 		static e_long parseBinary(const String& s);
 		static e_long parse(const String& s, e_int radix);
+		
+		/**
+			\brief 批量解析分隔的十进制整数, 不抛出异常.
+			
+			同 Integer::parse(const e_char*, e_int, e_char, IntArray&, IntArray&).
+			
+			@param chs 字符序列.
+			@param length chs 的长度, 为 0 时没有字段.
+			@param delimiter 分隔符.
+			@param values 调整为字段个数, 不合法的字段为 0.
+			@param errors 调整为字段个数, 合法的字段为 -1, 否则为它在 chs 中第一个不合法字符、溢出的数字或结尾的位置.
+			@return 不合法的字段个数.
+		*/
+		static e_int parse(const e_char* chs, e_int length, e_char delimiter, LongArray& values, IntArray& errors);
+		
+		/**
+			\brief 批量解析分隔的 ASCII 十进制整数.
+			
+			同 Long::parse(const e_char*, e_int, e_char, LongArray&, IntArray&), 用于 UTF-8 或 ANSI 文本.
+		*/
+		static e_int parse(const e_byte* chs, e_int length, e_byte delimiter, LongArray& values, IntArray& errors);
 	private:
 		e_long m_value;
 }; // Long
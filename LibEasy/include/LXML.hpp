@@ -18,6 +18,7 @@
 #include "Vector.hpp"
 #include "HashMap.hpp"
 #include "HashSet.hpp"
+#include "StringPool.hpp"
 #include "AutoPointer.hpp"
 #include "SharedPointer.hpp"
 
@@ -149,7 +150,7 @@ public:
 	/**
 		\brief 根据属性获取节点.
 		
-		如果接受者中的有多个包含  name/value 的节点, 只返回第一个.
+		如果接受者中的有多个包含  name/value 的节点, 只返回第一个. 没有 name 属性的节点被跳过.
 		
 		@param name 属性名.
 		@param value 属性值.
@@ -181,12 +182,14 @@ public:
 	\class AttrMap
 	
 	\brief LXML 节点属性.
+	
+	属性名驻留在 StringPool::global() 中, 查找时只比较句柄.
 */
 class AttrMap {
 friend class Node;
 
 private:
-	HashMap<String, String> m_map;
+	HashMap<InternedString, String> m_map;
 	String m_node;
 	
 	/**
@@ -230,6 +233,40 @@ public:
 	*/
 	String& getAttr(const String& name) const;
 	
+	/**
+		\brief 获取属性值.
+		
+		同 AttrMap::getAttr(const String&), 但不需要再查找字符串池,
+		适合在多个节点上反复查找同一个属性.
+		
+		@param name 由 StringPool::global() 驻留的属性名.
+		@return name 的值.
+		@throw 如果 name 为空句柄, 抛出 IllegalArgumentException.
+		@throw 如果接受者不包含属性 name, 抛出 HasNoSuchAttrException.
+	*/
+	String& getAttr(const InternedString& name) const;
+	
+	/**
+		\brief 获取属性值, 不包含时不抛出异常.
+		
+		@param name 属性名.
+		@return 指向 name 的值的指针, 如果接受者不包含属性 name, 返回 nullptr.
+		        addAttr() 及 removeAttr() 之后指针失效.
+		@throw 如果 name 为空串, 抛出 IllegalArgumentException.
+	*/
+	String* tryGetAttr(const String& name) const;
+	
+	/**
+		\brief 获取属性值, 不包含时不抛出异常.
+		
+		同 AttrMap::tryGetAttr(const String&), 但不需要再查找字符串池.
+		
+		@param name 由 StringPool::global() 驻留的属性名.
+		@return 指向 name 的值的指针, 如果接受者不包含属性 name, 返回 nullptr.
+		@throw 如果 name 为空句柄, 抛出 IllegalArgumentException.
+	*/
+	String* tryGetAttr(const InternedString& name) const;
+	
 	/**
 		\brief 获取属性对个数.
 		
@@ -256,6 +293,7 @@ private:
 	NodeList  m_nodes;
 	AttrMap   m_attrs;
 	String    m_tag;
+	InternedString m_tagId;	// m_tag 在 StringPool::global() 中的句柄
 	String    m_content;
 
 public:
@@ -314,6 +352,13 @@ public:
 	*/
 	const String& getTag() const;
 	
+	/**
+		\brief 获取驻留的节点 tag.
+		
+		@return 接受者的 tag 在 StringPool::global() 中的句柄.
+	*/
+	const InternedString& getInternedTag() const;
+	
 	/**
 		\brief 获取节点内容.
 		
@@ -326,6 +371,8 @@ public:
 	/**
 		\brief 保存节点所有信息到文件.
 		
+		文件为带 BOM 的 UTF-8, 行尾为 \r\n.
+		
 		@param  out 保存的文件路径.
 	*/
 	e_void save(const String& out);
@@ -17,6 +17,7 @@
 #include "Iterator.hpp"
 #include "System.hpp"
 #include "AutoPointer.hpp"
+#include "NodePool.hpp"
 
 namespace Easy {
 
@@ -25,11 +26,18 @@ namespace Easy {
  *
  * \brief Double-linked list.
  * 
+ * A is the node allocation policy: HeapAllocator (default), PoolAllocator or
+ * ThreadLocalPoolAllocator. When nodes are added and removed all the time, as
+ * in a Queue, ThreadLocalPoolAllocator is faster than HeapAllocator.
+ * PoolAllocator takes a lock for every node and is no faster than
+ * HeapAllocator; use it only when nodes are added in one thread and removed
+ * in another, see PoolAllocator.
+ * 
  * @author Tes Alone
  * @since 1.0
 */
 
-template<class E>
+template<class E, class A = HeapAllocator>
 class List {
 private:
 class Node {
@@ -37,6 +45,9 @@ class Node {
 		E     m_item;
 		Node* m_next;
 		Node* m_front;
+
+		static inline e_void* operator new(size_t size) {return A::allocate(size);}
+		static inline e_void operator delete(e_void* node, size_t size) {A::deallocate(node, size);}
 		
 		Node(const E& item, Node* front, Node* next) {
 			m_item  = item;
@@ -202,8 +213,8 @@ public:
 	 * @param other the object compared to receiver.
 	 * @return result.
 	 * */
-	inline e_bool equals(const List<E>& other) const {
-		return Container::equals<List<E>, List<E>, E>(*this, other);
+	inline e_bool equals(const List<E, A>& other) const {
+		return Container::equals<List<E, A>, List<E, A>, E>(*this, other);
 	}
 
 	/**
@@ -222,8 +233,8 @@ public:
 	 * @param other the object compared to receiver.
 	 * @return result.
 	 * */
-	inline e_int compare(const List<E>& other) const {
-		return Container::compare<List<E>, List<E>, E>(*this, other);
+	inline e_int compare(const List<E, A>& other) const {
+		return Container::compare<List<E, A>, List<E, A>, E>(*this, other);
 	}
 
 	/**
@@ -242,7 +253,7 @@ public:
 	 * @returns receiver's string represent.
 	*/
 	inline String toString() const {
-		return System::move(Container::toString<List<E>, E>(*this));
+		return System::move(Container::toString<List<E, A>, E>(*this));
 	}
 
 	/**
@@ -732,7 +743,7 @@ private:
 		m_index = -1;
 	}
 	
-	e_void _copy(const List<E>& copy) {
+	e_void _copy(const List<E, A>& copy) {
 		AutoPointer<Iterator<E>> iter{copy.iterator()};
 		while (!iter->isEnd()) {
 			this->add(iter->current());
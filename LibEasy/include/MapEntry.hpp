@@ -12,6 +12,7 @@
 #define _EASY_MAPENTRY_H_
 
 #include "String.hpp"
+#include "TypeTraits.hpp"
 
 namespace Easy {
 
@@ -113,6 +114,14 @@ struct MapEntry {
 		return System::move(m_key.toString() + String{L":"} + m_value.toString());
 	}
 }; // MapEntry
+
+template<class K, class V>
+struct IsTriviallyRelocatable<MapEntry<K, V>> {
+	static constexpr e_bool value = IsTriviallyRelocatable<K>::value && IsTriviallyRelocatable<V>::value;
+};
+
+template<class K, class V>
+constexpr e_bool IsTriviallyRelocatable<MapEntry<K, V>>::value;
 } // Easy
 
 #endif // _EASY_MAPENTRY_H_
@@ -23,6 +23,11 @@
 
 namespace Easy {
 
+template<class E>
+class BasicArray;
+
+typedef BasicArray<e_double> DoubleArray;
+
 /**
 	\class Math
 
@@ -368,9 +373,143 @@ class Math {
 		*/
 		static e_double mod(e_double d, e_double m);
 		
+		/**
+			\brief 批量计算正弦.
+			
+			用 SSE2 每次计算 2 个元素: 先把 pi/4 分四段做区间约简 (Cody-Waite), 约简结果保存为 double-double, 再用 [-pi/4, pi/4] 上的多项式逼近.
+			对 |d| <= Math::BATCH_TRIG_LIMIT, 包括 pi/2 的倍数附近结果接近 0 的自变量, 误差不超过 1 ulp;
+			更大的值、无穷大和 NaN 逐个交给 C 运行库计算.
+			<br/>
+			结果和 Math::sin(e_double) 不完全相同, 后者用泰勒级数, 误差大得多.
+			
+			@param values 自变量, 可以和 results 是同一个数组.
+			@param results 结果, 长度不等于 values 的长度时重新分配.
+		*/
+		static e_void sin(const DoubleArray& values, DoubleArray& results);
+		
+		/**
+			\brief 批量计算余弦.
+			
+			同 Math::sin(const DoubleArray&, DoubleArray&).
+			
+			@param values 自变量, 可以和 results 是同一个数组.
+			@param results 结果, 长度不等于 values 的长度时重新分配.
+		*/
+		static e_void cos(const DoubleArray& values, DoubleArray& results);
+		
+		/**
+			\brief 批量计算 e 的幂.
+			
+			用 SSE2 每次计算 2 个元素: 先约简为 2^k * e^r, |r| <= ln2/2, 再用有理函数逼近 e^r.
+			对 |d| <= 708, 误差不超过 2 ulp; 其他值 (结果溢出或为非规格化数)、无穷大和 NaN 逐个交给 C 运行库计算.
+			
+			@param values 指数, 可以和 results 是同一个数组.
+			@param results 结果, 长度不等于 values 的长度时重新分配.
+		*/
+		static e_void epow(const DoubleArray& values, DoubleArray& results);
+		
+		/**
+			\brief 批量计算自然对数.
+			
+			用 SSE2 每次计算 2 个元素: 先分解为 2^k * m, sqrt(2)/2 <= m < sqrt(2), 再用有理函数逼近 ln(m).
+			对正规格化数, 误差不超过 1 ulp; 0 得到 -Infinity, 负数得到 NaN, 非规格化数、无穷大和 NaN 逐个交给 C 运行库计算.
+			
+			@param values 自变量, 可以和 results 是同一个数组.
+			@param results 结果, 长度不等于 values 的长度时重新分配.
+		*/
+		static e_void ln(const DoubleArray& values, DoubleArray& results);
+		
+		/**
+			\brief 批量计算平方根.
+			
+			结果是正确舍入的, 负数得到 NaN.
+			
+			@param values 自变量, 可以和 results 是同一个数组.
+			@param results 结果, 长度不等于 values 的长度时重新分配.
+		*/
+		static e_void sqrt(const DoubleArray& values, DoubleArray& results);
+		
+		/**
+			\brief 批量计算绝对值.
+			
+			@param values 自变量, 可以和 results 是同一个数组.
+			@param results 结果, 长度不等于 values 的长度时重新分配.
+		*/
+		static e_void abs(const DoubleArray& values, DoubleArray& results);
+		
+		/**
+			\brief 求和.
+			
+			成对求和: 每 128 个元素用 SSE2 的 8 个累加器求和, 块之间两两相加.
+			误差不超过 (log2(n) + 25) * 2^-53 * (|values[0]| + ... + |values[n-1]|), 比逐个累加的 n * 2^-53 小得多,
+			而速度和逐个累加相当.
+			
+			@param values 数组, 可以为空.
+			@return 所有元素的和, 空数组返回 0.0.
+		*/
+		static e_double sum(const DoubleArray& values);
+		
+		/**
+			\brief 点积.
+			
+			成对求和, 误差界同 Math::sum(const DoubleArray&), 其中 |values[i]| 换成 |a[i] * b[i]|.
+			
+			@param a
+			@param b
+			@return a[0]*b[0] + ... + a[n-1]*b[n-1], 空数组返回 0.0.
+			@throw 如果 a 和 b 的长度不同, 抛出 IllegalArgumentException.
+		*/
+		static e_double dot(const DoubleArray& a, const DoubleArray& b);
+		
+		/**
+			\brief 最小值.
+			
+			@param values 数组.
+			@return 最小的元素; 如果有元素为 NaN, 返回 NaN.
+			@throw 如果 values 为空, 抛出 IllegalArgumentException.
+		*/
+		static e_double min(const DoubleArray& values);
+		
+		/**
+			\brief 最大值.
+			
+			@param values 数组.
+			@return 最大的元素; 如果有元素为 NaN, 返回 NaN.
+			@throw 如果 values 为空, 抛出 IllegalArgumentException.
+		*/
+		static e_double max(const DoubleArray& values);
+		
+		/**
+			\brief 平均值.
+			
+			@param values 数组.
+			@return Math::sum(values) / n.
+			@throw 如果 values 为空, 抛出 IllegalArgumentException.
+		*/
+		static e_double mean(const DoubleArray& values);
+		
+		/**
+			\brief 方差.
+			
+			总体方差, 先求平均值, 再成对求和各元素与平均值之差的平方,
+			避免了 E(x^2) - E(x)^2 在平均值远大于标准差时的抵消误差.
+			
+			@param values 数组.
+			@return ((values[0]-mean)^2 + ... + (values[n-1]-mean)^2) / n.
+			@throw 如果 values 为空, 抛出 IllegalArgumentException.
+		*/
+		static e_double variance(const DoubleArray& values);
+		
+		/**
+			\brief 批量三角函数使用多项式逼近的最大自变量.
+		*/
+		static constexpr e_double BATCH_TRIG_LIMIT = 1048576.0;
+		
 		/**
 			\brief 获取下一个随机 e_bool 值.
 			
+			Math 的随机函数都使用当前线程的生成器 Random::current(), 可以在多个线程中同时调用.
+			
 			@return 随机 e_bool 值.
 		*/
 		static e_bool nextBool();
@@ -392,8 +531,8 @@ class Math {
 		/**
 			\brief 获取下一个随机 e_short 值.
 			
-			@param max 随机值的上限, 默认为 Short::MAX
-			@return 小于 max 的随机 e_short 值.
+			@param max 随机值绝对值的上限, 默认为 Short::MAX
+			@return 在 -max ~ max 之间 (不包括两端) 均匀分布的随机 e_short 值.
 			
 			@throw 如果 max <= 0, 抛出 IllegalArgumentException.
 		*/
@@ -403,8 +542,8 @@ class Math {
 		/**
 			\brief 获取下一个随机 e_int 值.
 			
-			@param max 随机值的上限, 默认为 Integer::MAX
-			@return 小于 max 的随机 e_int 值.
+			@param max 随机值绝对值的上限, 默认为 Integer::MAX
+			@return 在 -max ~ max 之间 (不包括两端) 均匀分布的随机 e_int 值.
 			
 			@throw 如果 max <= 0, 抛出 IllegalArgumentException.
 		*/
@@ -413,8 +552,8 @@ class Math {
 		/**
 			\brief 获取下一个随机 e_long 值.
 			
-			@param max 随机值的上限, 默认为 Long::MAX
-			@return 小于 max 的随机 e_long 值.
+			@param max 随机值绝对值的上限, 默认为 Long::MAX
+			@return 在 -max ~ max 之间 (不包括两端) 均匀分布的随机 e_long 值.
 			
 			@throw 如果 max <= 0, 抛出 IllegalArgumentException.
 		*/
@@ -423,14 +562,14 @@ class Math {
 		/**
 			\brief 获取下一个随机 e_float 值.
 			
-			@return 随机 e_float 值, 在 0.0 ~ 1.0 之间.
+			@return 随机 e_float 值, 在 [0.0, 1.0) 之间均匀分布.
 		*/
 		static e_float nextFloat();
 		
 		/**
 			\brief 获取下一个随机 e_double 值.
 			
-			@return 随机 e_double 值, 在 0.0 ~ 1.0 之间.
+			@return 随机 e_double 值, 在 [0.0, 1.0) 之间均匀分布.
 		*/
 		static e_double nextDouble();
 
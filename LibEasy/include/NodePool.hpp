@@ -0,0 +1,260 @@
+/*
+ * 文件名: NodePool.hpp
+ *
+ * 日期/时间:
+ *		开始: 2026年10月18日 16:21:09 周日
+ *		结束:
+ *
+ * 版本: 1.0
+ *
+ * 作者: Tes Alone
+ *
+ * 备注:
+*/
+
+#ifndef _EASY_NODEPOOL_H_
+#define _EASY_NODEPOOL_H_
+
+#include <cstddef>
+#include <new>
+
+#include "BaseTypes.hpp"
+
+namespace Easy {
+
+/**
+	\class NodePoolStats
+
+	\brief 节点池的分配统计.
+
+	@since 1.0
+*/
+struct NodePoolStats {
+	/**
+		\brief allocate() 的次数.
+	*/
+	e_long m_allocations;
+
+	/**
+		\brief deallocate() 的次数. 全局池中, 与 m_allocations 的差是仍在使用的节点数;
+		线程池中, 节点可能由别的线程释放, 差值没有这个含义.
+	*/
+	e_long m_frees;
+
+	/**
+		\brief 从空闲链表取得, 没有切分新内存的分配次数.
+	*/
+	e_long m_reused;
+
+	/**
+		\brief 大于 NodePool::MAX_BLOCK, 直接交给 ::operator new 的分配次数.
+	*/
+	e_long m_oversized;
+
+	/**
+		\brief 向系统申请的内存块数, 每块 NodePool::SLAB_SIZE 字节.
+	*/
+	e_long m_slabs;
+};
+
+/**
+	\class NodePool
+
+	\brief 按尺寸分级的节点内存池.
+
+	尺寸按 GRANULE 字节向上取整, 每一级有自己的空闲链表. 空闲链表为空时, 从该级独占的
+	SLAB_SIZE 字节的内存块中依次切分. 释放的节点放回空闲链表, 内存块直到池销毁才归还系统,
+	所以反复插入删除的容器不再调用系统分配器, 也不会产生碎片.
+	<br/>
+	池本身不加锁. 容器通过 PoolAllocator 或 ThreadLocalPoolAllocator 使用池, 一般不直接使用此类.
+
+	@since 1.0
+*/
+class NodePool {
+public:
+	/**
+		\brief 尺寸级差, 也是节点的对齐.
+	*/
+	static constexpr e_int GRANULE   = 16;
+
+	/**
+		\brief 池管理的最大尺寸, 更大的节点使用 ::operator new.
+	*/
+	static constexpr e_int MAX_BLOCK = 256;
+
+	/**
+		\brief 每次向系统申请的内存大小.
+	*/
+	static constexpr e_int SLAB_SIZE = 64 * 1024;
+
+	NodePool();
+
+	/**
+		\brief 析构函数.
+
+		归还所有内存块, 池中分配的节点随之失效.
+	*/
+	~NodePool();
+
+	/**
+		\brief 分配节点.
+
+		@param size 节点大小.
+		@return 至少 size 字节的内存.
+		@throw 如果内存不足, 抛出 std::bad_alloc.
+	*/
+	inline e_void* allocate(size_t size) {
+		m_stats.m_allocations++;
+		if (size > (size_t)MAX_BLOCK) {
+			m_stats.m_oversized++;
+			return ::operator new(size);
+		}
+		e_int level = _level(size);
+		Block* block = m_free[level];
+		if (block) {
+			m_free[level] = block->m_next;
+			m_stats.m_reused++;
+			return block;
+		}
+		return _carve(level);
+	}
+
+	/**
+		\brief 释放节点.
+
+		@param block allocate() 返回的内存, 可以来自另一个池, 只要那个池的内存块还在.
+		@param size 分配时的大小.
+	*/
+	inline e_void deallocate(e_void* block, size_t size) {
+		m_stats.m_frees++;
+		if (size > (size_t)MAX_BLOCK) {
+			::operator delete(block);
+			return;
+		}
+		e_int level = _level(size);
+		Block* free = static_cast<Block*>(block);
+		free->m_next  = m_free[level];
+		m_free[level] = free;
+	}
+
+	/**
+		\brief 接收另一个池的内存.
+
+		other 的内存块, 空闲节点和统计并入接受者, other 变为空池.
+		other 分配的仍在使用的节点继续有效.
+
+		@param other 另一个池.
+	*/
+	e_void adopt(NodePool& other);
+
+	/**
+		\brief 获取统计.
+
+		@return 接受者的分配统计.
+	*/
+	inline const NodePoolStats& stats() const {
+		return m_stats;
+	}
+
+private:
+	static constexpr e_int LEVELS = MAX_BLOCK / GRANULE;
+
+	struct Block {
+		Block* m_next;
+	};
+
+	Block*  m_free[LEVELS];
+	e_byte* m_cursor[LEVELS];	// 当前内存块中还未切分的部分
+	e_byte* m_limit[LEVELS];
+	e_void* m_slabs;			// 内存块链表, 链接保存在每块的开头
+	NodePoolStats m_stats;
+
+	static inline e_int _level(size_t size) {
+		return size == 0 ? 0 : (e_int)((size - 1) / GRANULE);
+	}
+
+	e_void* _carve(e_int level);
+
+	NodePool(const NodePool& copy) = delete;
+	NodePool& operator=(const NodePool& copy) = delete;
+	NodePool(NodePool&& move) = delete;
+	NodePool& operator=(NodePool&& move) = delete;
+}; // NodePool
+
+/**
+	\class HeapAllocator
+
+	\brief 节点分配策略: 每个节点单独 new 和 delete.
+
+	List, TreeSet, TreeMap, HashSet, HashMap 和 Queue 默认使用此策略.
+
+	@since 1.0
+*/
+class HeapAllocator {
+public:
+	static inline e_void* allocate(size_t size) {
+		return ::operator new(size);
+	}
+
+	static inline e_void deallocate(e_void* block, size_t size) {
+		::operator delete(block);
+	}
+};
+
+/**
+	\class PoolAllocator
+
+	\brief 节点分配策略: 所有线程共用一个加锁的 NodePool.
+
+	每次分配和释放都要取得锁, 并不比 HeapAllocator 快, 不要为了速度使用.
+	只用于节点在一个线程中分配, 在另一个线程中释放的容器, 例如生产者和消费者共用的 Queue:
+	使用 ThreadLocalPoolAllocator 时, 释放的节点堆积在消费者线程的池中, 生产者却一直申请新的内存块.
+	<pre>
+	List<Integer, PoolAllocator> list;
+	</pre>
+
+	@since 1.0
+*/
+class PoolAllocator {
+public:
+	static e_void* allocate(size_t size);
+	static e_void deallocate(e_void* block, size_t size);
+
+	/**
+		\brief 获取统计.
+
+		@return 全局池的分配统计, 包括已经退出的线程并入的线程池.
+	*/
+	static NodePoolStats stats();
+};
+
+/**
+	\class ThreadLocalPoolAllocator
+
+	\brief 节点分配策略: 每个线程使用自己的 NodePool, 不加锁.
+
+	两种池策略中只有它比 HeapAllocator 快, 适合在同一线程中反复插入删除的容器.
+
+	节点放回释放它的线程的池, 所以容器可以交给别的线程使用和销毁;
+	但一个线程持续插入, 另一个线程持续删除时, 应该使用 PoolAllocator.
+	线程退出时, 它的池并入 PoolAllocator 的全局池, 池中分配的节点仍然有效.
+	此后同一线程中的分配和释放, 例如主线程退出时析构的静态容器, 改用全局池.
+
+	@since 1.0
+*/
+class ThreadLocalPoolAllocator {
+public:
+	static e_void* allocate(size_t size);
+	static e_void deallocate(e_void* block, size_t size);
+
+	/**
+		\brief 获取统计.
+
+		@return 当前线程的池的分配统计; 线程的池已并入全局池时, 全部为 0.
+	*/
+	static NodePoolStats stats();
+};
+
+} // Easy
+
+#endif // _EASY_NODEPOOL_H_
@@ -23,11 +23,14 @@ namespace Easy {
  * \brief 队列实现.
  * 
  * 用于值类型.
+ * <br/>
+ * 内部使用 List, A 为节点分配策略, 见 List. 在同一线程中频繁入队离队时, ThreadLocalPoolAllocator
+ * 比默认的 HeapAllocator 快; 入队和离队在不同线程时使用 PoolAllocator, 它不会更快, 只是不会堆积内存.
 */
-template<class E>
+template<class E, class A = HeapAllocator>
 class Queue {
 private:
-	List<E> m_list;
+	List<E, A> m_list;
 public:
 	/**
 	 * \brief 构造函数.
@@ -0,0 +1,189 @@
+/*
+ * 文件名: Searcher.hpp
+ *
+ * 日期/时间:
+ *		开始: 2026年10月17日 09:12:40 周六
+ *		结束:
+ *
+ * 版本: 1.0
+ *
+ * 作者: Tes Alone
+ *
+ * 备注:
+*/
+
+#ifndef _EASY_SEARCHER_H_
+#define _EASY_SEARCHER_H_
+
+#include "BaseTypes.hpp"
+#include "String.hpp"
+
+namespace Easy {
+
+/**
+	\class Searcher
+
+	\brief 子串查找器.
+
+	构造时预先分析子串, 之后可以在不同的字符串中反复查找, 查找过程不分配内存.
+	<br/>
+	较短的子串先用 SSE2 同时比较首尾两个字符筛选候选位置, 再逐字确认;
+	长度不小于 Searcher::TWO_WAY_LIMIT 的子串使用 Two-Way 算法, 最坏情况下也是线性时间.
+	<br/>
+	String::indexOf(), String::lastIndexOf() 和 StringBuffer 的查找都使用这个类.
+
+	@since 1.0
+*/
+class Searcher {
+public:
+	/**
+		\brief 使用 Two-Way 算法的最短子串长度.
+	*/
+	static constexpr e_int TWO_WAY_LIMIT = 32;
+
+	/**
+		\brief 构造函数.
+
+		@param sub 要查找的子串, 可以为空串.
+	*/
+	explicit Searcher(const StringView& sub);
+
+	/**
+		\brief 正序查找.
+
+		如果子串为空串, 返回 offset.
+
+		@param str 被查找的字符串.
+		@param offset 查找起始位置, 默认为 0.
+		@return str 从 offset 开始, 第一个匹配子串的位置; 没有找到或 offset 不在 0 到 str 长度 -1 之间, 返回 -1.
+	*/
+	inline e_int indexOf(const StringView& str, e_int offset=0) const {
+		return indexOf(str.data(), str.length(), offset);
+	}
+
+	/**
+		\brief 正序查找.
+
+		@param chs 被查找的字符序列.
+		@param len chs 的长度.
+		@param offset 查找起始位置.
+		@return 同 Searcher::indexOf(const StringView&, e_int).
+	*/
+	e_int indexOf(const e_char* chs, e_int len, e_int offset=0) const;
+
+	/**
+		\brief 倒序查找.
+
+		只匹配完全位于 offset 之前 (包括 offset) 的子串.
+		如果子串为空串, 返回 offset.
+
+		@param str 被查找的字符串.
+		@param offset 查找起始位置, 默认为 -1, 代表 str 长度 -1.
+		@return offset 之前子串最后一次出现的位置; 没有找到或 offset 不在 0 到 str 长度 -1 之间, 返回 -1.
+	*/
+	inline e_int lastIndexOf(const StringView& str, e_int offset=-1) const {
+		return lastIndexOf(str.data(), str.length(), offset);
+	}
+
+	/**
+		\brief 倒序查找.
+
+		@param chs 被查找的字符序列.
+		@param len chs 的长度.
+		@param offset 查找起始位置, -1 代表 len-1.
+		@return 同 Searcher::lastIndexOf(const StringView&, e_int).
+	*/
+	e_int lastIndexOf(const e_char* chs, e_int len, e_int offset=-1) const;
+
+	/**
+		\brief 获取子串.
+
+		@return 构造时使用的子串.
+	*/
+	inline const String& getSub() const {return m_sub;}
+
+	/**
+		\brief 不预先构造对象的正序查找.
+
+		参数不做检查, 调用者保证 0 <= offset, 且 chs 和 sub 有效.
+
+		@return chs 从 offset 开始第一个匹配 sub 的位置, 没有找到返回 -1.
+	*/
+	static e_int find(const e_char* chs, e_int len, const e_char* sub, e_int subLen, e_int offset);
+
+	/**
+		\brief 不预先构造对象的倒序查找.
+
+		参数不做检查, 调用者保证 offset < len, 且 chs 和 sub 有效.
+
+		@return 结尾不超过 offset 的最后一个 sub 的位置, 没有找到返回 -1.
+	*/
+	static e_int findLast(const e_char* chs, e_int len, const e_char* sub, e_int subLen, e_int offset);
+
+	/**
+		\brief 在字节序列中正序查找.
+
+		同 Searcher::find(const e_char*, e_int, const e_char*, e_int, e_int), 供 Utf8String 使用.
+	*/
+	static e_int find(const e_byte* chs, e_int len, const e_byte* sub, e_int subLen, e_int offset);
+
+	/**
+		\brief 在字节序列中倒序查找.
+
+		同 Searcher::findLast(const e_char*, e_int, const e_char*, e_int, e_int), 供 Utf8String 使用.
+	*/
+	static e_int findLast(const e_byte* chs, e_int len, const e_byte* sub, e_int subLen, e_int offset);
+
+	/**
+		\brief 等于函数.
+
+		@param other 接受者的比较对象.
+		@return 如果两者查找的子串相同, 返回真; 否则, 返回假.
+	*/
+	e_bool equals(const Searcher& other) const {return m_sub.equals(other.m_sub);}
+
+	/**
+		\brief 比较函数.
+
+		按子串比较, 同 String::compare().
+
+		@param other 接受者的比较对象.
+		@return 如果接受者的子串大于 other 的子串, 返回 1; 等于返回 0; 小于返回 -1.
+	*/
+	e_int compare(const Searcher& other) const {return m_sub.compare(other.m_sub);}
+
+	/**
+		\brief 哈希函数.
+
+		@return 子串的哈希值.
+	*/
+	e_int hashCode() const {return m_sub.hashCode();}
+
+	/**
+		\brief 转换为字符串.
+
+		@return "Searcher: " 加上子串.
+	*/
+	String toString() const {return String{L"Searcher: "} + m_sub;}
+
+	/*
+		Two-Way 算法的临界分解: 子串在 split 之后分为左右两部分, period 为移动距离,
+		memory 为周期子串匹配失败后可以跳过的长度 (非周期子串为 0).
+		skip 按窗口尾字符的低 8 位给出可以直接跳过的距离.
+	*/
+	struct Factorization {
+		e_int    split;
+		e_int    period;
+		e_int    memory;
+		e_ushort skip[256];
+	};
+
+private:
+	String m_sub;
+	Factorization m_forward;
+	Factorization m_backward;
+};
+
+} // Easy
+
+#endif // _EASY_SEARCHER_H_
@@ -16,6 +16,7 @@
 #include "String.hpp"
 #include "Math.hpp"
 #include "Integer.hpp"
+#include "TypeTraits.hpp"
 
 namespace Easy {
 
@@ -711,6 +712,23 @@ SharedPointer<T>::SharedPointer(const WeakPointer<T>& weak) {
 	if (m_rc != nullptr) m_rc->incUse();
 }
 
+// 只保存指针, 可以按字节搬移.
+template<class T>
+struct IsTriviallyRelocatable<SharedPointer<T>> {
+	static constexpr e_bool value = true;
+};
+
+template<class T>
+constexpr e_bool IsTriviallyRelocatable<SharedPointer<T>>::value;
+
+template<class T>
+struct IsTriviallyRelocatable<WeakPointer<T>> {
+	static constexpr e_bool value = true;
+};
+
+template<class T>
+constexpr e_bool IsTriviallyRelocatable<WeakPointer<T>>::value;
+
 } // Easy
 
 #endif // _EASY_SHAREDPOINTER_H_
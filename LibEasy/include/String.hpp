@@ -30,10 +30,27 @@ class Bool;
 class Long;
 class Double;
 class Float;
+class StringView;
 
 template<typename>
 class Vector;
 
+template<class S>
+class FormatString;
+
+/**
+	\brief 编译期解析的格式串.
+
+	fmt 必须是 e_char 字符串字面量, 结果可以传给 String::format(), StringBuffer::appendFormat(),
+	Console::printf() 和 Console::printfln(). 格式错误, 或 %%s 的个数与参数个数不一致, 都是编译错误.
+	<br/>
+	如: String::format(EASY_FORMAT(L"%4s-%02s-%02s"), Integer{year}, Integer{month}, Integer{day}).
+*/
+#define EASY_FORMAT(fmt) ([] { \
+		struct _EasyFormat {static constexpr const ::Easy::e_char* value() {return fmt;}}; \
+		return ::Easy::FormatString<_EasyFormat>{}; \
+	}())
+
 /**
 	\class String
 	
@@ -43,6 +60,9 @@ class Vector;
 	
 	这是一个不可变类.
 	
+	长度不超过 String::SSO_CAPACITY 的字符串保存在对象内部; 更长的字符串保存在带引用计数的堆内存中,
+	复制只增加计数, 不复制字符. 计数使用原子操作, 不同线程中的副本可以共享同一块内存.
+	
 	<b>注意: </b>在文档中，如果需要区分 C 风格字符串和 String 类对象, 会称 C 风格字符串为 C 风格字符串.
 	String 类对象为字符串.<br/>
 	如果不需要区分, 统称为 “字符串”.
@@ -52,6 +72,7 @@ class Vector;
 
 class String
 {
+friend class Utf8String;
 
 public:
 	
@@ -61,9 +82,10 @@ public:
 	 * 用于集合类内部建立对象.
 	*/
 	inline String() {
-		m_str    = new e_char[1];
+		m_str    = m_buf;
 		m_length = 0;
-		m_str[m_length] = '\0';
+		m_hash   = -1;
+		m_buf[0] = '\0';
 	}
 		
 	/**
@@ -93,14 +115,23 @@ public:
 	*/
 	String(const e_byte* bytes);
 	
+	/**
+		\brief 复制视图中的字符.
+		
+		@param view 字符串视图.
+	*/
+	explicit String(const StringView& view);
+	
 	/**
 		\brief 析构函数.
 	*/
-	inline ~String() {delete [] m_str;}
+	inline ~String() {if (m_str != m_buf) _release();}
 	
 	/**
 		\brief copy 构造器.
 		
+		长字符串和 copy 共享字符, 不分配内存.
+		
 		@param copy
 	*/
 	String(const String& copy);
@@ -108,6 +139,8 @@ public:
 	/**
 		\brief move 构造器.
 		
+		move 之后 move 为空串, 不分配内存.
+		
 		@param move	
 	*/
 	String(String&& move);
@@ -145,7 +178,9 @@ public:
 	/**
 	 * \brief 哈希函数.
 	 * 
-	 * @return 接受者的哈希值.
+	 * 第一次调用时用 e_hash() 计算, 之后返回保存的值.
+	 * 
+	 * @return 接受者的哈希值, 不小于 0.
 	*/
 	e_int hashCode() const;
 	
@@ -154,7 +189,7 @@ public:
 	 * 
 	 * @returns 接受者的字符串表示.
 	*/
-	inline String toString() const {return System::move(String{m_str});}
+	inline String toString() const {return *this;}
     
     /**
 	 * \brief 连接字符串函数.
@@ -263,6 +298,16 @@ public:
 		return charAt(index);
 	}
 	
+	/**
+		\brief 获取视图.
+		
+		参数的含义和检查同 String::substring(), 但不复制字符.
+		视图在接受者销毁或被赋值之后失效.
+		
+		@return 接受者从 start 到 end-1 的视图.
+	*/
+	StringView view(e_int start=0, e_int end=-1) const;
+	
 	/**
 		\brief 判断接受者是否为空串.
 		
@@ -299,7 +344,7 @@ public:
 		@param chs 用于比较的字符串, 可以为空串.
 		@return 如果 chs 是接受者的后缀, 返回真; 否则, 返回假.
 	*/
-	e_bool endsWith(const String& chs) const ;
+	e_bool endsWith(const StringView& chs) const ;
 	
 	
 	/**
@@ -310,7 +355,7 @@ public:
 		@param chs 用于比较的字符串, 可以为空串.
 		@return 如果 chs 是接受者的前缀, 返回真; 否则, 返回假.
 	*/
-	e_bool startsWith(const String& chs) const ;
+	e_bool startsWith(const StringView& chs) const ;
 
 	/**
 		\brief 转到大写字符串.
@@ -338,7 +383,7 @@ public:
 		
 		@throw 如果 offset < 0 或 offset >= String::length(), 抛出 IndexOutOfBoundsException.
 	*/
-	e_int indexOf(const String& sub, e_int offset=0) const ;
+	e_int indexOf(const StringView& sub, e_int offset=0) const ;
 	
 		/**
 		\brief 倒序查找子串.
@@ -354,12 +399,13 @@ public:
 		
 		@throw 如果 offset 小于 0 或 offset 大于等于 接受者长度, 抛出 IndexOutOfBoundsException.
 	*/
-	e_int lastIndexOf(const String& sub, e_int offset=-1) const ;
+	e_int lastIndexOf(const StringView& sub, e_int offset=-1) const ;
 
 	/**
 		\brief 删除首尾空白符.
 		
 		空白符包括: 空格、水平制表符、换行符、回车符、垂直制表符和进纸符.
+		不需要副本时使用 view().trim().
 		
 		@return 删除首尾空白符的副本.
 	*/
@@ -381,10 +427,7 @@ public:
 		@param chs 可以为空串
 		@return 如果接受者包含 chs, 返回真; 否则, 返回假.
 	*/
-	inline e_bool contains(const String& chs) const {
-		if (chs.empty()) return true;
-		return indexOf(chs)==-1 ? false : true;
-	}
+	e_bool contains(const StringView& chs) const;
 	
 	/**
 		\brief 子串替换.
@@ -410,11 +453,12 @@ public:
 		\brief 分割字符串.
 		
 		如果 sub 为空串, 返回值为只包含接受者的列表.
+		空的部分会被跳过. 不需要副本时使用 view().split(), 逐个得到视图.
 		
 		@param sub 分割用的引子.
 		@return 接受者被 sub 分割的所有部分.
 	*/
-	Vector<String> split(const String& sub) const;
+	Vector<String> split(const StringView& sub) const;
 	
 	/**
 		\brief 计算 C 风格字符串的长度.
@@ -435,19 +479,66 @@ public:
 	 * 
 	 * 如, 在 Date 类的 toString() 方法中, 使用的格式化字符串为: "%4s年%02s月%02s日 %02s:%02s:%02s %s".
 	 * 
-	 * <b>注: 使用的 %%s 和 args 的个数应保持一致, 当然, 如果 %%s 多于 args, 程序不会访问未知内存, 其内部使用的 Vector 会抛出
+	 * <b>注: 使用的 %%s 和 args 的个数应保持一致, 当然, 如果 %%s 多于 args, 程序不会访问未知内存, 而是抛出
 	 * IndexOutOfBoundsException.</b>
 	 * 
+	 * 格式串边写边解析, 参数直接写入结果, String 和 StringView 参数不会被复制.
+	 * 格式串是字面量时, 使用 EASY_FORMAT() 在编译期解析.
+	 * 
 	 * @param str 字符串格式.
-	 * @param args 被格式化参数, 需实现 toString() 方法.
+	 * @param args 被格式化参数, 需实现 toString() 方法, 也可以是 String, StringView 或 C 风格字符串.
 	 * @return 格式化的字符串.
+	 * @throw 如果 str 的格式不正确, 抛出 FormatedStringFormatException.
 	*/
 	template<class ...T>
 	static String format(const String& str, const T&... args);
 
+	/**
+		\brief 格式化字符串.
+
+		同 String::format(const String&, const T&...), 但格式串已经在编译期解析和检查.
+
+		@param str EASY_FORMAT() 产生的格式串.
+		@param args 被格式化参数, 个数必须与 %%s 的个数相同.
+		@return 格式化的字符串.
+	*/
+	template<class S, class ...T>
+	static String format(FormatString<S> str, const T&... args);
+
+	/**
+		\brief 短字符串的最大长度.
+		
+		长度不超过 SSO_CAPACITY 的字符串保存在对象内部, 不使用堆内存.
+		11 个字符足够保存任意 e_int 的字符串表示.
+	*/
+	static constexpr e_int SSO_CAPACITY = 11;
+
 private:
 	e_char* m_str;
 	e_int   m_length;
+	mutable e_int m_hash;	// -1 表示还没有计算, hashCode() 和复制时原子读写
+	e_char  m_buf[SSO_CAPACITY+1];
+
+	/*
+		按 length 准备 m_str: 短字符串使用 m_buf, 否则分配新的共享内存.
+		设置 m_length 和结尾的 '\0', 内容由调用者填写.
+	*/
+	inline e_char* _init(e_int length) {
+		m_length = length;
+		m_hash   = -1;
+		m_str    = (length <= SSO_CAPACITY) ? m_buf : _allocShared(length);
+		m_str[length] = '\0';
+		return m_str;
+	}
+
+	/*
+		共享内存的布局为 [引用计数][字符...'\0'], m_str 指向第一个字符.
+		只有新分配的内存在引用计数为 1 时才会被写入.
+	*/
+	static e_char* _allocShared(e_int length);
+	e_void _share(const String& copy);
+	e_void _release();
+	e_void _steal(String& move);
 
 	e_void _checkStartAndEnd(e_int& start, e_int &end, const String& func, e_int line) const;
 };
@@ -455,4 +546,6 @@ private:
 
 } // namespace Easy
 
+#include "StringView.hpp"
+
 #endif // LEC_STRING_H_
\ No newline at end of file
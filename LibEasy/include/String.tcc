@@ -12,187 +12,228 @@
 #define _EASY_STRINGTCC_H_
 
 #include "String.hpp"
+#include "StringView.hpp"
 #include "StringBuffer.hpp"
-#include "Array.hpp"
-#include "Vector.hpp"
-#include "AutoPointer.hpp"
+#include "Integer.hpp"
+#include "UInteger.hpp"
+#include "Float.hpp"
 
 namespace Easy {
 
-#define CHARS 0
-#define FIELD 1
-#define END   2
+/*
+	格式串的一个片段: 一段字面文本 (包括 %% 产生的 '%'), 或一个 %s 字段.
+*/
+struct FormatSpec {
+	e_int  start;	// 字面文本在格式串中的位置
+	e_int  length;	// 字面文本的长度, 字段为 -1
+	e_int  width;
+	e_bool left;
+	e_bool zero;
+};
 
-class Token {
-public:
-	Token(e_int _type) : type(_type) {}
-	e_int type;
-	e_bool equals(const Token& other) const {return false;}
-	e_int  compare(const Token& other) const {return -1;}
-	e_int  hashCode() const {return 0;}
-	String toString() const {return System::move(String{});}
+template<e_int N>
+struct ParsedFormat {
+	FormatSpec specs[N];
+	e_int      size;
+	e_int      fields;
 };
 
-class Chars : public Token {
+/*
+	格式化参数的字符. String, StringView 和 C 风格字符串直接引用, 不复制;
+	整数, 浮点数和它们的包装类写入 m_buf; 其他类型调用 toString().
+	对象在原处构造, 不能复制, 否则 m_view 会引用已经失效的字符.
+*/
+class FormatArg {
 public:
-	Chars() : Token(CHARS) {chars = String{};}
-	Chars(const Chars& copy) : Token(CHARS) {chars = copy.chars;}
-	String chars;
+	template<class T>
+	inline FormatArg(const T& t) : m_str(t.toString()), m_view(m_str) {}
+	inline FormatArg(const String& str) : m_view(str) {}
+	inline FormatArg(const StringView& view) : m_view(view) {}
+	inline FormatArg(const e_char* str) : m_view(str) {}
+	inline FormatArg(e_int i)   : m_view(m_buf, Integer::writeTo(i, m_buf)) {}
+	inline FormatArg(e_long l)  : m_view(m_buf, Long::writeTo(l, m_buf)) {}
+	inline FormatArg(e_uint i)  : m_view(m_buf, UInteger::writeTo(i, m_buf)) {}
+	inline FormatArg(e_ulong l) : m_view(m_buf, ULong::writeTo(l, m_buf)) {}
+	inline FormatArg(const Integer& i)  : FormatArg(i.getValue()) {}
+	inline FormatArg(const Long& l)     : FormatArg(l.getValue()) {}
+	inline FormatArg(const UInteger& i) : FormatArg(i.getValue()) {}
+	inline FormatArg(const ULong& l)    : FormatArg(l.getValue()) {}
+	inline FormatArg(e_float f)  : m_view(m_buf, Float::writeTo(f, m_buf)) {}
+	inline FormatArg(e_double d) : m_view(m_buf, Double::writeTo(d, m_buf)) {}
+	inline FormatArg(const Float& f)  : FormatArg(f.getValue()) {}
+	inline FormatArg(const Double& d) : FormatArg(d.getValue()) {}
+
+	FormatArg(const FormatArg&) = delete;
+	FormatArg& operator=(const FormatArg&) = delete;
+
+	inline const StringView& view() const {return m_view;}
+
+private:
+	String     m_str;
+	e_char     m_buf[Long::MAX_CHARS];
+	StringView m_view;
 };
 
-class Field : public Token {
+/*
+	String::format() 和 StringBuffer::appendFormat() 的实现.
+	解析函数都是 constexpr 的: FormatString 在编译期解析格式串, 格式错误是编译错误;
+	运行期的格式串边写边解析, 不分配内存.
+*/
+class Formatter {
 public:
-	Field() : Token(FIELD) {
-		left = false;
-		zero = false;
-		sign = -1;
-		length = 0;
+	static constexpr e_int length(const e_char* fmt) {
+		e_int len = 0;
+		while (fmt[len] != '\0') len++;
+		return len;
 	}
-	Field(const Field& copy) : Token(FIELD){
-		left = copy.left;
-		zero = copy.zero;
-		sign = copy.sign;
-		length = copy.length;
+
+	/*
+		从 index 开始解析一个片段, 写入 spec, 返回下一个片段的位置.
+	*/
+	static constexpr e_int parse(const e_char* fmt, e_int len, e_int index, FormatSpec& spec) {
+		spec = FormatSpec{index, 0, 0, false, false};
+
+		if (fmt[index] != '%') {
+			while (index<len && fmt[index]!='%') index++;
+			spec.length = index - spec.start;
+			return index;
+		}
+
+		index++;
+		if (index<len && fmt[index]=='%') {
+			spec.start  = index;
+			spec.length = 1;
+			return index + 1;
+		}
+
+		spec.length = -1;
+		if (index<len && fmt[index]=='-') {
+			spec.left = true; index++;
+		} else if (index<len && fmt[index]=='0') {
+			spec.zero = true; index++;
+		}
+		while (index<len && fmt[index]>='0' && fmt[index]<='9') {
+			if (spec.width==0 && fmt[index]=='0') _error(fmt);
+			spec.width = spec.width * 10 + (fmt[index]-'0');
+			index++;
+		}
+		if (index>=len || fmt[index]!='s') _error(fmt);
+
+		return index + 1;
 	}
-	e_bool left;
-	e_bool zero;
-	e_byte sign;
-	e_int length;
-};
 
-class FormatParser {
-private:
-	const String& m_format;
-	e_int index;
-	e_bool isEnd() {return index>=m_format.length();}
-public:
-	FormatParser(const String& format) : m_format(format), index(0) {}	
-	
-	Vector<AutoPointer<Token>> parse() {
-		Vector<AutoPointer<Token>> tks;
-		Token* tk = nextToken();
-		while (tk->type != END) {
-			tks.add(System::move(AutoPointer<Token>{tk}));
-			tk = nextToken();
+	static constexpr e_int count(const e_char* fmt, e_int len) {
+		FormatSpec spec{0, 0, 0, false, false};
+		e_int size = 0;
+		for (e_int i=0; i<len; size++) i = parse(fmt, len, i, spec);
+		return size;
+	}
+
+	template<e_int N>
+	static constexpr ParsedFormat<N> parseAll(const e_char* fmt, e_int len) {
+		ParsedFormat<N> result{};
+		for (e_int i=0; i<len; result.size++) {
+			i = parse(fmt, len, i, result.specs[result.size]);
+			if (result.specs[result.size].length == -1) result.fields++;
 		}
-		return System::move(tks);
+		return result;
 	}
-private:	
-	Token* nextToken()  {
-		if (!isEnd() && m_format[index]=='%') {
-			return field(index);
-		} else if (!isEnd()) {
-			return chars(index);
+
+	template<class ...T>
+	static inline e_void append(StringBuffer& sb, const e_char* fmt, const FormatSpec& spec, e_int& field, const T&... args) {
+		if (spec.length >= 0) {
+			sb.append(StringView{fmt+spec.start, spec.length});
 		} else {
-			return new Token{END};
+			_field(sb, spec, field, sizeof...(T), args...);
+			field++;
 		}
 	}
 
-	Token* chars(e_int i) {
-		Chars* tk = new Chars;
-		while (!isEnd() && m_format[index]!='%') {
-			index++;
-		}
-		tk->chars = m_format.substring(i, index);
-		return tk;
+private:
+	static e_void _error(const e_char* fmt) {
+		throw FormatedStringFormatException{__func__, __LINE__, String{fmt}};
 	}
 
-	Token* field(e_int i) {
-		Field* tk = new Field;
-		index++;
-		while (!isEnd()) {
-			if (i==index-1 && m_format[index]=='%') {
-				index++; tk->sign = 0; return tk;
-			} else if (i==index-1 && m_format[index]=='-') {
-				tk->left = true; index++;
-			} else if (i==index-1 && m_format[index]=='0') {
-				tk->zero = true; index++;
-			} else if (m_format[index]>='1' && m_format[index]<='9') {
-				e_int length = m_format[index]-'0'; index++;
-				while (!isEnd() && (m_format[index]>='0'&&m_format[index]<='9')) {
-					length = (m_format[index]-'0') + length * 10;
-					index++;
-				}
-				if (isEnd()) throw  FormatedStringFormatException{__func__, __LINE__, m_format};
-				tk->length = length;
-			} else if (m_format[index]=='s') {
-				tk->sign = 1; index++;
-				return tk;
-			} else {
-				throw  FormatedStringFormatException{__func__, __LINE__, m_format};
-			}
-		}
+	static e_void _field(StringBuffer& sb, const FormatSpec& spec, e_int index, e_int count) {
+		throw IndexOutOfBoundsException{__func__, __LINE__, String{L"String::format"}, count, index + count};
+	}
 
-		if (tk->sign == -1) throw  FormatedStringFormatException{__func__, __LINE__, m_format};
-		else {
-			return new Token{END};
+	template<class F, class ...T>
+	static e_void _field(StringBuffer& sb, const FormatSpec& spec, e_int index, e_int count, const F& first, const T&... rest) {
+		if (index == 0) {
+			FormatArg arg{first};
+			_pad(sb, spec, arg.view());
+		} else {
+			_field(sb, spec, index-1, count, rest...);
 		}
 	}
+
+	static inline e_void _pad(StringBuffer& sb, const FormatSpec& spec, const StringView& str) {
+		e_int gap = spec.width - str.length();
+		if (gap > 0 && !spec.left) sb.append(spec.zero ? e_char('0') : e_char(' '), gap);
+		sb.append(str);
+		if (gap > 0 && spec.left) sb.append(e_char(' '), gap);
+	}
 };
 
-template<class T>
-void getArguments(Vector<String>& strs, const T& arg) {
-	strs.add(System::move(arg.toString()));
+/*
+	EASY_FORMAT() 产生的格式串, S::value() 返回字面量.
+	格式串在编译期解析为 FormatString::SPECS, 运行时只需按顺序写入.
+*/
+template<class S>
+class FormatString {
+public:
+	static constexpr const e_char* FORMAT = S::value();
+	static constexpr e_int LENGTH = Formatter::length(FORMAT);
+	static constexpr e_int SIZE   = Formatter::count(FORMAT, LENGTH);
+	static constexpr ParsedFormat<SIZE+1> SPECS = Formatter::parseAll<SIZE+1>(FORMAT, LENGTH);
+};
+
+template<class S> constexpr const e_char* FormatString<S>::FORMAT;
+template<class S> constexpr e_int FormatString<S>::LENGTH;
+template<class S> constexpr e_int FormatString<S>::SIZE;
+template<class S> constexpr ParsedFormat<FormatString<S>::SIZE+1> FormatString<S>::SPECS;
+
+template<class ...T>
+StringBuffer& StringBuffer::appendFormat(const String& fmt, const T&... args) {
+	const e_char* chs = fmt.toCStr();
+	e_int len   = fmt.length();
+	e_int field = 0;
+	FormatSpec spec{0, 0, 0, false, false};
+
+	for (e_int i=0; i<len; ) {
+		i = Formatter::parse(chs, len, i, spec);
+		Formatter::append(*this, chs, spec, field, args...);
+	}
+	return *this;
 }
 
-template<class F, class ...T>
-void getArguments(Vector<String>& strs, const F& first, const T&... rest) {
-	strs.add(System::move(first.toString()));
-	getArguments(strs, rest...);
+template<class S, class ...T>
+StringBuffer& StringBuffer::appendFormat(FormatString<S>, const T&... args) {
+	typedef FormatString<S> F;
+	static_assert(F::SPECS.fields == sizeof...(T), "the number of %s fields must equal the number of arguments");
+
+	e_int field = 0;
+	for (e_int i=0; i<F::SIZE; i++) {
+		Formatter::append(*this, F::FORMAT, F::SPECS.specs[i], field, args...);
+	}
+	return *this;
 }
 
 template<class ...T>
 String String::format(const String& str, const T&... args) {
-	Vector<String> strs;
-	FormatParser parser{(String&)str};
-	Vector<AutoPointer<Token>> formats = System::move(parser.parse());
-	getArguments(strs, args...);
-
-	StringBuffer sb;
-	e_int argIndex = 0;
-	e_int size     = formats.size();
-
-	for (e_int i=0; i<size; i++) {
-		if (formats[i]->type==CHARS) {
-			Chars* tk = (Chars*) formats[i].lock();
-			sb.append(tk->chars);
-		} else if (formats[i]->type==FIELD) {
-			Field* tk = (Field*) formats[i].lock();
-			switch (tk->sign) {
-				case 0:
-					sb.append(String{L"%"});
-				break;
-				case 1:
-				{
-					e_int gap = tk->length - strs[argIndex].length();
-					if (gap>0 && tk->left) {
-						sb.append(strs[argIndex++]);
-						for (e_int i=0; i<gap; i++) {
-							sb.append(String{L" "});
-						}
-					} else if (gap>0 && !tk->left && !tk->zero) {
-						for (e_int i=0; i<gap; i++) {
-							sb.append(String{L" "});
-						}
-						sb.append(strs[argIndex++]);
-					} else if (gap>0 && tk->zero) {
-						for (e_int i=0; i<gap; i++) {
-							sb.append(String{L"0"});
-						}
-						sb.append(strs[argIndex++]);
-					} else if (gap <= 0) {
-						sb.append(strs[argIndex++]);
-					}
-					break;
-				}
-			} 
-		}
-	}
+	StringBuffer sb{str.length() + 16};
+	sb.appendFormat(str, args...);
+	return System::move(sb.toString());
+}
 
+template<class S, class ...T>
+String String::format(FormatString<S> str, const T&... args) {
+	StringBuffer sb{FormatString<S>::LENGTH + 16};
+	sb.appendFormat(str, args...);
 	return System::move(sb.toString());
 }
 
 } // Easy
 
 #endif // _EASY_STRINGTCC_H_
-
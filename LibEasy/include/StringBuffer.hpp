@@ -18,6 +18,7 @@
 
 #include "BaseTypes.hpp"
 #include "String.hpp"
+#include "StringView.hpp"
 #include "System.hpp"
 #include "Integer.hpp"
 #include "Character.hpp"
@@ -178,6 +179,16 @@ public:
 	*/
 	StringBuffer& append(const StringBuffer& buf, e_int start=0, e_int end=-1);
 	
+	/**
+		\brief 追加视图.
+		
+		view 可以为空视图, 但不能引用接受者自己的字符.
+		
+		@param view 要添加的字符串视图.
+		@return 完成添加后的接受者.
+	*/
+	StringBuffer& append(const StringView& view);
+	
 	/**
 	 * \brief 添加字符数组.
 	 * 
@@ -201,6 +212,43 @@ public:
 		return append(System::move(t.toString()));
 	}
 	
+	/**
+		\brief 追加重复的字符.
+		
+		@param ch 要追加的字符.
+		@param count 重复次数, 可以为 0.
+		@return 完成添加后的接受者.
+		@throw 如果 count < 0, 抛出 IllegalArgumentException.
+	*/
+	StringBuffer& append(e_char ch, e_int count);
+	
+	/**
+		\brief 追加格式化字符串.
+		
+		格式同 String::format(), 结果直接写入接受者, 不产生中间的 String.
+		需要包含 String.tcc.
+		
+		@param fmt 字符串格式.
+		@param args 被格式化参数.
+		@return 完成添加后的接受者.
+		@throw 如果 fmt 的格式不正确, 抛出 FormatedStringFormatException.
+		@throw 如果 %%s 多于 args, 抛出 IndexOutOfBoundsException.
+	*/
+	template<class ...T>
+	StringBuffer& appendFormat(const String& fmt, const T&... args);
+	
+	/**
+		\brief 追加格式化字符串.
+		
+		同 StringBuffer::appendFormat(const String&, const T&...), 但 fmt 已经在编译期解析和检查.
+		
+		@param fmt EASY_FORMAT() 产生的格式串.
+		@param args 被格式化参数, 个数必须与 %%s 的个数相同.
+		@return 完成添加后的接受者.
+	*/
+	template<class S, class ...T>
+	StringBuffer& appendFormat(FormatString<S> fmt, const T&... args);
+	
 	/**
 		\brief 缩减缓存区大小至正好容纳现有字符串.
 		
@@ -402,6 +450,16 @@ public:
 		@throw 如果 start > end, 抛出 IllegalArgumentException.	
 	*/
 	String substring(e_int start, e_int end=-1) const;
+	
+	/**
+		\brief 获取视图.
+		
+		参数的含义和检查同 StringBuffer::substring(), 但不复制字符.
+		视图在接受者被修改之后失效.
+		
+		@return 接受者从 start 到 end-1 的视图.
+	*/
+	StringView view(e_int start=0, e_int end=-1) const;
 
 	/**
 		\brief 查找子串.
@@ -415,7 +473,7 @@ public:
 		
 		@throw 如果 offset < 0 或 offset >= StringBuffer::length(), 抛出 IndexOutOfBoundsException.		
 	*/
-	e_int indexOf(const String& str, e_int offset=0) const;
+	e_int indexOf(const StringView& str, e_int offset=0) const;
 	
 	/**
 		\brief 倒序查找子串.
@@ -431,7 +489,7 @@ public:
 		
 		@throw 如果 offset < 0 或 offset >= StringBuffer::length(), 抛出 IndexOutOfBoundsException.
 	*/	
-	e_int lastIndexOf(const String& str, e_int offset=-1) const;
+	e_int lastIndexOf(const StringView& str, e_int offset=-1) const;
 	
 	
 	/**
@@ -442,7 +500,7 @@ public:
 		@param str 欲查找的字符串, 可以为空串.
 		@return 如果接受者包含 str, 返回真; 否则, 返回假.
 	*/	
-	inline e_bool contains(const String& str) const {
+	inline e_bool contains(const StringView& str) const {
 		if (str.empty()) return true;
 		return indexOf(str, 0)==-1 ? false : true;		
 	}
@@ -476,7 +534,7 @@ public:
 		@param chs 用于比较的字符串, 可以为空串.
 		@return 如果 chs 是接受者的后缀, 返回真; 否则, 返回假.
 	*/
-	e_bool endsWith(const String& chs) const ;
+	e_bool endsWith(const StringView& chs) const ;
 	
 	
 	/**
@@ -487,7 +545,7 @@ public:
 		@param chs 用于比较的字符串, 可以为空串.
 		@return 如果 chs 是接受者的前缀, 返回真; 否则, 返回假.
 	*/
-	e_bool startsWith(const String& chs) const ;
+	e_bool startsWith(const StringView& chs) const ;
 private:
 	/*
 		所有的操作必须保证:
@@ -499,6 +557,7 @@ private:
 	e_int   m_length;
 	e_int 	m_capacity;
 	e_void _updateCapa(e_int newCapa);
+	e_void _reserve(e_int resultLen);
 	e_void _append(const e_char* chs, e_int len, e_int start, e_int end);
 	e_void _remove(e_int resultLen, e_int moveLen, e_int start, e_int end);
 	e_void _insert(const e_char* chs, e_int len, e_int offset);
@@ -0,0 +1,240 @@
+/*
+ * 文件名: StringPool.hpp
+ *
+ * 日期/时间:
+ *		开始: 2026年10月17日 16:20:37 周六
+ *		结束:
+ *
+ * 版本: 1.0
+ *
+ * 作者: Tes Alone
+ *
+ * 备注:
+*/
+
+#ifndef _EASY_STRINGPOOL_H_
+#define _EASY_STRINGPOOL_H_
+
+#include <windows.h>
+
+#include "BaseTypes.hpp"
+#include "String.hpp"
+#include "Exception.hpp"
+
+namespace Easy {
+
+/**
+	\class InternedString
+
+	\brief 驻留字符串的句柄.
+
+	由 StringPool::intern() 返回, 同一个字符串池中内容相同的字符串得到同一个句柄.
+	句柄只包含一个指针, 复制不分配内存; 比较只比较指针, 哈希值在驻留时已经算好,
+	适合作为 HashMap 和 HashSet 的键.
+	<br/>
+	默认构造的句柄为空句柄, 不等于任何驻留字符串 (包括空串).
+	<br/>
+	不同字符串池的句柄即使内容相同也不相等.
+
+	@since 1.0
+*/
+class InternedString {
+friend class StringPool;
+
+public:
+	/**
+		\brief 构造空句柄.
+	*/
+	inline InternedString() : m_entry(nullptr) {}
+
+	/**
+		\brief 等于函数.
+
+		@param other 接受者的比较对象.
+		@return 如果两者是同一个驻留字符串, 返回真; 否则, 返回假.
+	*/
+	inline e_bool equals(const InternedString& other) const {
+		return m_entry == other.m_entry;
+	}
+
+	/**
+		\brief 比较函数.
+
+		按内容比较, 空句柄小于任何驻留字符串.
+
+		@param other 接受者的比较对象.
+		@return 如果接受者的值大于 other 的值, 返回 1; 等于返回 0; 小于返回 -1.
+	*/
+	e_int compare(const InternedString& other) const;
+
+	/**
+		\brief 哈希函数.
+
+		@return 驻留时计算的哈希值, 与内容相同的 String 的哈希值相同; 空句柄返回 0.
+	*/
+	inline e_int hashCode() const {
+		return m_entry ? m_entry->m_hash : 0;
+	}
+
+	/**
+		\brief 转换为字符串.
+
+		@return 驻留的字符串; 空句柄返回空串.
+	*/
+	String toString() const;
+
+	/**
+		\brief 获取驻留的字符串.
+
+		@return 驻留的字符串, 在字符串池销毁前一直有效.
+		@throw 如果接受者为空句柄, 抛出 NullPointerException.
+	*/
+	inline const String& get() const {
+		if (m_entry == nullptr)
+			throw NullPointerException{__func__, __LINE__};
+		return m_entry->m_str;
+	}
+
+	/**
+		\brief 判断是否为空句柄.
+
+		@return 如果接受者为空句柄, 返回真; 否则, 返回假.
+	*/
+	inline e_bool isNull() const {return m_entry == nullptr;}
+
+private:
+	struct Entry {
+		String m_str;
+		e_int  m_hash;
+		Entry* m_next;
+	};
+
+	const Entry* m_entry;
+
+	inline explicit InternedString(const Entry* entry) : m_entry(entry) {}
+};
+
+/**
+	\class StringPool
+
+	\brief 字符串池.
+
+	把字符串驻留为 InternedString 句柄, 内容相同的字符串只保存一份.
+	驻留的字符串在字符串池销毁前不会释放, 所以句柄一直有效.
+	<br/>
+	字符串池是线程安全的: 内部按哈希值分为 StringPool::SHARD_COUNT 个分片, 每个分片有自己的读写锁,
+	查找只获取共享锁, 只有第一次驻留一个字符串时才获取独占锁, 不同分片之间互不阻塞.
+	<br/>
+	LXML 的标签名、属性名和 ArgsParser 的选项名使用 StringPool::global().
+
+	@since 1.0
+*/
+class StringPool {
+public:
+	/**
+		\brief 分片个数.
+	*/
+	static constexpr e_int SHARD_COUNT = 16;
+
+	/**
+		\brief 构造空字符串池.
+	*/
+	StringPool();
+
+	/**
+		\brief 析构函数.
+
+		释放所有驻留的字符串, 之后这个字符串池的句柄都不能再使用.
+	*/
+	~StringPool();
+
+	StringPool(const StringPool&) = delete;
+	StringPool& operator=(const StringPool&) = delete;
+
+	/**
+		\brief 驻留字符串.
+
+		@param str 字符串, 可以为空串.
+		@return str 的句柄; 如果 str 已经驻留, 返回已有的句柄.
+	*/
+	InternedString intern(const StringView& str);
+
+	/**
+		\brief 查找驻留的字符串.
+
+		不会驻留 str, 可以用来判断一个字符串是否可能是某个 HashMap 的键.
+
+		@param str 字符串.
+		@return str 的句柄; 如果 str 没有驻留, 返回空句柄.
+	*/
+	InternedString lookup(const StringView& str) const;
+
+	/**
+		\brief 获取驻留的字符串个数.
+
+		@return 驻留的字符串个数.
+	*/
+	e_int size() const;
+
+	/**
+		\brief 获取全局字符串池.
+
+		全局字符串池在程序退出时也不销毁, 保证静态对象中的句柄始终有效.
+
+		@return 全局字符串池.
+	*/
+	static StringPool& global();
+
+	/**
+		\brief 等于函数.
+
+		字符串池不能复制, 只有同一个对象相等.
+
+		@param other 接受者的比较对象.
+		@return 如果两者是同一个字符串池, 返回真; 否则, 返回假.
+	*/
+	inline e_bool equals(const StringPool& other) const {return this == &other;}
+
+	/**
+		\brief 比较函数.
+
+		按地址比较.
+
+		@param other 接受者的比较对象.
+		@return 如果接受者的地址大于 other 的地址, 返回 1; 是同一个对象返回 0; 小于返回 -1.
+	*/
+	inline e_int compare(const StringPool& other) const {return this==&other ? 0 : (this>&other ? 1 : -1);}
+
+	/**
+		\brief 哈希函数.
+
+		@return 由接受者的地址计算的哈希值.
+	*/
+	e_int hashCode() const;
+
+	/**
+		\brief 转换为字符串.
+
+		@return "StringPool: " 加上驻留的字符串个数.
+	*/
+	String toString() const;
+
+private:
+	typedef InternedString::Entry Entry;
+
+	struct Shard {
+		mutable SRWLOCK m_lock;
+		Entry** m_table;
+		e_int   m_capacity;	// 2 的幂
+		e_int   m_size;
+	};
+
+	Shard m_shards[SHARD_COUNT];
+
+	static const Entry* _find(const Shard& shard, const StringView& str, e_int hash);
+	static e_void _rehash(Shard& shard);
+};
+
+} // Easy
+
+#endif // _EASY_STRINGPOOL_H_
@@ -0,0 +1,278 @@
+/*
+ * 文件名: StringView.hpp
+ *
+ * 日期/时间:
+ *		开始: 2026年10月17日 13:20:05 周六
+ *		结束:
+ *
+ * 版本: 1.0
+ *
+ * 作者: Tes Alone
+ *
+ * 备注:
+*/
+
+#ifndef _EASY_STRINGVIEW_H_
+#define _EASY_STRINGVIEW_H_
+
+#include "BaseTypes.hpp"
+#include "String.hpp"
+
+namespace Easy {
+
+/**
+	\class StringView
+
+	\brief 字符串视图.
+
+	只保存字符的指针和长度, 不复制也不拥有字符. 视图在被引用的字符串销毁或修改之后失效,
+	因此通常只作为参数和临时结果使用, 需要保存时用 toString() 复制.
+	<br/>
+	视图不保证以 '\\0' 结尾.
+	<br/>
+	String 和 StringBuffer 的只读查找函数都接受视图; String::view(), StringBuffer::view()
+	以及视图的 substring(), trim(), split() 返回视图, 不分配内存.
+
+	@since 1.0
+*/
+class StringView {
+public:
+	class Splitter;
+
+	/**
+		\brief 构造空视图.
+	*/
+	inline StringView() : m_str(L""), m_length(0) {}
+
+	/**
+		\brief 构造函数.
+
+		@param str 字符序列, 不需要以 '\\0' 结尾.
+		@param length str 的长度.
+		@throw 如果 str 为空指针, 抛出 NullPointerException.
+		@throw 如果 length < 0, 抛出 IllegalArgumentException.
+	*/
+	StringView(const e_char* str, e_int length);
+
+	/**
+		\brief 引用 C 风格字符串.
+
+		@param str C 风格字符串.
+		@throw 如果 str 为空指针, 抛出 NullPointerException.
+	*/
+	StringView(const e_char* str);
+
+	/**
+		\brief 引用字符串.
+
+		@param str 被引用的字符串.
+	*/
+	inline StringView(const String& str) : m_str(str.toCStr()), m_length(str.length()) {}
+
+	/**
+		\brief 等于函数.
+
+		@param other 接受者的比较对象.
+		@return 如果两个视图的字符逐字相等, 返回真; 否则, 返回假.
+	*/
+	e_bool equals(const StringView& other) const;
+
+	/**
+		\brief 比较函数.
+
+		@param other 接受者的比较对象.
+		@return 同 String::compare().
+	*/
+	e_int compare(const StringView& other) const;
+
+	/**
+		\brief 哈希函数.
+
+		结果与内容相同的 String 的 String::hashCode() 相等, 但不缓存.
+
+		@return 接受者的哈希值, 不小于 0.
+	*/
+	e_int hashCode() const;
+
+	/**
+		\brief 复制为字符串.
+
+		@return 与接受者内容相同的新字符串.
+	*/
+	String toString() const;
+
+	/**
+		\brief 获取长度.
+
+		@return 接受者的长度.
+	*/
+	inline e_int length() const {return m_length;}
+
+	/**
+		\brief 判断是否为空.
+
+		@return 长度为 0 返回真; 否则, 返回假.
+	*/
+	inline e_bool empty() const {return m_length == 0;}
+
+	/**
+		\brief 获取字符序列.
+
+		返回值不一定以 '\\0' 结尾.
+
+		@return 接受者引用的第一个字符的地址.
+	*/
+	inline const e_char* data() const {return m_str;}
+
+	/**
+		\brief 获取指定位置的字符.
+
+		@param index 字符所在位置, 范围为 0 到 StringView::length() -1.
+		@return index 位置的字符.
+		@throw 如果 index < 0 或者 index >= StringView::length(), 抛出 IndexOutOfBoundsException.
+	*/
+	e_char charAt(e_int index) const;
+
+	/**
+		\brief 获取指定位置的字符.
+
+		同 StringView::charAt().
+	*/
+	inline e_char operator[](e_int index) const {return charAt(index);}
+
+	/**
+		\brief 获取子视图.
+
+		参数的含义和检查同 String::substring(), 但不复制字符.
+
+		@return 接受者从 start 到 end-1 的视图.
+	*/
+	StringView substring(e_int start=0, e_int end=-1) const;
+
+	/**
+		\brief 删除首尾空白符.
+
+		空白符同 String::trim().
+
+		@return 去掉首尾空白符的视图.
+	*/
+	StringView trim() const;
+
+	/**
+		\brief 查找子串.
+
+		如果 sub 为空串, 返回 offset.
+		如果 offset 不在 0 到 StringView::length() -1 之间, 返回 -1, 不抛出异常.
+
+		@param sub 子串, 可以为空串.
+		@param offset 查找起始位置, 默认为 0.
+		@return 接受者从 offset 开始, 第一个匹配 sub 的位置; 没有找到返回 -1.
+	*/
+	e_int indexOf(const StringView& sub, e_int offset=0) const;
+
+	/**
+		\brief 倒序查找子串.
+
+		如果 sub 为空串, 返回 offset.
+		如果 offset 不在 0 到 StringView::length() -1 之间, 返回 -1, 不抛出异常.
+
+		@param sub 子串, 可以为空串.
+		@param offset 查找起始位置, 默认为 -1, 代表 StringView::length() -1.
+		@return offset 之前 sub 最后一次出现的位置; 没有找到返回 -1.
+	*/
+	e_int lastIndexOf(const StringView& sub, e_int offset=-1) const;
+
+	/**
+		\brief 判断是否包含子串.
+
+		@param sub 可以为空串, 此时返回真.
+		@return 如果接受者包含 sub, 返回真; 否则, 返回假.
+	*/
+	inline e_bool contains(const StringView& sub) const {
+		return sub.empty() || indexOf(sub) != -1;
+	}
+
+	/**
+		\brief 判断前缀.
+
+		@param sub 可以为空串, 此时返回真.
+		@return 如果 sub 是接受者的前缀, 返回真; 否则, 返回假.
+	*/
+	e_bool startsWith(const StringView& sub) const;
+
+	/**
+		\brief 判断后缀.
+
+		@param sub 可以为空串, 此时返回真.
+		@return 如果 sub 是接受者的后缀, 返回真; 否则, 返回假.
+	*/
+	e_bool endsWith(const StringView& sub) const;
+
+	/**
+		\brief 惰性分割.
+
+		每次 Splitter::advance() 才查找下一个分隔符. 分割规则同 String::split():
+		空的部分被跳过; 如果 sep 为空串, 只产生接受者本身.
+
+		@param sep 分隔符, 必须在 Splitter 使用期间有效.
+		@return 指向第一个部分的 Splitter.
+	*/
+	Splitter split(const StringView& sep) const;
+
+private:
+	const e_char* m_str;
+	e_int         m_length;
+};
+
+/**
+	\class StringView::Splitter
+
+	\brief 惰性分割迭代器.
+
+	用法同 Iterator: isEnd() 判断是否结束, current() 获取当前部分, advance() 移动到下一部分.
+	<br/>
+	不继承 Iterator, 可以直接在栈上使用和复制, 不分配内存.
+*/
+class StringView::Splitter {
+public:
+	/**
+		\brief 构造函数.
+
+		@param str 被分割的视图.
+		@param sep 分隔符.
+	*/
+	Splitter(const StringView& str, const StringView& sep);
+
+	/**
+		\brief 判断是否结束.
+
+		@return 结束返回真; 否则返回假.
+	*/
+	inline e_bool isEnd() const {return m_end;}
+
+	/**
+		\brief 获取当前部分.
+
+		@return 当前部分的视图.
+		@throw 如果迭代器已结束, 抛出 IteratorIsEndException.
+	*/
+	const StringView& current() const;
+
+	/**
+		\brief 移动到下一部分.
+
+		@return 如果没有下一部分, 返回假, 否则返回真.
+	*/
+	e_bool advance();
+
+private:
+	StringView m_str;
+	StringView m_sep;
+	StringView m_current;
+	e_int      m_next;
+	e_bool     m_end;
+};
+
+} // Easy
+
+#endif // _EASY_STRINGVIEW_H_
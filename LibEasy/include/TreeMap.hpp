@@ -18,6 +18,7 @@
 #include "Iterator.hpp"
 #include "Container.hpp"
 #include "TreeSet.hpp"
+#include "NodePool.hpp"
 
 #include "Console.hpp"
 
@@ -27,8 +28,10 @@ namespace Easy {
 	\class TreeMap
 	
 	\brief 红黑树 map 实现.
+
+	A 为节点分配策略, 见 List.
 */
-template<class K, class V>
+template<class K, class V, class A = HeapAllocator>
 class TreeMap {
 
 class Node {
@@ -38,6 +41,9 @@ public:
 	Node*  m_right;
 	Node*  m_parent;
 	e_bool m_isRed;
+
+	static inline e_void* operator new(size_t size) {return A::allocate(size);}
+	static inline e_void operator delete(e_void* node, size_t size) {A::deallocate(node, size);}
 	
 	Node(const MapEntry<K, V>& entry, Node* parent, e_bool isRed) {
 		m_entry  = entry;
@@ -190,8 +196,8 @@ public:
 		@param other 一个集合.
 		@return 如果接受者和 other 的元素对应相等, 返回真; 否则, 返回假.
 	*/
-	inline e_bool equals(const TreeMap<K,V>& other) const {
-		return Container::equals<TreeMap<K,V>, TreeMap<K,V>, MapEntry<K,V>>(*this, other);
+	inline e_bool equals(const TreeMap<K, V, A>& other) const {
+		return Container::equals<TreeMap<K, V, A>, TreeMap<K, V, A>, MapEntry<K,V>>(*this, other);
 	}
 
 	/**
@@ -202,8 +208,8 @@ public:
 		@param other 集合对象.
 		@return 如果接受者的元素按顺序大于 other 的元素, 返回 1; 等于返回 0; 小于返回 -1.
 	*/
-	inline e_int compare(const TreeMap<K,V>& other) const {
-		return Container::compare<TreeMap<K,V>, TreeMap<K, V>, MapEntry<K,V>>(*this, other);
+	inline e_int compare(const TreeMap<K, V, A>& other) const {
+		return Container::compare<TreeMap<K, V, A>, TreeMap<K, V, A>, MapEntry<K,V>>(*this, other);
 	}
 
 	/**
@@ -221,7 +227,7 @@ public:
 	 * @return 接受者的字符串表示.
 	*/
 	inline String toString() const {
-		return System::move(Container::toString<TreeMap<K,V>, MapEntry<K,V>>(*this));
+		return System::move(Container::toString<TreeMap<K, V, A>, MapEntry<K,V>>(*this));
 	}
 	
 	/**
@@ -280,7 +286,7 @@ public:
 		@param value 要添加的值.
 		@return 被添加的键.
 	*/
-	e_bool put(const K& key, V&& value)
+	K& put(const K& key, V&& value)
 	{
 		if (m_root == nullptr) {
 			m_root = new Node(System::move(MapEntry<K, V>{key, System::move(value)}), nullptr, false);
@@ -437,6 +443,31 @@ public:
 	V& operator[](const K& key) const {
 		return get(key);
 	}
+	
+	/**
+	 * \brief 根据键获取值, 不包含时不抛出异常.
+	 * 
+	 * 查找经常失败时应使用此方法代替 get().
+	 * 
+	 * @param key 键
+	 * @return 指向 key 对应的值的指针, 如果接受者不包含 key, 返回 nullptr.
+	 *         put() 及 remove() 之后指针可能失效.
+	*/
+	inline V* tryGet(const K& key) const {
+		Node* node = _findHelp(m_root, key);
+		return node ? &node->m_entry.m_value : nullptr;
+	}
+	
+	/**
+	 * \brief 根据键查找键/值, 不包含时不抛出异常.
+	 * 
+	 * @param key 键
+	 * @return 指向接受者中的键/值的指针, 如果接受者不包含 key, 返回 nullptr. 不能通过指针修改键.
+	*/
+	inline MapEntry<K, V>* find(const K& key) const {
+		Node* node = _findHelp(m_root, key);
+		return node ? &node->m_entry : nullptr;
+	}
 
 	/**
 	 * \brief 删除键与值.
@@ -602,8 +633,8 @@ public:
 	 * 
 	 * @return 接受者的所有键.
 	 * */
-	 TreeSet<K> keySet() const {
-	 	TreeSet<K> set;
+	 TreeSet<K, A> keySet() const {
+	 	TreeSet<K, A> set;
 		AutoPointer<Iterator<MapEntry<K, V>>> iter{this->iterator()};
 		while (!iter->isEnd()) {
 			set.add(iter->current().m_key);
@@ -612,6 +643,50 @@ public:
 		return System::move(set);
 	 }
 
+	/**
+	 * \brief 获取键不大于指定键的最大键/值.
+	 * 
+	 * @param key 用于比较的键, 不必在接受者中.
+	 * @return 指向键不大于 key 的最大键/值的指针, 如果不存在, 返回 nullptr. 不能通过指针修改键.
+	*/
+	inline MapEntry<K, V>* floor(const K& key) const {
+		Node* node = _floorNode(key);
+		return node ? &node->m_entry : nullptr;
+	}
+
+	/**
+	 * \brief 获取键不小于指定键的最小键/值.
+	 * 
+	 * @param key 用于比较的键, 不必在接受者中.
+	 * @return 指向键不小于 key 的最小键/值的指针, 如果不存在, 返回 nullptr. 不能通过指针修改键.
+	*/
+	inline MapEntry<K, V>* ceiling(const K& key) const {
+		Node* node = _ceilingNode(key, true);
+		return node ? &node->m_entry : nullptr;
+	}
+
+	/**
+	 * \brief 获取从指定键开始的迭代器.
+	 * 
+	 * 只需一次 O(log n) 的查找, 不必从最小键开始遍历.
+	 * 
+	 * @param key 用于比较的键, 不必在接受者中.
+	 * @return 从键不小于 key 的最小键/值开始的迭代器; 如果不存在这样的键, 迭代器已经结束.
+	*/
+	inline Iterator<MapEntry<K, V>>* lowerBound(const K& key) const {
+		return new TmIterator{this, _ceilingNode(key, true), m_size};
+	}
+
+	/**
+	 * \brief 获取从指定键之后开始的迭代器.
+	 * 
+	 * @param key 用于比较的键, 不必在接受者中.
+	 * @return 从键大于 key 的最小键/值开始的迭代器; 如果不存在这样的键, 迭代器已经结束.
+	*/
+	inline Iterator<MapEntry<K, V>>* upperBound(const K& key) const {
+		return new TmIterator{this, _ceilingNode(key, false), m_size};
+	}
+
 private:
 	e_void _init() {
 		m_root = nullptr;
@@ -626,11 +701,17 @@ private:
 	}
 	
 	e_void _copy(const TreeMap& copy) {
-		AutoPointer<Iterator<MapEntry<K,V>>> iter{copy.iterator()};
-		while (!(*iter).isEnd()) {
-			this->put((*iter).current().m_key, (*iter).current().m_value);
-			(*iter).advance();
-		}
+		m_root = _clone(copy.m_root, nullptr);
+		m_size = copy.m_size;
+	}
+
+	// 按原样复制树的结构和颜色, 不需要比较和旋转.
+	Node* _clone(const Node* root, Node* parent) {
+		if (root == nullptr) return nullptr;
+		Node* node = new Node(root->m_entry, parent, root->m_isRed);
+		node->m_left  = _clone(root->m_left, node);
+		node->m_right = _clone(root->m_right, node);
+		return node;
 	}
 
 	Node* _findHelp(Node* root, const K& key) const {
@@ -655,6 +736,37 @@ private:
 		}
 	}
 
+	// 键不大于 key 的最大节点.
+	Node* _floorNode(const K& key) const {
+		Node* cur   = m_root;
+		Node* found = nullptr;
+		while (cur) {
+			if (cur->m_entry.m_key.compare(key) <= 0) {
+				found = cur;
+				cur = cur->m_right;
+			} else {
+				cur = cur->m_left;
+			}
+		}
+		return found;
+	}
+
+	// 键不小于 key 的最小节点, inclusive 为假时是键大于 key 的最小节点.
+	Node* _ceilingNode(const K& key, e_bool inclusive) const {
+		Node* cur   = m_root;
+		Node* found = nullptr;
+		while (cur) {
+			e_int state = cur->m_entry.m_key.compare(key);
+			if (state > 0 || (inclusive && state == 0)) {
+				found = cur;
+				cur = cur->m_left;
+			} else {
+				cur = cur->m_right;
+			}
+		}
+		return found;
+	}
+
 	Node* _getMin(Node* root) const {
 		Node* cur = root;
 		Node* prev = cur;
@@ -18,6 +18,7 @@
 #include "Math.hpp"
 #include "Container.hpp"
 #include "System.hpp"
+#include "NodePool.hpp"
 
 #include "Console.hpp"
 
@@ -27,9 +28,11 @@ namespace Easy {
  * \class TreeSet
  * 
  * \brief 红黑树实现.
+ * 
+ * A 为节点分配策略, 见 List.
 */
 
-template<class E>
+template<class E, class A = HeapAllocator>
 class TreeSet {
 
 class Node {
@@ -39,6 +42,9 @@ public:
 	Node*  m_left;
 	Node*  m_right;
 	e_bool m_isRed;
+
+	static inline e_void* operator new(size_t size) {return A::allocate(size);}
+	static inline e_void operator delete(e_void* node, size_t size) {A::deallocate(node, size);}
 	
 	Node(const E& item, Node* parent, e_bool isRed) {
 		m_item   = item;
@@ -186,8 +192,8 @@ public:
 		@param other 一个集合.
 		@return 如果接受者和 other 的元素对应相等, 返回真; 否则, 返回假.
 	*/
-	inline e_bool equals(const TreeSet<E>& other) const {
-		return Container::equals<TreeSet<E>, TreeSet<E>, E>(*this, other);
+	inline e_bool equals(const TreeSet<E, A>& other) const {
+		return Container::equals<TreeSet<E, A>, TreeSet<E, A>, E>(*this, other);
 	}
 
 	/**
@@ -198,8 +204,8 @@ public:
 		@param other 集合对象.
 		@return 如果接受者的元素按顺序大于 other 的元素, 返回 1; 等于返回 0; 小于返回 -1.
 	*/
-	inline e_int compare(const TreeSet<E>& other) const {
-		return Container::compare<TreeSet<E>, TreeSet<E>, E>(*this, other);
+	inline e_int compare(const TreeSet<E, A>& other) const {
+		return Container::compare<TreeSet<E, A>, TreeSet<E, A>, E>(*this, other);
 	}
 	
 	/**
@@ -217,7 +223,7 @@ public:
 	 * @return 接受者的字符串表示.
 	*/
 	inline String toString() const {
-		return System::move(Container::toString<TreeSet<E>, E>(*this));
+		return System::move(Container::toString<TreeSet<E, A>, E>(*this));
 	}
 	
 	/**
@@ -481,6 +487,50 @@ public:
 	inline Iterator<E>* iterator() const {
 		return new TsIterator{this, _getMin(m_root), m_size};
 	}
+
+	/**
+	 * \brief 获取不大于指定元素的最大元素.
+	 * 
+	 * @param item 用于比较的元素, 不必在接受者中.
+	 * @return 指向接受者中不大于 item 的最大元素的指针, 如果不存在, 返回 nullptr.
+	*/
+	inline E* floor(const E& item) const {
+		Node* node = _floorNode(item);
+		return node ? &node->m_item : nullptr;
+	}
+
+	/**
+	 * \brief 获取不小于指定元素的最小元素.
+	 * 
+	 * @param item 用于比较的元素, 不必在接受者中.
+	 * @return 指向接受者中不小于 item 的最小元素的指针, 如果不存在, 返回 nullptr.
+	*/
+	inline E* ceiling(const E& item) const {
+		Node* node = _ceilingNode(item, true);
+		return node ? &node->m_item : nullptr;
+	}
+
+	/**
+	 * \brief 获取从指定元素开始的迭代器.
+	 * 
+	 * 只需一次 O(log n) 的查找, 不必从最小元素开始遍历.
+	 * 
+	 * @param item 用于比较的元素, 不必在接受者中.
+	 * @return 从不小于 item 的最小元素开始的迭代器; 如果不存在这样的元素, 迭代器已经结束.
+	*/
+	inline Iterator<E>* lowerBound(const E& item) const {
+		return new TsIterator{this, _ceilingNode(item, true), m_size};
+	}
+
+	/**
+	 * \brief 获取从指定元素之后开始的迭代器.
+	 * 
+	 * @param item 用于比较的元素, 不必在接受者中.
+	 * @return 从大于 item 的最小元素开始的迭代器; 如果不存在这样的元素, 迭代器已经结束.
+	*/
+	inline Iterator<E>* upperBound(const E& item) const {
+		return new TsIterator{this, _ceilingNode(item, false), m_size};
+	}
 private:
 	Node* m_root;
 	e_int m_size;
@@ -498,11 +548,17 @@ private:
 	}
 	
 	e_void _copy(const TreeSet& copy) {
-		AutoPointer<Iterator<E>> iter{copy.iterator()};
-		while (!iter->isEnd()) {
-			this->add(iter->current());
-			iter->advance();
-		}
+		m_root = _clone(copy.m_root, nullptr);
+		m_size = copy.m_size;
+	}
+
+	// 按原样复制树的结构和颜色, 不需要比较和旋转.
+	Node* _clone(const Node* root, Node* parent) {
+		if (root == nullptr) return nullptr;
+		Node* node = new Node(root->m_item, parent, root->m_isRed);
+		node->m_left  = _clone(root->m_left, node);
+		node->m_right = _clone(root->m_right, node);
+		return node;
 	}
 	
 	Node* _findHelp(Node* root, const E& item) const {
@@ -527,6 +583,37 @@ private:
 		}
 	}
 
+	// 不大于 item 的最大节点.
+	Node* _floorNode(const E& item) const {
+		Node* cur   = m_root;
+		Node* found = nullptr;
+		while (cur) {
+			if (cur->m_item.compare(item) <= 0) {
+				found = cur;
+				cur = cur->m_right;
+			} else {
+				cur = cur->m_left;
+			}
+		}
+		return found;
+	}
+
+	// 不小于 item 的最小节点, inclusive 为假时是大于 item 的最小节点.
+	Node* _ceilingNode(const E& item, e_bool inclusive) const {
+		Node* cur   = m_root;
+		Node* found = nullptr;
+		while (cur) {
+			e_int state = cur->m_item.compare(item);
+			if (state > 0 || (inclusive && state == 0)) {
+				found = cur;
+				cur = cur->m_left;
+			} else {
+				cur = cur->m_right;
+			}
+		}
+		return found;
+	}
+
 	Node* _getMin(Node* root) const {
 		Node* cur = root;
 		Node* prev = cur;
@@ -0,0 +1,48 @@
+/*
+ * 文件名: TypeTraits.hpp
+ *
+ * 日期/时间:
+ *		开始: 2026年10月18日 14:06:52 周日
+ *		结束:
+ *
+ * 版本: 1.0
+ *
+ * 作者: Tes Alone
+ *
+ * 备注:
+*/
+
+#ifndef _EASY_TYPETRAITS_H_
+#define _EASY_TYPETRAITS_H_
+
+#include <type_traits>
+
+#include "BaseTypes.hpp"
+
+namespace Easy {
+
+/**
+	\class IsTriviallyRelocatable
+
+	\brief 判断类型能否按字节搬移.
+
+	value 为真时, 把对象的字节复制到新地址, 然后不调用析构函数直接丢弃旧地址,
+	等价于在新地址 move 构造再析构旧对象. Vector 扩容和插入删除时据此用 memcpy/memmove 代替逐个 move.
+	<br/>
+	可平凡复制的类型自动为真. 只保存指向堆的指针, 不保存指向自身的指针, 也不把自身地址登记在别处的类,
+	可以在类的头文件中特化为真, 例如 SharedPointer 和 Array.
+	String 的短字符串指向对象内部, 不能特化.
+
+	@since 1.0
+*/
+template<class T>
+struct IsTriviallyRelocatable {
+	static constexpr e_bool value = std::is_trivially_copyable<T>::value;
+};
+
+template<class T>
+constexpr e_bool IsTriviallyRelocatable<T>::value;
+
+} // Easy
+
+#endif // _EASY_TYPETRAITS_H_
@@ -43,6 +43,11 @@ public:
 		\brief 最大 32 位无符号整数值.
 	*/
 	static const e_uint MAX = UINT32_MAX;
+	
+	/**
+		\brief writeTo() 最多写入的字符数, 即 32 个二进制位.
+	*/
+	static const e_int MAX_CHARS = 32;
 
 	/**
 		\brief 构造函数.
@@ -151,6 +156,43 @@ public:
 		@return num 的2进制字符串表示.
 	*/
 	static String toBinaryString(e_uint i);
+
+	/**
+		\brief 写入调用者的缓存.
+		
+		同 Integer::writeTo(), 不产生 String, 不写入 '\\0'.
+		
+		@param i 无符号 32 位整数值.
+		@param out 至少 UInteger::MAX_CHARS 个字符.
+		@param radix 可以为 2, 8, 10 或 16, 其他值按 10 处理.
+		@return 写入的字符数.
+	*/
+	static e_int writeTo(e_uint i, e_char* out, e_int radix=10);
+	
+	/**
+		\brief 写入 ASCII 字符.
+		
+		同 UInteger::writeTo(e_uint, e_char*, e_int), 用于 UTF-8 或 ANSI 文本.
+	*/
+	static e_int writeTo(e_uint i, e_byte* out, e_int radix=10);
+	
+	/**
+		\brief 追加到字符串缓存.
+		
+		@param sb 字符串缓存.
+		@param i 无符号 32 位整数值.
+		@param radix 可以为 2, 8, 10 或 16, 其他值按 10 处理.
+		@return sb.
+	*/
+	static StringBuffer& appendTo(StringBuffer& sb, e_uint i, e_int radix=10);
+	
+	/**
+		\brief 以十进制追加接受者.
+		
+		@param sb 字符串缓存.
+		@return sb.
+	*/
+	inline StringBuffer& appendTo(StringBuffer& sb) const {return appendTo(sb, m_value);}
 	
 	/**
 		\brief 字符串到 e_uint 值.
@@ -190,6 +232,11 @@ public:
 		\brief 最大 64 位无符号整数值.
 	*/
 	static const e_ulong MAX = UINT64_MAX;
+	
+	/**
+		\brief writeTo() 最多写入的字符数, 即 64 个二进制位.
+	*/
+	static const e_int MAX_CHARS = 64;
 
 	/**
 		\brief 构造函数.
@@ -298,6 +345,43 @@ public:
 		@return l 的2进制字符串表示.
 	*/
 	static String toBinaryString(e_ulong l);
+
+	/**
+		\brief 写入调用者的缓存.
+		
+		同 Integer::writeTo(), 不产生 String, 不写入 '\\0'.
+		
+		@param l 无符号 64 位整数值.
+		@param out 至少 ULong::MAX_CHARS 个字符.
+		@param radix 可以为 2, 8, 10 或 16, 其他值按 10 处理.
+		@return 写入的字符数.
+	*/
+	static e_int writeTo(e_ulong l, e_char* out, e_int radix=10);
+	
+	/**
+		\brief 写入 ASCII 字符.
+		
+		同 ULong::writeTo(e_ulong, e_char*, e_int), 用于 UTF-8 或 ANSI 文本.
+	*/
+	static e_int writeTo(e_ulong l, e_byte* out, e_int radix=10);
+	
+	/**
+		\brief 追加到字符串缓存.
+		
+		@param sb 字符串缓存.
+		@param l 无符号 64 位整数值.
+		@param radix 可以为 2, 8, 10 或 16, 其他值按 10 处理.
+		@return sb.
+	*/
+	static StringBuffer& appendTo(StringBuffer& sb, e_ulong l, e_int radix=10);
+	
+	/**
+		\brief 以十进制追加接受者.
+		
+		@param sb 字符串缓存.
+		@return sb.
+	*/
+	inline StringBuffer& appendTo(StringBuffer& sb) const {return appendTo(sb, m_value);}
 	
 	/**
 		\brief 字符串到 e_ulong 值.
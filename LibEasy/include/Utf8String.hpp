@@ -0,0 +1,399 @@
+/*
+ * 文件名: Utf8String.hpp
+ *
+ * 日期/时间:
+ *		开始: 2026年10月17日 15:06:22 周六
+ *		结束:
+ *
+ * 版本: 1.0
+ *
+ * 作者: Tes Alone
+ *
+ * 备注:
+*/
+
+#ifndef _EASY_UTF8STRING_H_
+#define _EASY_UTF8STRING_H_
+
+#include "BaseTypes.hpp"
+#include "String.hpp"
+
+namespace Easy {
+
+template<class E>
+class Vector;
+
+/**
+	\class Utf8String
+
+	\brief UTF-8 字符串.
+
+	String 的 UTF-8 版本, 每个字符按 UTF-8 编码保存为 1 到 4 个字节, ASCII 文本只占 String 的 1/2 (Windows)
+	或 1/4 (Linux) 内存, 读写 UTF-8 文件时也不需要逐字转换.
+	<br/>
+	这是一个不可变类, 内容总是合法的 UTF-8: 从字节构造时会检查编码, 不合法则抛出异常.
+	<br/>
+	长度、位置都以字节为单位. 接受位置参数的函数要求位置落在字符的边界上, 也就是不能切断一个多字节字符.
+	<br/>
+	与 String 之间的转换由 Utf8String(const String&) 和 Utf8String::toString() 完成, 检查和转换都用 SSE2
+	一次处理 16 个字节的 ASCII 文本, 只有遇到多字节字符才逐字处理.
+	<br/>
+	内存管理同 String: 不超过 Utf8String::SSO_CAPACITY 字节的内容保存在对象内部, 更长的内容保存在带引用计数的堆内存中.
+
+	@since 1.0
+*/
+class Utf8String {
+public:
+	/**
+		\brief 构造空字符串.
+	*/
+	inline Utf8String() {
+		m_str    = m_buf;
+		m_length = 0;
+		m_hash   = -1;
+		m_buf[0] = '\0';
+	}
+
+	/**
+		\brief 根据 UTF-8 编码的 C 风格字符串建立对象.
+
+		@param bytes 以 '\\0' 结尾的 UTF-8 字节序列.
+		@throw 如果 bytes 为空指针, 抛出 NullPointerException.
+		@throw 如果 bytes 不是合法的 UTF-8, 抛出 IllegalArgumentException.
+	*/
+	Utf8String(const e_byte* bytes);
+
+	/**
+		\brief 根据 UTF-8 字节序列建立对象.
+
+		@param bytes UTF-8 字节序列, 不需要以 '\\0' 结尾.
+		@param length bytes 的长度.
+		@throw 如果 bytes 为空指针, 抛出 NullPointerException.
+		@throw 如果 length < 0, 或 bytes 不是合法的 UTF-8, 抛出 IllegalArgumentException.
+	*/
+	Utf8String(const e_byte* bytes, e_int length);
+
+	/**
+		\brief 把字符串编码为 UTF-8.
+
+		不成对的 UTF-16 代理项被编码为 U+FFFD.
+
+		@param str 字符串.
+	*/
+	explicit Utf8String(const StringView& str);
+
+	/**
+		\brief 析构函数.
+	*/
+	inline ~Utf8String() {if (m_str != m_buf) _release();}
+
+	Utf8String(const Utf8String& copy);
+	Utf8String(Utf8String&& move);
+	Utf8String& operator=(const Utf8String& copy);
+	Utf8String& operator=(Utf8String&& move);
+
+	/**
+		\brief 等于函数.
+
+		@param other 接受者的比较对象.
+		@return 如果两者的字节相同, 返回真; 否则, 返回假.
+	*/
+	e_bool equals(const Utf8String& other) const;
+
+	/**
+		\brief 比较函数.
+
+		按字节无符号比较, 结果与按代码点比较相同.
+
+		@param other 接受者的比较对象.
+		@return 如果接受者的值大于 other 的值, 返回 1; 等于返回 0; 小于返回 -1.
+	*/
+	e_int compare(const Utf8String& other) const;
+
+	/**
+		\brief 哈希函数.
+
+		对 UTF-8 字节计算, 与内容相同的 String 的哈希值不同.
+
+		@return 接受者的哈希值, 不小于 0.
+	*/
+	e_int hashCode() const;
+
+	/**
+		\brief 转换为字符串.
+
+		@return 解码后的 String.
+	*/
+	String toString() const;
+
+	/**
+		\brief 连接字符串.
+
+		@param other 连接在接受者之后的字符串.
+		@return 连接后的新字符串.
+	*/
+	inline Utf8String operator+(const Utf8String& other) const {
+		return concat(other);
+	}
+
+	/**
+		\brief 获取 C 风格字符串.
+
+		@return 以 '\\0' 结尾的 UTF-8 字节序列.
+	*/
+	inline const e_byte* toCStr() const {return m_str;}
+
+	/**
+		\brief 获取字节数.
+
+		@return 接受者的字节数.
+	*/
+	inline e_int length() const {return m_length;}
+
+	/**
+		\brief 判断是否为空.
+
+		@return 如果接受者长度为0, 返回真; 否则返回假.
+	*/
+	inline e_bool empty() const {return m_length == 0;}
+
+	/**
+		\brief 计算字符个数.
+
+		@return 接受者包含的 Unicode 代码点个数.
+	*/
+	e_int codePointCount() const;
+
+	/**
+		\brief 获取指定位置的字节.
+
+		@param index 字节所在位置, 范围为 0 到 Utf8String::length() -1.
+		@return index 位置的字节.
+		@throw 如果 index < 0 或者 index >= Utf8String::length(), 抛出 IndexOutOfBoundsException.
+	*/
+	inline e_byte charAt(e_int index) const {
+		if (index<0 || index>=m_length)
+			throw IndexOutOfBoundsException{__func__, __LINE__, String{L"Utf8String"}, m_length, index};
+		return m_str[index];
+	}
+
+	/**
+		\brief 获取指定位置的字节.
+
+		同 Utf8String::charAt().
+	*/
+	inline e_byte operator[](e_int index) const {
+		return charAt(index);
+	}
+
+	/**
+		\brief 获取指定位置的字符.
+
+		@param index 字符第一个字节的位置.
+		@return index 位置的 Unicode 代码点.
+		@throw 如果 index < 0 或者 index >= Utf8String::length(), 抛出 IndexOutOfBoundsException.
+		@throw 如果 index 不是字符的第一个字节, 抛出 IllegalArgumentException.
+	*/
+	e_int codePointAt(e_int index) const;
+
+	/**
+		\brief 获取子串.
+
+		参数的含义和检查同 String::substring(), 另外 start 和 end 必须在字符边界上.
+
+		@return 接受者从 start 到 end-1 的字节组成的字符串.
+		@throw 如果 start 或 end 切断了一个多字节字符, 抛出 IllegalArgumentException.
+	*/
+	Utf8String substring(e_int start=0, e_int end=-1) const;
+
+	/**
+		\brief 判断前缀.
+
+		@param sub 可以为空串, 此时返回真.
+		@return 如果 sub 是接受者的前缀, 返回真; 否则, 返回假.
+	*/
+	e_bool startsWith(const Utf8String& sub) const;
+
+	/**
+		\brief 判断后缀.
+
+		@param sub 可以为空串, 此时返回真.
+		@return 如果 sub 是接受者的后缀, 返回真; 否则, 返回假.
+	*/
+	e_bool endsWith(const Utf8String& sub) const;
+
+	/**
+		\brief 查找子串.
+
+		同 StringView::indexOf(), 位置以字节为单位, 不抛出异常.
+
+		@param sub 子串, 可以为空串.
+		@param offset 查找起始位置, 默认为 0.
+		@return 接受者从 offset 开始, 第一个匹配 sub 的位置; 没有找到返回 -1.
+	*/
+	e_int indexOf(const Utf8String& sub, e_int offset=0) const;
+
+	/**
+		\brief 倒序查找子串.
+
+		同 StringView::lastIndexOf(), 位置以字节为单位, 不抛出异常.
+
+		@param sub 子串, 可以为空串.
+		@param offset 查找起始位置, 默认为 -1, 代表 Utf8String::length() -1.
+		@return offset 之前 sub 最后一次出现的位置; 没有找到返回 -1.
+	*/
+	e_int lastIndexOf(const Utf8String& sub, e_int offset=-1) const;
+
+	/**
+		\brief 判断是否包含子串.
+
+		@param sub 可以为空串, 此时返回真.
+		@return 如果接受者包含 sub, 返回真; 否则, 返回假.
+	*/
+	inline e_bool contains(const Utf8String& sub) const {
+		return sub.empty() || indexOf(sub) != -1;
+	}
+
+	/**
+		\brief 转换为大写.
+
+		只转换 ASCII 字母.
+
+		@return 转换后的新字符串.
+	*/
+	Utf8String toUpperCase() const;
+
+	/**
+		\brief 转换为小写.
+
+		只转换 ASCII 字母.
+
+		@return 转换后的新字符串.
+	*/
+	Utf8String toLowerCase() const;
+
+	/**
+		\brief 删除首尾空白符.
+
+		只删除 ASCII 空白符: ' ', '\\t', '\\n', '\\v', '\\f', '\\r'.
+
+		@return 去掉首尾空白符的新字符串.
+	*/
+	Utf8String trim() const;
+
+	/**
+		\brief 连接字符串.
+
+		@param other 连接在接受者之后的字符串.
+		@return 连接后的新字符串.
+	*/
+	Utf8String concat(const Utf8String& other) const;
+
+	/**
+		\brief 替换子串.
+
+		同 String::replace(), 如果 oldWord 为空串, 或接受者不包括 oldWord, 返回的副本等于接受者.
+
+		@param oldWord 被替换的子串, 可以为空串.
+		@param newWord 替换后的子串, 可以为空串.
+		@return 接受者中所有 oldWord 被替换成 newWord 的新字符串.
+	*/
+	Utf8String replace(const Utf8String& oldWord, const Utf8String& newWord) const;
+
+	/**
+		\brief 分割字符串.
+
+		分割规则同 String::split().
+
+		@param sub 分割用的引子.
+		@return 接受者被 sub 分割的所有部分.
+	*/
+	Vector<Utf8String> split(const Utf8String& sub) const;
+
+	/**
+		\brief 检查 UTF-8 编码.
+
+		拒绝过长编码、代理项、超过 U+10FFFF 的代码点和被截断的字符.
+
+		@param bytes 字节序列.
+		@param length bytes 的长度.
+		@return 第一个不合法字节的位置; 全部合法返回 -1.
+	*/
+	static e_int validate(const e_byte* bytes, e_int length);
+
+	/**
+		\brief 计算解码后的长度.
+
+		@param bytes 合法的 UTF-8 字节序列.
+		@param length bytes 的长度.
+		@return 解码为 e_char 序列后的长度.
+	*/
+	static e_int decodedLength(const e_byte* bytes, e_int length);
+
+	/**
+		\brief 解码 UTF-8.
+
+		不检查编码, 调用者保证 bytes 合法, 并且 out 至少有 Utf8String::decodedLength() 个元素.
+
+		@param bytes 合法的 UTF-8 字节序列.
+		@param length bytes 的长度.
+		@param out 输出的 e_char 序列.
+		@return 写入 out 的 e_char 个数.
+	*/
+	static e_int decode(const e_byte* bytes, e_int length, e_char* out);
+
+	/**
+		\brief 计算编码后的长度.
+
+		@param chs e_char 序列.
+		@param length chs 的长度.
+		@return 编码为 UTF-8 后的字节数.
+	*/
+	static e_int encodedLength(const e_char* chs, e_int length);
+
+	/**
+		\brief 编码为 UTF-8.
+
+		调用者保证 out 至少有 Utf8String::encodedLength() 个字节.
+
+		@param chs e_char 序列.
+		@param length chs 的长度.
+		@param out 输出的字节序列.
+		@return 写入 out 的字节数.
+	*/
+	static e_int encode(const e_char* chs, e_int length, e_byte* out);
+
+	/**
+		\brief 短字符串的最大字节数.
+
+		不超过 SSO_CAPACITY 字节的字符串保存在对象内部, 不使用堆内存.
+	*/
+	static constexpr e_int SSO_CAPACITY = 23;
+
+private:
+	e_byte* m_str;
+	e_int   m_length;
+	mutable e_int m_hash;	// -1 表示还没有计算, hashCode() 和复制时原子读写
+	e_byte  m_buf[SSO_CAPACITY+1];
+
+	// 同 String::_init().
+	inline e_byte* _init(e_int length) {
+		m_length = length;
+		m_hash   = -1;
+		m_str    = (length <= SSO_CAPACITY) ? m_buf : _allocShared(length);
+		m_str[length] = '\0';
+		return m_str;
+	}
+
+	static e_byte* _allocShared(e_int length);
+	e_void _share(const Utf8String& copy);
+	e_void _release();
+	e_void _steal(Utf8String& move);
+
+	e_void _assign(const e_byte* bytes, e_int length);
+	e_bool _isBoundary(e_int index) const;
+};
+
+} // Easy
+
+#endif // _EASY_UTF8STRING_H_
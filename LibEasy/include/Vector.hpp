@@ -13,12 +13,14 @@
 
 #include <cstring>
 #include <cstdlib>
+#include <new>
 
 #include "BaseTypes.hpp"
 #include "Exception.hpp"
 #include "Iterator.hpp"
 #include "Container.hpp"
 #include "System.hpp"
+#include "TypeTraits.hpp"
 
 
 namespace Easy {
@@ -29,6 +31,9 @@ namespace Easy {
  * \brief 动态数组实现.
  * 
  * 用于值类型.
+ * <br/>
+ * 缓冲区是未初始化的内存, 只有前 size() 个位置上有元素, 扩容不会默认构造多余的元素.
+ * IsTriviallyRelocatable 为真的元素在扩容, 插入和删除时整块 memcpy/memmove.
  * 
  * @since 1.0
 */
@@ -82,7 +87,8 @@ private:
 		所有的操作必须保证:
 			m_buffer 最少有 16 个空间,
 			m_capacity 最少为 16,
-			m_length 必须 > 0, 且 < m_capacity.
+			m_length 必须 >= 0, 且 <= m_capacity,
+			m_buffer 中只有前 m_length 个位置上构造了元素.
 	*/
 	E*    m_buffer;
 	e_int m_length; 
@@ -100,14 +106,17 @@ public:
 			initCapa = 16;
 		}
 		m_capacity = initCapa;
-		m_buffer   = new E[m_capacity];
+		m_buffer   = _allocate(m_capacity);
 		m_length   = 0;
 	}
 
 	/**
 	 * \brief 析构函数.
 	*/
-	inline ~Vector() {delete [] m_buffer;}
+	inline ~Vector() {
+		_destroy(m_buffer, m_length);
+		_deallocate(m_buffer);
+	}
 	
 	/**
 	 * \brief copy 构造函数.
@@ -115,10 +124,10 @@ public:
 	 * @param copy
 	*/
 	Vector(const Vector& copy) {
-		m_length   = copy.m_length;
-		m_capacity = (m_length<16) ? 16 : m_length;
-		m_buffer   = new E[m_capacity];
-		_copy(m_buffer, copy.m_buffer);
+		m_capacity = (copy.m_length<16) ? 16 : copy.m_length;
+		m_buffer   = _allocate(m_capacity);
+		m_length   = 0;
+		_copy(copy);
 	}
 
 	/**
@@ -131,7 +140,7 @@ public:
 		m_capacity = move.m_capacity;
 		m_buffer   = move.m_buffer;
 		move.m_capacity = 16;
-		move.m_buffer   = new E[m_capacity];
+		move.m_buffer   = _allocate(move.m_capacity);
 		move.m_length   = 0;
 	}
 
@@ -142,11 +151,17 @@ public:
 	 * @return copy 赋值后的接受者.
 	*/
 	Vector& operator=(const Vector& copy) {
-		delete [] m_buffer;
-		m_length   = copy.m_length;
-		m_capacity = (m_length<16) ? 16 : m_length;
-		m_buffer   = new E[m_capacity];
-		_copy(m_buffer, copy.m_buffer);
+		if (this == &copy) {
+			return *this;
+		}
+		_destroy(m_buffer, m_length);
+		m_length = 0;
+		if (m_capacity < copy.m_length) {
+			_deallocate(m_buffer);
+			m_capacity = copy.m_length;
+			m_buffer   = _allocate(m_capacity);
+		}
+		_copy(copy);
 		return *this;		
 	}
 
@@ -157,12 +172,16 @@ public:
 	 * @return move 赋值后的接受者.
 	*/
 	Vector& operator=(Vector&& move) {
-		delete [] m_buffer;
+		if (this == &move) {
+			return *this;
+		}
+		_destroy(m_buffer, m_length);
+		_deallocate(m_buffer);
 		m_length   = move.m_length;
 		m_capacity = move.m_capacity;
 		m_buffer   = move.m_buffer;
 		move.m_capacity = 16;
-		move.m_buffer   = new E[m_capacity];
+		move.m_buffer   = _allocate(move.m_capacity);
 		move.m_length   = 0;
 		return *this;	
 	}
@@ -217,13 +236,8 @@ public:
 	 * @param item 要添加的元素.
 	 * @return 添加在接受者中的于 item 等价的元素.
 	*/
-	E& add(const E& item) {
-		if (m_length==m_capacity) {
-			_updateCapacity(m_capacity*2);
-		}
-		
-		m_buffer[m_length++] = item;
-		return m_buffer[m_length-1];
+	inline E& add(const E& item) {
+		return emplace(item);
 	}
 
 	/**
@@ -234,13 +248,38 @@ public:
 	 * @param item 要添加的元素.
 	 * @return 添加在接受者中的于 item 等价的元素
 	*/
-	E& add(E&& item) {
-		if (m_length==m_capacity) {
-			_updateCapacity(m_capacity*2);
+	inline E& add(E&& item) {
+		return emplace(System::move(item));
+	}
+
+	/**
+	 * \brief 在结尾构造元素.
+	 * 
+	 * 用 args 直接在缓冲区中构造元素, 不产生临时对象.
+	 * args 可以引用接受者中的元素.
+	 * 
+	 * @param args 元素构造函数的参数.
+	 * @return 构造的元素.
+	*/
+	template<class... Args>
+	E& emplace(Args&&... args) {
+		if (m_length == m_capacity) {
+			// 先在新缓冲区中构造, args 引用的旧元素此时还有效
+			E* newBuffer = _allocate(m_capacity*2);
+			try {
+				new (&newBuffer[m_length]) E(static_cast<Args&&>(args)...);
+			} catch (...) {
+				_deallocate(newBuffer);
+				throw;
+			}
+			_relocate(newBuffer, m_buffer, m_length);
+			_deallocate(m_buffer);
+			m_buffer   = newBuffer;
+			m_capacity = m_capacity*2;
+		} else {
+			new (&m_buffer[m_length]) E(static_cast<Args&&>(args)...);
 		}
-	
-		m_buffer[m_length++] = System::move(item);
-		return m_buffer[m_length-1];
+		return m_buffer[m_length++];
 	}
 
 	/**
@@ -253,28 +292,8 @@ public:
 	 * @return 插入的元素.
 	 * @throw 如果 index<0 或 index>Vector::size(); 抛出 IndexOutOfBoundsException.
 	*/
-	E& insert(const E& item, e_int index) {
-		if (index<0 || index>m_length) {
-			throw  IndexOutOfBoundsException{__func__, __LINE__, String{L"Vector"}, m_length, index};
-		}
-		
-		if (m_length == m_capacity) {
-			E* newBuffer = _createNewBuffer(m_capacity*2);
-			_move(newBuffer, m_buffer, index);
-			newBuffer[index] = item;
-			_move(&newBuffer[index+1], &m_buffer[index], m_length-index);
-			delete [] m_buffer;
-			m_buffer = newBuffer;			
-		} else { 
-			if (index == m_length) {
-				m_buffer[m_length] = item;
-			} else {
-				_moveBack(&m_buffer[index+1], &m_buffer[index], m_length-index);
-				m_buffer[index] = item;	
-			}
-		}
-		m_length++;
-		return m_buffer[index];
+	inline E& insert(const E& item, e_int index) {
+		return emplaceAt(index, item);
 	}
 
 	/**
@@ -287,25 +306,47 @@ public:
 	 * @return 插入的元素.
 	 * @throw 如果 index<0 或 index>Vector::size(); 抛出 IndexOutOfBoundsException.
 	*/
-	E& insert(E&& item, e_int index) {
+	inline E& insert(E&& item, e_int index) {
+		return emplaceAt(index, System::move(item));
+	}
+
+	/**
+	 * \brief 在指定位置构造元素.
+	 * 
+	 * index 及之后的元素后移一位. args 可以引用接受者中的元素.
+	 * 
+	 * @param index 指定的位置.
+	 * @param args 元素构造函数的参数.
+	 * @return 构造的元素.
+	 * @throw 如果 index<0 或 index>Vector::size(); 抛出 IndexOutOfBoundsException.
+	*/
+	template<class... Args>
+	E& emplaceAt(e_int index, Args&&... args) {
 		if (index<0 || index>m_length) {
 			throw  IndexOutOfBoundsException{__func__, __LINE__, String{L"Vector"}, m_length, index};
 		}
+		if (index == m_length) {
+			return emplace(static_cast<Args&&>(args)...);
+		}
 		
+		// 移动元素会改变 args 引用的元素, 所以先构造
+		E item(static_cast<Args&&>(args)...);
 		if (m_length == m_capacity) {
-			E* newBuffer = _createNewBuffer(m_capacity*2);
-			_move(newBuffer, m_buffer, index);
-			newBuffer[index] = System::move(item);
-			_move(&newBuffer[index+1], &m_buffer[index], m_length-index);
-			delete [] m_buffer;
-			m_buffer = newBuffer;			
-		} else { 
-			if (index == m_length) {
-				m_buffer[m_length] = System::move(item);
-			} else {
-				_moveBack(&m_buffer[index+1], &m_buffer[index], m_length-index);
-				m_buffer[index] = System::move(item);	
-			}
+			E* newBuffer = _allocate(m_capacity*2);
+			new (&newBuffer[index]) E(System::move(item));
+			_relocate(newBuffer, m_buffer, index);
+			_relocate(&newBuffer[index+1], &m_buffer[index], m_length-index);
+			_deallocate(m_buffer);
+			m_buffer   = newBuffer;
+			m_capacity = m_capacity*2;
+		} else if (IsTriviallyRelocatable<E>::value) {
+			::memmove(static_cast<e_void*>(&m_buffer[index+1]), static_cast<const e_void*>(&m_buffer[index]), 
+						sizeof(E)*(m_length-index));
+			new (&m_buffer[index]) E(System::move(item));
+		} else {
+			new (&m_buffer[m_length]) E(System::move(m_buffer[m_length-1]));
+			_moveBack(&m_buffer[index+1], &m_buffer[index], m_length-index-1);
+			m_buffer[index] = System::move(item);
 		}
 		m_length++;
 		return m_buffer[index];
@@ -361,12 +402,15 @@ public:
 		if (index<0 || index>=m_length)
 			throw  IndexOutOfBoundsException{__func__, __LINE__, String{L"Vector"}, m_length, index};
 		
-		if (index == m_length-1) {
-			return System::move(m_buffer[--m_length]);
-		}
-
 		E item = System::move(m_buffer[index]);
-		_move(&m_buffer[index], &m_buffer[index+1], m_length-index);
+		if (IsTriviallyRelocatable<E>::value) {
+			m_buffer[index].~E();
+			::memmove(static_cast<e_void*>(&m_buffer[index]), static_cast<const e_void*>(&m_buffer[index+1]), 
+						sizeof(E)*(m_length-index-1));
+		} else {
+			_move(&m_buffer[index], &m_buffer[index+1], m_length-index-1);
+			m_buffer[m_length-1].~E();
+		}
 		m_length--;
 		return System::move(item);
 	}
@@ -550,6 +594,29 @@ public:
 		_updateCapacity((m_length<16)?16:m_length);
 		return *this;
 	}
+
+	/**
+	 * \brief 缩减内存到正好存储元素.
+	 * 
+	 * 同 trimToLength(), 容量不小于 16.
+	*/
+	inline e_void shrinkToFit() {
+		trimToLength();
+	}
+
+	/**
+	 * \brief 预留内存.
+	 * 
+	 * 之后添加元素直到 size() 达到 capacity, 都不需要重新分配内存.
+	 * 已知元素个数时应先调用此函数.
+	 * 
+	 * @param capacity 需要的容量, 不大于当前容量时函数什么都不做.
+	*/
+	e_void reserve(e_int capacity) {
+		if (capacity > m_capacity) {
+			_updateCapacity(capacity);
+		}
+	}
 	
 	/**
 	 * \brief 清空容器.
@@ -557,10 +624,11 @@ public:
 	 * 清空内部缓存区并重新初始化.
 	*/
 	e_void clean() {
-		delete [] m_buffer;
+		_destroy(m_buffer, m_length);
+		_deallocate(m_buffer);
 		m_capacity = 16;
 		m_length   = 0;
-		m_buffer   = new E[m_capacity];
+		m_buffer   = _allocate(m_capacity);
 	}
 	
 	/**
@@ -573,21 +641,48 @@ public:
 	}
 private:
 	e_void _updateCapacity(e_int newCapacity) {
-		E* newBuffer = _createNewBuffer(newCapacity);
-		_move(newBuffer, m_buffer, m_length);
-		delete [] m_buffer;
-		m_buffer = newBuffer;
+		E* newBuffer = _allocate(newCapacity);
+		_relocate(newBuffer, m_buffer, m_length);
+		_deallocate(m_buffer);
+		m_buffer   = newBuffer;
+		m_capacity = newCapacity;
 	}
 
-	E* _createNewBuffer(e_int newCapacity) {
-		m_capacity   = newCapacity;
-		E* newBuffer = new E[m_capacity];
-		return newBuffer;
+	static inline E* _allocate(e_int capacity) {
+		return static_cast<E*>(::operator new(sizeof(E)*capacity));
 	}
 
-	inline e_void _copy(E* des, E* src) {
-		for (e_int i=0; i<m_length; i++) {
-			des[i] = src[i];
+	static inline e_void _deallocate(E* buffer) {
+		::operator delete(buffer);
+	}
+
+	static inline e_void _destroy(E* buffer, e_int length) {
+		for (e_int i=0; i<length; i++) {
+			buffer[i].~E();
+		}
+	}
+
+	// 在空的 m_buffer 中复制 copy 的元素.
+	inline e_void _copy(const Vector& copy) {
+		if (std::is_trivially_copyable<E>::value) {
+			::memcpy(static_cast<e_void*>(m_buffer), static_cast<const e_void*>(copy.m_buffer), sizeof(E)*copy.m_length);
+			m_length = copy.m_length;
+			return;
+		}
+		for (; m_length<copy.m_length; m_length++) {
+			new (&m_buffer[m_length]) E(copy.m_buffer[m_length]);
+		}
+	}
+
+	// 把 src 的元素搬到未初始化的 des, src 之后是未初始化的内存.
+	static inline e_void _relocate(E* des, E* src, e_int length) {
+		if (IsTriviallyRelocatable<E>::value) {
+			::memcpy(static_cast<e_void*>(des), static_cast<const e_void*>(src), sizeof(E)*length);
+			return;
+		}
+		for (e_int i=0; i<length; i++) {
+			new (&des[i]) E(System::move(src[i]));
+			src[i].~E();
 		}
 	}
 
@@ -649,6 +744,14 @@ private:
 		return -1; //never arrive here
 	}
 }; // Vector
+
+template<class E>
+struct IsTriviallyRelocatable<Vector<E>> {
+	static constexpr e_bool value = true;
+};
+
+template<class E>
+constexpr e_bool IsTriviallyRelocatable<Vector<E>>::value;
 } // Easy
 
 #endif // _EASY_VECTOR_H_
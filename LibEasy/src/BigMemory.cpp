@@ -0,0 +1,314 @@
+/*
+ * 文件名: BigMemory.cpp
+ *
+ * 日期/时间:
+ *		开始: 2026年10月18日 10:12:46 周日
+ *		结束:
+ *
+ * 版本: 1.0
+ *
+ * 作者: Tes Alone
+ *
+ * 备注:
+*/
+
+#include <cstring>
+#include <new>
+#include <windows.h>
+
+#include "BigMemory.hpp"
+#include "String.tcc"
+#include "StringBuffer.hpp"
+#include "Exception.hpp"
+#include "System.hpp"
+
+namespace Easy {
+
+constexpr e_int  BigMemory::PAGE_BITS;
+constexpr e_long BigMemory::PAGE_SIZE;
+constexpr e_int  BigMemory::TABLE_BITS;
+constexpr e_int  BigMemory::TABLE_SIZE;
+
+// Bytes of every page that was never written.
+static const e_ubyte ZERO_PAGE[BigMemory::PAGE_SIZE] = {0};
+
+static inline e_int _slot(e_long page, e_int level) {
+	return (e_int)(page >> (BigMemory::TABLE_BITS*level)) & (BigMemory::TABLE_SIZE-1);
+}
+
+static inline e_ubyte* _allocBytes() {
+	// Anonymous committed pages are zero-filled by the system.
+	e_void* bytes = ::VirtualAlloc(nullptr, BigMemory::PAGE_SIZE, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+	if (bytes == nullptr) {
+		throw std::bad_alloc{};
+	}
+	return static_cast<e_ubyte*>(bytes);
+}
+
+static inline e_void _retain(e_int* refs) {
+	__atomic_fetch_add(refs, 1, __ATOMIC_RELAXED);
+}
+
+// Returns true when the caller dropped the last reference.
+static inline e_bool _release(e_int* refs) {
+	return __atomic_sub_fetch(refs, 1, __ATOMIC_ACQ_REL) == 0;
+}
+
+static inline e_bool _shared(const e_int* refs) {
+	return __atomic_load_n(refs, __ATOMIC_ACQUIRE) > 1;
+}
+
+BigMemory::BigMemory(e_long s) : _root(nullptr), _levels(1), _pages(0) {
+	_maxSize = s <= 0 ? 0 : s;
+	e_long pages = (_maxSize + PAGE_SIZE - 1) >> PAGE_BITS;
+	while (pages > 1 && ((pages-1) >> (_levels*TABLE_BITS)) != 0) {
+		_levels++;
+	}
+}
+
+BigMemory::BigMemory(const BigMemory& copy) {
+	_root    = copy._root;
+	_levels  = copy._levels;
+	_maxSize = copy._maxSize;
+	_pages   = copy._pages;
+	if (_root) {
+		_retain(&_root->_refs);
+	}
+}
+
+BigMemory& BigMemory::operator=(const BigMemory& copy) {
+	if (this != &copy) {
+		if (copy._root) {
+			_retain(&copy._root->_refs);
+		}
+		if (_root) {
+			_releaseTable(_root, _levels-1);
+		}
+		_root    = copy._root;
+		_levels  = copy._levels;
+		_maxSize = copy._maxSize;
+		_pages   = copy._pages;
+	}
+	return *this;
+}
+
+BigMemory::BigMemory(BigMemory&& move) {
+	_root    = move._root;
+	_levels  = move._levels;
+	_maxSize = move._maxSize;
+	_pages   = move._pages;
+	move._root    = nullptr;
+	move._levels  = 1;
+	move._maxSize = 0;
+	move._pages   = 0;
+}
+
+BigMemory& BigMemory::operator=(BigMemory&& move) {
+	if (this != &move) {
+		if (_root) {
+			_releaseTable(_root, _levels-1);
+		}
+		_root    = move._root;
+		_levels  = move._levels;
+		_maxSize = move._maxSize;
+		_pages   = move._pages;
+		move._root    = nullptr;
+		move._levels  = 1;
+		move._maxSize = 0;
+		move._pages   = 0;
+	}
+	return *this;
+}
+
+BigMemory::~BigMemory() {
+	if (_root) {
+		_releaseTable(_root, _levels-1);
+	}
+}
+
+e_bool BigMemory::equals(const BigMemory& other) const {
+	return _maxSize == other._maxSize
+			&& _equalTables(_root, other._root, _levels-1);
+}
+
+String BigMemory::toString() const {
+	String fmt{L"%02s"};
+	StringBuffer sb;
+	sb.append(String{L"["});
+	e_int length;
+	for (e_long i=0; i<_maxSize; i+=length) {
+		const e_ubyte* bytes = view(i, _maxSize, length);
+		for (e_int j=0; j<length; j++) {
+			sb.append(String::format(fmt, Integer::toHexString(bytes[j])) + L", ");
+		}
+	}
+	if (sb.length() > 1) {
+		sb.removeTail(sb.length()-2);
+	}
+	sb.append(String{L"]"});
+	return System::move(sb.toString());
+}
+
+UByteArray BigMemory::read(e_long start, e_long end) const {
+	if (start<0 || end<0 || start>end || end>_maxSize || end-start>Integer::MAX) {
+		throw IllegalArgumentException{__func__, __LINE__};
+	}
+	UByteArray out{(e_int)(end-start)};
+	e_ubyte* des = out.toCArray();
+	while (start < end) {
+		e_long offset = start & (PAGE_SIZE-1);
+		e_long count  = PAGE_SIZE-offset < end-start ? PAGE_SIZE-offset : end-start;
+		const e_ubyte* page = _findPage(start >> PAGE_BITS);
+		if (page) {
+			::memcpy(des, page+offset, count);
+		}
+		des   += count;
+		start += count;
+	}
+	return System::move(out);
+}
+
+const e_ubyte* BigMemory::view(e_long start, e_long end, e_int& length) const {
+	if (start<0 || start>=end || end>_maxSize) {
+		throw IllegalArgumentException{__func__, __LINE__};
+	}
+	e_long offset = start & (PAGE_SIZE-1);
+	length = (e_int)(PAGE_SIZE-offset < end-start ? PAGE_SIZE-offset : end-start);
+	const e_ubyte* page = _findPage(start >> PAGE_BITS);
+	return (page ? page : ZERO_PAGE) + offset;
+}
+
+e_void BigMemory::write(const UByteArray& data, e_long start, e_long end) {
+	if (start<0 || end<0 || start>end || end>_maxSize) {
+		throw IllegalArgumentException{__func__, __LINE__};
+	}
+	if (data.length() != end-start) {
+		throw IllegalArgumentException{__func__, __LINE__};
+	}
+	const e_ubyte* src = data.toCArray();
+	while (start < end) {
+		e_long offset = start & (PAGE_SIZE-1);
+		e_long count  = PAGE_SIZE-offset < end-start ? PAGE_SIZE-offset : end-start;
+		::memcpy(_touchPage(start >> PAGE_BITS)+offset, src, count);
+		src   += count;
+		start += count;
+	}
+}
+
+const e_ubyte* BigMemory::_findPage(e_long page) const {
+	const Table* table = _root;
+	for (e_int level=_levels-1; table && level>0; level--) {
+		table = static_cast<const Table*>(table->_slots[_slot(page, level)]);
+	}
+	const Page* found = table ? static_cast<const Page*>(table->_slots[_slot(page, 0)]) : nullptr;
+	return found ? found->_bytes : nullptr;
+}
+
+/*
+	Tables and pages shared with a snapshot are never modified. The tables on the
+	path to the page and the page itself are copied where they are shared, so the
+	snapshot keeps the old path and the rest stays shared.
+*/
+e_ubyte* BigMemory::_touchPage(e_long page) {
+	_root = _ownTable(_root, _levels-1);
+	Table* table = _root;
+	for (e_int level=_levels-1; level>0; level--) {
+		e_void*& slot = table->_slots[_slot(page, level)];
+		slot  = _ownTable(static_cast<Table*>(slot), level-1);
+		table = static_cast<Table*>(slot);
+	}
+	e_void*& slot = table->_slots[_slot(page, 0)];
+	Page* found = static_cast<Page*>(slot);
+	if (found == nullptr) {
+		slot = new Page{1, _allocBytes()};
+		_pages++;
+	} else if (_shared(&found->_refs)) {
+		Page* copy = new Page{1, _allocBytes()};
+		::memcpy(copy->_bytes, found->_bytes, PAGE_SIZE);
+		_releasePage(found);
+		slot = copy;
+	}
+	return static_cast<Page*>(slot)->_bytes;
+}
+
+// Returns a table the receiver may modify in place at the position of table.
+BigMemory::Table* BigMemory::_ownTable(Table* table, e_int level) {
+	if (table == nullptr) {
+		return new Table();
+	}
+	if (_shared(&table->_refs)) {
+		Table* copy = _cloneTable(table, level);
+		_releaseTable(table, level);
+		return copy;
+	}
+	return table;
+}
+
+// Copies only the slots, the copy and table share the children.
+BigMemory::Table* BigMemory::_cloneTable(const Table* table, e_int level) {
+	Table* copy = new Table();
+	for (e_int i=0; i<TABLE_SIZE; i++) {
+		e_void* child = table->_slots[i];
+		if (child == nullptr) {
+			continue;
+		}
+		if (level == 0) {
+			_retain(&static_cast<Page*>(child)->_refs);
+		} else {
+			_retain(&static_cast<Table*>(child)->_refs);
+		}
+		copy->_slots[i] = child;
+	}
+	return copy;
+}
+
+e_void BigMemory::_releaseTable(Table* table, e_int level) {
+	if (!_release(&table->_refs)) {
+		return;
+	}
+	for (e_int i=0; i<TABLE_SIZE; i++) {
+		e_void* child = table->_slots[i];
+		if (child == nullptr) {
+			continue;
+		}
+		if (level == 0) {
+			_releasePage(static_cast<Page*>(child));
+		} else {
+			_releaseTable(static_cast<Table*>(child), level-1);
+		}
+	}
+	delete table;
+}
+
+e_void BigMemory::_releasePage(Page* page) {
+	if (_release(&page->_refs)) {
+		::VirtualFree(page->_bytes, 0, MEM_RELEASE);
+		delete page;
+	}
+}
+
+// A missing table or page stands for zeros.
+e_bool BigMemory::_equalTables(const Table* a, const Table* b, e_int level) {
+	if (a == b) {
+		return true;
+	}
+	for (e_int i=0; i<TABLE_SIZE; i++) {
+		const e_void* x = a ? a->_slots[i] : nullptr;
+		const e_void* y = b ? b->_slots[i] : nullptr;
+		if (x == y) {
+			continue;
+		}
+		if (level == 0) {
+			const e_ubyte* xBytes = x ? static_cast<const Page*>(x)->_bytes : ZERO_PAGE;
+			const e_ubyte* yBytes = y ? static_cast<const Page*>(y)->_bytes : ZERO_PAGE;
+			if (xBytes != yBytes && ::memcmp(xBytes, yBytes, PAGE_SIZE) != 0) {
+				return false;
+			}
+		} else if (!_equalTables(static_cast<const Table*>(x), static_cast<const Table*>(y), level-1)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+} // namespace Easy
@@ -0,0 +1,71 @@
+/*
+ * 文件名: ConcurrentHashMap.cpp
+ *
+ * 日期/时间:
+ *		开始: 2026年10月17日 23:58:03 周六
+ *		结束:
+ *
+ * 版本: 1.0
+ *
+ * 作者: Tes Alone
+ *
+ * 备注:
+*/
+
+#include <windows.h>
+#include <emmintrin.h>
+
+#include "ConcurrentHashMap.hpp"
+#include "Integer.hpp"
+
+namespace Easy {
+
+constexpr e_int Epoch::SLOTS;
+
+// 自旋这么多次之后让出处理器.
+static const e_int SPIN_LIMIT = 64;
+
+Epoch::Epoch() {
+	for (e_int i=0; i<SLOTS; i++) {
+		m_slots[i].m_readers[0] = 0;
+		m_slots[i].m_readers[1] = 0;
+	}
+	m_epoch = 0;
+	InitializeSRWLock(&m_lock);
+}
+
+e_void Epoch::synchronize() {
+	AcquireSRWLockExclusive(&m_lock);
+	// 翻转之后进入的读者记在另一个计数上, 旧的计数只减不增.
+	e_int phase = (e_int)(__atomic_fetch_add(&m_epoch, 1, __ATOMIC_SEQ_CST) & 1);
+	// 读者先增加计数再读 m_epoch, 这里先写 m_epoch 再读计数 (Dekker), 两边都必须是 seq_cst,
+	// 否则读计数可以提前到翻转之前, 看不到刚进入的读者.
+	for (e_int i=0; i<SLOTS; i++) {
+		e_int spins = 0;
+		while (__atomic_load_n(&m_slots[i].m_readers[phase], __ATOMIC_SEQ_CST) != 0) {
+			if (++spins < SPIN_LIMIT) {
+				_mm_pause();
+			} else {
+				SwitchToThread();
+				spins = 0;
+			}
+		}
+	}
+	ReleaseSRWLockExclusive(&m_lock);
+}
+
+e_int Epoch::_slot() {
+	static e_int next = 0;
+	static thread_local e_int slot = __atomic_fetch_add(&next, 1, __ATOMIC_RELAXED) & (SLOTS - 1);
+	return slot;
+}
+
+e_int Epoch::hashCode() const {
+	return Long::hashCode(reinterpret_cast<e_long>(this));
+}
+
+String Epoch::toString() const {
+	return String{L"Epoch: "} + Long::toString(__atomic_load_n(&m_epoch, __ATOMIC_RELAXED));
+}
+
+} // Easy
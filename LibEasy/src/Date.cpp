@@ -94,8 +94,7 @@ e_int Date::compare(const Date& other) const {
 }
 
 String Date::toString() const {
-	String format{L"%4s-%02s-%02s %02s:%02s:%02s %s"};
-	return System::move(String::format(format, Integer{year},
+	return System::move(String::format(EASY_FORMAT(L"%4s-%02s-%02s %02s:%02s:%02s %s"), Integer{year},
 									Integer{month},
 									Integer{day},
 									Integer{hour},
@@ -114,27 +113,22 @@ static const e_char USWeek[7][4] = {
 };
 
 String Date::format(e_int locale) const {
-	String format, week;
 	if (locale == Date::CN) {
-		format = String{L"%4s年%02s月%02s日 %02s:%02s:%02s %s"};
-		week   = String{CNWeek[dayOfWeek]};
-		return System::move(String::format(format, Integer{year},
+		return System::move(String::format(EASY_FORMAT(L"%4s年%02s月%02s日 %02s:%02s:%02s %s"), Integer{year},
 									Integer{month},
 									Integer{day},
 									Integer{hour},
 									Integer{minute},
 									Integer{second},
-									week));
+									StringView{CNWeek[dayOfWeek]}));
 	} else if (locale == Date::US) {
-		format = String{L"%4s/%02s/%02s %02s:%02s:%02s %s"};
-		week   = String{USWeek[dayOfWeek]};
-		return System::move(String::format(format, Integer{year},
+		return System::move(String::format(EASY_FORMAT(L"%4s/%02s/%02s %02s:%02s:%02s %s"), Integer{year},
 									Integer{day},
 									Integer{month},
 									Integer{hour},
 									Integer{minute},
 									Integer{second},
-									week));
+									StringView{USWeek[dayOfWeek]}));
 	} else {
 		throw IllegalArgumentException{__func__, __LINE__};
 	}
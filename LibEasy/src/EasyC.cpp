@@ -1,63 +1,428 @@
 /*
- * 文件名: EasyC.cpp 
+ * 文件名: EasyC.cpp
  *
  * 日期/时间:
  *		开始: 2020年06月04日 13:57:46 周四
  *		结束:
  *
  * 版本: 1.0
- * 
+ *
  * 作者: Tes Alone
  *
  * 备注:
 */
 
+#include <immintrin.h>
+#include <cpuid.h>
+
 #include "EasyC.hpp"
 #include "Exception.hpp"
+#include "String.hpp"
+
+// copies no longer than SMALL_LIMIT use copy_small(), copies no shorter than
+// STREAM_LIMIT between disjoint blocks bypass the cache with non-temporal stores.
+#define SMALL_LIMIT  16
+#define STREAM_LIMIT (1 << 22)
+
+typedef e_void (*MemKernel)(e_ubyte* des, const e_ubyte* src, e_int count);
+
+/*
+	copyUp 从低地址向高地址复制, des <= src 时可用于重叠内存;
+	copyDown 从高地址向低地址复制, des >= src 时可用于重叠内存.
+*/
+struct MemKernels {
+	MemKernel copyUp;
+	MemKernel copyDown;
+};
 
-static e_void memmove_forward(e_void* des, e_void* src, e_int count);
-static e_void memmove_backward(e_void* des, const e_void* src, e_int count);
+static e_void memmove_forward(e_ubyte* des, const e_ubyte* src, e_int count);
+static e_void memmove_backward(e_ubyte* des, const e_ubyte* src, e_int count);
+static e_void copyup_sse2(e_ubyte* des, const e_ubyte* src, e_int count);
+static e_void copydown_sse2(e_ubyte* des, const e_ubyte* src, e_int count);
+static e_void copyup_avx2(e_ubyte* des, const e_ubyte* src, e_int count);
+static e_void copydown_avx2(e_ubyte* des, const e_ubyte* src, e_int count);
+static e_void copyup_avx512(e_ubyte* des, const e_ubyte* src, e_int count);
+static e_void copydown_avx512(e_ubyte* des, const e_ubyte* src, e_int count);
+
+static const MemKernels KERNELS[] = {
+	{memmove_backward, memmove_forward},  // E_MEM_SCALAR
+	{copyup_sse2,      copydown_sse2},    // E_MEM_SSE2
+	{copyup_avx2,      copydown_avx2},    // E_MEM_AVX2
+	{copyup_avx512,    copydown_avx512}   // E_MEM_AVX512
+};
+
+// 多个线程可能同时调用 e_memcopy, s_kernels 只用原子操作读写.
+static const MemKernels* s_kernels = nullptr;
+
+static e_int detectLevel();
+
+static inline e_int maxLevel() {
+	static const e_int level = detectLevel();
+	return level;
+}
+
+static inline const MemKernels* kernels() {
+	const MemKernels* current = __atomic_load_n(&s_kernels, __ATOMIC_ACQUIRE);
+	if (current == nullptr) {
+		const MemKernels* detected = &KERNELS[maxLevel()];
+		// 失败时 current 被设为另一个线程或 e_setmemlevel() 写入的值.
+		if (__atomic_compare_exchange_n(&s_kernels, &current, detected, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)) {
+			current = detected;
+		}
+	}
+	return current;
+}
+
+static inline e_void copy_small(e_ubyte* des, const e_ubyte* src, e_int count);
 
 e_void e_memmove(e_void* des, e_void* src, e_int count) {
-	if (des > src) {
-		memmove_forward(des, src, count);
+	if (count<=0 || des==src) return;
+	e_ubyte* d = (e_ubyte*) des;
+	e_ubyte* s = (e_ubyte*) src;
+	if (count <= SMALL_LIMIT) {
+		copy_small(d, s, count);
+	} else if (d>s && s+count>d) {
+		kernels()->copyDown(d, s, count);
 	} else {
-		memmove_backward(des, (const e_void*)src, count);
+		kernels()->copyUp(d, s, count);
 	}
 }
 
 e_void e_memcopy(e_void* des, const e_void* src, e_int count) {
-	memmove_backward(des, src, count);
+	if (count <= SMALL_LIMIT) {
+		copy_small((e_ubyte*)des, (const e_ubyte*)src, count);
+	} else {
+		kernels()->copyUp((e_ubyte*)des, (const e_ubyte*)src, count);
+	}
+}
+
+e_int e_memlevel() {
+	return (e_int)(kernels() - KERNELS);
+}
+
+e_void e_setmemlevel(e_int level) {
+	if (level<E_MEM_SCALAR || level>maxLevel()) {
+		throw IllegalArgumentException{__func__, __LINE__};
+	}
+	__atomic_store_n(&s_kernels, &KERNELS[level], __ATOMIC_RELEASE);
+}
+
+static e_int detectLevel() {
+	e_uint eax, ebx, ecx, edx;
+	if (!__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+		return E_MEM_SSE2;
+	}
+	// AVX 需要操作系统通过 XSAVE 保存 YMM 寄存器.
+	if (!(ecx & bit_OSXSAVE) || !(ecx & bit_AVX)) {
+		return E_MEM_SSE2;
+	}
+	e_uint xcr0Lo, xcr0Hi;
+	__asm__ volatile ("xgetbv" : "=a"(xcr0Lo), "=d"(xcr0Hi) : "c"(0));
+	if ((xcr0Lo & 0x06) != 0x06) {
+		return E_MEM_SSE2;
+	}
+	if (!__get_cpuid_count(7, 0, &eax, &ebx, &ecx, &edx) || !(ebx & bit_AVX2)) {
+		return E_MEM_SSE2;
+	}
+	if ((ebx & bit_AVX512F) && (xcr0Lo & 0xe6) == 0xe6) {
+		return E_MEM_AVX512;
+	}
+	return E_MEM_AVX2;
+}
+
+static inline e_bool disjoint(e_ubyte* des, const e_ubyte* src, e_int count) {
+	return des+count<=src || src+count<=des;
+}
+
+/*
+	count <= 16, 先读后写, 可用于重叠内存. 所有级别共用.
+*/
+static inline e_void copy_small(e_ubyte* des, const e_ubyte* src, e_int count) {
+	if (count >= 8) {
+		e_ulong head, tail;
+		__builtin_memcpy(&head, src, 8);
+		__builtin_memcpy(&tail, src+count-8, 8);
+		__builtin_memcpy(des, &head, 8);
+		__builtin_memcpy(des+count-8, &tail, 8);
+	} else if (count >= 4) {
+		e_uint head, tail;
+		__builtin_memcpy(&head, src, 4);
+		__builtin_memcpy(&tail, src+count-4, 4);
+		__builtin_memcpy(des, &head, 4);
+		__builtin_memcpy(des+count-4, &tail, 4);
+	} else if (count > 0) {
+		e_ubyte head = src[0];
+		e_ubyte mid  = src[count/2];
+		e_ubyte tail = src[count-1];
+		des[0]       = head;
+		des[count/2] = mid;
+		des[count-1] = tail;
+	}
+}
+
+/*
+	以下 SIMD 复制函数都先读取首尾两个向量, 中间部分按 des 对齐后逐个向量复制,
+	最后写入首尾向量, 所以可以覆盖非整数倍的长度, 并且在复制方向正确时可用于重叠内存.
+*/
+
+static e_void copyup_sse2(e_ubyte* des, const e_ubyte* src, e_int count) {
+	if (count <= SMALL_LIMIT) {
+		copy_small(des, src, count);
+		return;
+	}
+	__m128i head = _mm_loadu_si128((const __m128i*)src);
+	__m128i tail = _mm_loadu_si128((const __m128i*)(src+count-16));
+	e_int i    = 16 - (e_int)((uintptr_t)des & 15);
+	e_int last = count - 16;
+	if (count>=STREAM_LIMIT && disjoint(des, src, count)) {
+		for (; i<last; i+=16) {
+			_mm_stream_si128((__m128i*)(des+i), _mm_loadu_si128((const __m128i*)(src+i)));
+		}
+		_mm_sfence();
+	} else {
+		for (; i<last; i+=16) {
+			_mm_store_si128((__m128i*)(des+i), _mm_loadu_si128((const __m128i*)(src+i)));
+		}
+	}
+	_mm_storeu_si128((__m128i*)des, head);
+	_mm_storeu_si128((__m128i*)(des+count-16), tail);
+}
+
+static e_void copydown_sse2(e_ubyte* des, const e_ubyte* src, e_int count) {
+	if (count <= SMALL_LIMIT) {
+		copy_small(des, src, count);
+		return;
+	}
+	__m128i head = _mm_loadu_si128((const __m128i*)src);
+	__m128i tail = _mm_loadu_si128((const __m128i*)(src+count-16));
+	e_int skew = (e_int)((uintptr_t)(des+count) & 15);
+	for (e_int i=count-(skew ? skew : 16)-16; i>0; i-=16) {
+		_mm_store_si128((__m128i*)(des+i), _mm_loadu_si128((const __m128i*)(src+i)));
+	}
+	_mm_storeu_si128((__m128i*)des, head);
+	_mm_storeu_si128((__m128i*)(des+count-16), tail);
 }
 
-static e_void memmove_backward(e_void* des, const e_void* src, e_int count) {
+/*
+	MinGW-w64 的 GCC 不会把栈对齐到 32 或 64 字节 (GCC PR 54412), __m256i 和 __m512i 的值一旦放到栈上,
+	对齐的 vmovdqa 就可能出错, 而 -O0 下内联的 intrinsic 的参数和返回值都会放到栈上.
+	所以 AVX2 和 AVX-512 的复制用内联汇编, 向量只存在于 ymm0/zmm0 中, 首尾向量先存入字节数组.
+	函数返回前执行 vzeroupper, 避免之后的 SSE 代码变慢.
+*/
+static inline e_void ymm_loadu_storeu(e_ubyte* des, const e_ubyte* src) {
+	__asm__ volatile ("vmovdqu (%1), %%ymm0\n\tvmovdqu %%ymm0, (%0)" : : "r"(des), "r"(src) : "xmm0", "memory");
+}
+
+static inline e_void ymm_loadu_store(e_ubyte* des, const e_ubyte* src) {
+	__asm__ volatile ("vmovdqu (%1), %%ymm0\n\tvmovdqa %%ymm0, (%0)" : : "r"(des), "r"(src) : "xmm0", "memory");
+}
+
+static inline e_void ymm_loadu_stream(e_ubyte* des, const e_ubyte* src) {
+	__asm__ volatile ("vmovdqu (%1), %%ymm0\n\tvmovntdq %%ymm0, (%0)" : : "r"(des), "r"(src) : "xmm0", "memory");
+}
+
+static inline e_void zmm_loadu_storeu(e_ubyte* des, const e_ubyte* src) {
+	__asm__ volatile ("vmovdqu64 (%1), %%zmm0\n\tvmovdqu64 %%zmm0, (%0)" : : "r"(des), "r"(src) : "xmm0", "memory");
+}
+
+static inline e_void zmm_loadu_store(e_ubyte* des, const e_ubyte* src) {
+	__asm__ volatile ("vmovdqu64 (%1), %%zmm0\n\tvmovdqa64 %%zmm0, (%0)" : : "r"(des), "r"(src) : "xmm0", "memory");
+}
+
+static inline e_void zmm_loadu_stream(e_ubyte* des, const e_ubyte* src) {
+	__asm__ volatile ("vmovdqu64 (%1), %%zmm0\n\tvmovntdq %%zmm0, (%0)" : : "r"(des), "r"(src) : "xmm0", "memory");
+}
+
+static inline e_void vzeroupper() {
+	__asm__ volatile ("vzeroupper" : : : "memory");
+}
+
+static e_void copyup_avx2(e_ubyte* des, const e_ubyte* src, e_int count) {
+	if (count <= 32) {
+		copyup_sse2(des, src, count);
+		return;
+	}
+	e_ubyte head[32];
+	e_ubyte tail[32];
+	ymm_loadu_storeu(head, src);
+	ymm_loadu_storeu(tail, src+count-32);
+	e_int i    = 32 - (e_int)((uintptr_t)des & 31);
+	e_int last = count - 32;
+	if (count>=STREAM_LIMIT && disjoint(des, src, count)) {
+		for (; i<last; i+=32) {
+			ymm_loadu_stream(des+i, src+i);
+		}
+		_mm_sfence();
+	} else {
+		for (; i<last; i+=32) {
+			ymm_loadu_store(des+i, src+i);
+		}
+	}
+	ymm_loadu_storeu(des, head);
+	ymm_loadu_storeu(des+count-32, tail);
+	vzeroupper();
+}
+
+static e_void copydown_avx2(e_ubyte* des, const e_ubyte* src, e_int count) {
+	if (count <= 32) {
+		copydown_sse2(des, src, count);
+		return;
+	}
+	e_ubyte head[32];
+	e_ubyte tail[32];
+	ymm_loadu_storeu(head, src);
+	ymm_loadu_storeu(tail, src+count-32);
+	e_int skew = (e_int)((uintptr_t)(des+count) & 31);
+	for (e_int i=count-(skew ? skew : 32)-32; i>0; i-=32) {
+		ymm_loadu_store(des+i, src+i);
+	}
+	ymm_loadu_storeu(des, head);
+	ymm_loadu_storeu(des+count-32, tail);
+	vzeroupper();
+}
+
+static e_void copyup_avx512(e_ubyte* des, const e_ubyte* src, e_int count) {
+	if (count <= 64) {
+		copyup_avx2(des, src, count);
+		return;
+	}
+	e_ubyte head[64];
+	e_ubyte tail[64];
+	zmm_loadu_storeu(head, src);
+	zmm_loadu_storeu(tail, src+count-64);
+	e_int i    = 64 - (e_int)((uintptr_t)des & 63);
+	e_int last = count - 64;
+	if (count>=STREAM_LIMIT && disjoint(des, src, count)) {
+		for (; i<last; i+=64) {
+			zmm_loadu_stream(des+i, src+i);
+		}
+		_mm_sfence();
+	} else {
+		for (; i<last; i+=64) {
+			zmm_loadu_store(des+i, src+i);
+		}
+	}
+	zmm_loadu_storeu(des, head);
+	zmm_loadu_storeu(des+count-64, tail);
+	vzeroupper();
+}
+
+static e_void copydown_avx512(e_ubyte* des, const e_ubyte* src, e_int count) {
+	if (count <= 64) {
+		copydown_avx2(des, src, count);
+		return;
+	}
+	e_ubyte head[64];
+	e_ubyte tail[64];
+	zmm_loadu_storeu(head, src);
+	zmm_loadu_storeu(tail, src+count-64);
+	e_int skew = (e_int)((uintptr_t)(des+count) & 63);
+	for (e_int i=count-(skew ? skew : 64)-64; i>0; i-=64) {
+		zmm_loadu_store(des+i, src+i);
+	}
+	zmm_loadu_storeu(des, head);
+	zmm_loadu_storeu(des+count-64, tail);
+	vzeroupper();
+}
+
+static e_void memmove_backward(e_ubyte* des, const e_ubyte* src, e_int count) {
 	e_long* d = (e_long*) des;
 	e_long* s = (e_long*) src;
 	e_int l = count / 8;
 	for (e_int i=0; i<l; i++) {
 		d[i] = s[i];
 	}
-	e_byte* db = (e_byte*) des;
-	e_byte* sb = (e_byte*) src;
 	e_int tailOffset = l * 8;
 	for (e_int i=tailOffset; i<count; i++) {
-		db[i] = sb[i];
+		des[i] = src[i];
 	}
 }
 
-static e_void memmove_forward(e_void* des, e_void* src, e_int count) {
+static e_void memmove_forward(e_ubyte* des, const e_ubyte* src, e_int count) {
 	e_int headLen = count % 8;
-	e_ubyte* wholeStartOfSrc = ((e_ubyte*)src) + headLen;
-	e_ubyte* wholeStartOfdes = ((e_ubyte*)des) + headLen;
+	const e_ubyte* wholeStartOfSrc = src + headLen;
+	e_ubyte* wholeStartOfdes = des + headLen;
 	e_int wholeLen = (count - headLen) / 8;
 	e_long* srcLong = (e_long*)wholeStartOfSrc;
 	e_long* desLong = (e_long*)wholeStartOfdes;
 	for (e_int i=wholeLen-1; i>=0; i--) {
 		desLong[i] = srcLong[i];
 	}
-	e_ubyte* srcByte = (e_ubyte*)src;
-	e_ubyte* desByte = (e_ubyte*)des;
 	for (e_int i=headLen-1; i>=0; i--) {
-		desByte[i] = srcByte[i];
+		des[i] = src[i];
+	}
+}
+
+// ------------------------------------
+
+static const e_ulong HASH_SECRET[4] = {
+	0x2d358dccaa6c78a5ull, 0x8bb84b93962eacc9ull, 0x4b33a62ed433d4a3ull, 0x4d5a2da51de1aa47ull
+};
+
+static inline e_void hash_mum(e_ulong* a, e_ulong* b) {
+	__uint128_t r = *a;
+	r *= *b;
+	*a = (e_ulong)r;
+	*b = (e_ulong)(r >> 64);
+}
+
+static inline e_ulong hash_mix(e_ulong a, e_ulong b) {
+	hash_mum(&a, &b);
+	return a ^ b;
+}
+
+static inline e_ulong hash_read8(const e_ubyte* p) {
+	e_ulong v;
+	__builtin_memcpy(&v, p, 8);
+	return v;
+}
+
+static inline e_ulong hash_read4(const e_ubyte* p) {
+	e_uint v;
+	__builtin_memcpy(&v, p, 4);
+	return v;
+}
+
+e_ulong e_hash(const e_void* data, e_int count, e_ulong seed) {
+	const e_ubyte* p = (const e_ubyte*)data;
+	e_ulong len = count > 0 ? count : 0;
+	e_ulong a, b;
+
+	seed ^= hash_mix(seed ^ HASH_SECRET[0], HASH_SECRET[1]);
+	if (len <= 16) {
+		if (len >= 4) {
+			e_ulong gap = (len >> 3) << 2;
+			a = (hash_read4(p) << 32) | hash_read4(p + gap);
+			b = (hash_read4(p + len - 4) << 32) | hash_read4(p + len - 4 - gap);
+		} else if (len > 0) {
+			a = ((e_ulong)p[0] << 16) | ((e_ulong)p[len >> 1] << 8) | p[len - 1];
+			b = 0;
+		} else {
+			a = b = 0;
+		}
+	} else {
+		e_ulong i = len;
+		if (i > 48) {
+			e_ulong see1 = seed, see2 = seed;
+			do {
+				seed = hash_mix(hash_read8(p) ^ HASH_SECRET[1], hash_read8(p + 8) ^ seed);
+				see1 = hash_mix(hash_read8(p + 16) ^ HASH_SECRET[2], hash_read8(p + 24) ^ see1);
+				see2 = hash_mix(hash_read8(p + 32) ^ HASH_SECRET[3], hash_read8(p + 40) ^ see2);
+				p += 48;
+				i -= 48;
+			} while (i > 48);
+			seed ^= see1 ^ see2;
+		}
+		while (i > 16) {
+			seed = hash_mix(hash_read8(p) ^ HASH_SECRET[1], hash_read8(p + 8) ^ seed);
+			p += 16;
+			i -= 16;
+		}
+		a = hash_read8(p + i - 16);
+		b = hash_read8(p + i - 8);
 	}
+	a ^= HASH_SECRET[1];
+	b ^= seed;
+	hash_mum(&a, &b);
+	return hash_mix(a ^ HASH_SECRET[0] ^ len, b ^ HASH_SECRET[1]);
 }
@@ -14,39 +14,58 @@
 #include "Exception.hpp"
 #include "String.hpp"
 #include "StringBuffer.hpp"
+#include "Utf8String.hpp"
+#include "BasicArray.tcc"
+#include "EasyC.hpp"
 #include "Character.hpp"
 
 namespace Easy {
 
-FileReader::FileReader(const File& file) {
+FileReader::FileReader(const File& file, e_int mode) {
 	m_filePath = file.getFullPath();
 	if (m_filePath.empty()) {
 		throw IllegalArgumentException{__func__, __LINE__};
 	}
-	m_file = _wfopen(m_filePath.toCStr(), L"rt, ccs=UTF-8");
-	if (m_file == nullptr) {
-		throw  FileOpenFailedException{__func__, __LINE__, m_filePath};
-	}
+	_open(mode);
 //	if (_wfopen_s(&m_file, m_filePath.toCStr(), L"rt, ccs=UTF-8")) {
 //		throw  FileOpenFailedException{m_filePath};
 //	}
 }
 
-FileReader::FileReader(const String& filePath) {
+FileReader::FileReader(const String& filePath, e_int mode) {
 	if (filePath.empty()) {
 		throw IllegalArgumentException{__func__, __LINE__};
 	}
 	m_filePath = filePath;
-	m_file = _wfopen(m_filePath.toCStr(), L"rt, ccs=UTF-8");
-	if (m_file == nullptr) {
-		throw  FileOpenFailedException{__func__, __LINE__, m_filePath};
-	}
+	_open(mode);
 //	if (_wfopen_s(&m_file, filePath.toCStr(), L"rt, ccs=UTF-8")) {
 //		throw  FileOpenFailedException{m_filePath};
 //	}
 }
 
+e_void FileReader::_open(e_int mode) {
+	if (mode!=WIDE && mode!=UTF8) {
+		throw IllegalArgumentException{__func__, __LINE__};
+	}
+	m_mode = mode;
+	m_file = _wfopen(m_filePath.toCStr(), mode==WIDE ? L"rt, ccs=UTF-8" : L"rb");
+	if (m_file == nullptr) {
+		throw  FileOpenFailedException{__func__, __LINE__, m_filePath};
+	}
+	m_closed = false;
+
+	// 跳过 BOM, 与文本模式的行为一致.
+	if (mode == UTF8) {
+		e_ubyte bom[3];
+		e_int count = fread(bom, 1, 3, m_file);
+		if (count<3 || bom[0]!=0xef || bom[1]!=0xbb || bom[2]!=0xbf)
+			fseek(m_file, 0, SEEK_SET);
+	}
+}
+
 e_int FileReader::read() {
+	if (m_mode == UTF8)
+		throw UnsupportedOperationException{__func__, __LINE__, String{L"FileReader::read() in UTF8 mode"}};
     e_int check = fgetwc(m_file);
     if (check==WEOF && ferror(m_file))
         throw  IOException{__func__, __LINE__, m_filePath};
@@ -54,6 +73,8 @@ e_int FileReader::read() {
 }
 
 e_int FileReader::read(CharArray& buf) {
+	if (m_mode == UTF8)
+		throw UnsupportedOperationException{__func__, __LINE__, String{L"FileReader::read(CharArray&) in UTF8 mode"}};
     e_int check = fread(buf.toCArray(), 2, buf.length(), m_file);
     if (check<buf.length() && ferror(m_file)) {
         throw  IOException{__func__, __LINE__, m_filePath};
@@ -61,7 +82,20 @@ e_int FileReader::read(CharArray& buf) {
     return check;
 }
 
+e_int FileReader::read(ByteArray& buf) {
+	if (m_mode == WIDE)
+		throw UnsupportedOperationException{__func__, __LINE__, String{L"FileReader::read(ByteArray&) in WIDE mode"}};
+    e_int check = fread(buf.toCArray(), 1, buf.length(), m_file);
+    if (check<buf.length() && ferror(m_file)) {
+        throw  IOException{__func__, __LINE__, m_filePath};
+    }
+    return check;
+}
+
 String FileReader::readLine() {
+	if (m_mode == UTF8)
+		return System::move(readLineUtf8().toString());
+
 	StringBuffer line;
 	e_int c = this->read();
 	
@@ -75,6 +109,36 @@ String FileReader::readLine() {
 	return System::move(line.toString());
 }
 
+Utf8String FileReader::readLineUtf8() {
+	if (m_mode == WIDE)
+		return System::move(Utf8String{readLine()});
+
+	ByteArray line{128};
+	e_int length = 0;
+	e_int c = getc(m_file);
+
+	if (c == EOF) {
+		if (ferror(m_file))
+			throw  IOException{__func__, __LINE__, m_filePath};
+		throw  FileReachEOFException{__func__, __LINE__, m_filePath};
+	}
+
+	while (c!='\n' && c!=EOF) {
+		if (length == line.length()) {
+			ByteArray bigger{length*2};
+			e_memcopy(bigger.toCArray(), line.toCArray(), length);
+			line = System::move(bigger);
+		}
+		line[length++] = (e_byte)c;
+		c = getc(m_file);
+	}
+	if (c==EOF && ferror(m_file))
+		throw  IOException{__func__, __LINE__, m_filePath};
+
+	if (length>0 && line.toCArray()[length-1]=='\r') length--;
+	return System::move(Utf8String{line.toCArray(), length});
+}
+
 e_void FileReader::close() {
 	if (!m_closed) {
 		e_int check = fclose(m_file);
@@ -12,18 +12,16 @@
 
 #include "FileWriter.hpp"
 #include "String.hpp"
+#include "Utf8String.hpp"
 
 namespace Easy {
 
-FileWriter::FileWriter(const File& file) {
+FileWriter::FileWriter(const File& file, e_int mode) {
 	m_filePath = file.getFullPath();
 	if (m_filePath.empty()) {
 		throw IllegalArgumentException{__func__, __LINE__};
 	}
-	m_file = _wfopen(m_filePath.toCStr(), L"wt, ccs=UTF-8");
-	if (m_file == nullptr) {
-		throw  FileOpenFailedException{__func__, __LINE__, m_filePath};
-	}
+	_open(mode);
 	
 //	m_filePath = file.getFullPath();
 //    if (_wfopen_s(&m_file, m_filePath.toCStr(), L"wt, ccs=UTF-8")) {
@@ -31,15 +29,12 @@ FileWriter::FileWriter(const File& file) {
 //    }
 }
 
-FileWriter::FileWriter(const String& filePath) {
+FileWriter::FileWriter(const String& filePath, e_int mode) {
 	if (filePath.empty()) {
 		throw IllegalArgumentException{__func__, __LINE__};
 	}
 	m_filePath = filePath;
-	m_file = _wfopen(m_filePath.toCStr(), L"wt, ccs=UTF-8");
-	if (m_file == nullptr) {
-		throw  FileOpenFailedException{__func__, __LINE__, m_filePath};
-	}
+	_open(mode);
 	
 //	m_filePath = filePath;
 //    if (_wfopen_s(&m_file, filePath.toCStr(), L"wt, ccs=UTF-8")) {
@@ -47,7 +42,38 @@ FileWriter::FileWriter(const String& filePath) {
 //    }
 }
 
+e_void FileWriter::_open(e_int mode) {
+	if (mode!=WIDE && mode!=UTF8) {
+		throw IllegalArgumentException{__func__, __LINE__};
+	}
+	m_mode = mode;
+	m_file = _wfopen(m_filePath.toCStr(), mode==WIDE ? L"wt, ccs=UTF-8" : L"wb");
+	if (m_file == nullptr) {
+		throw  FileOpenFailedException{__func__, __LINE__, m_filePath};
+	}
+	m_closed = false;
+
+	// 文本模式的 ccs=UTF-8 会写入 BOM, UTF8 模式保持一致.
+	if (mode == UTF8) {
+		static const e_byte BOM[] = {(e_byte)0xef, (e_byte)0xbb, (e_byte)0xbf};
+		_writeBytes(BOM, 3);
+	}
+}
+
+e_void FileWriter::_writeBytes(const e_byte* bytes, e_int length) {
+	e_int check = fwrite(bytes, 1, length, m_file);
+    if (check < length) {
+        throw  IOException{__func__, __LINE__, m_filePath};
+    }
+}
+
 e_void FileWriter::write(e_int c) {
+	if (m_mode == UTF8) {
+		e_char ch = (e_char)c;
+		e_byte bytes[4];
+		_writeBytes(bytes, Utf8String::encode(&ch, 1, bytes));
+		return;
+	}
     e_int check = fputwc((e_char)c, m_file);
     if (check == WEOF) throw  IOException{__func__, __LINE__, m_filePath};
 }
@@ -56,6 +82,10 @@ e_void FileWriter::write(const CharArray& buf, e_int length) {
     if (length == -1) length = buf.length();
 	if (length<0 || length>buf.length())
 		throw  IllegalArgumentException{__func__, __LINE__};
+	if (m_mode == UTF8) {
+		write(Utf8String{StringView{buf.toCArray(), length}});
+		return;
+	}
 	e_int check = fwrite(buf.toCArray(), 2, length, m_file);
     if (check < length) {
         throw  IOException{__func__, __LINE__, m_filePath};
@@ -66,12 +96,30 @@ e_void FileWriter::write(const String& str, e_int length) {
     if (length == -1) length = str.length();
 	if (length<0 || length>str.length())
 		throw IllegalArgumentException{__func__, __LINE__};
+	if (m_mode == UTF8) {
+		write(Utf8String{StringView{str.toCStr(), length}});
+		return;
+	}
 	e_int check = fwrite(str.toCStr(), 2, length, m_file);
     if (check < length) {
         throw  IOException{__func__, __LINE__, m_filePath};
     }
 }
 
+e_void FileWriter::write(const Utf8String& str, e_int length) {
+    if (length == -1) length = str.length();
+	if (length<0 || length>str.length())
+		throw IllegalArgumentException{__func__, __LINE__};
+	if (length<str.length() && (str.toCStr()[length] & 0xc0)==0x80)
+		throw IllegalArgumentException{__func__, __LINE__};
+
+	if (m_mode == UTF8) {
+		_writeBytes(str.toCStr(), length);
+	} else if (length > 0) {
+		write(length == str.length() ? str.toString() : str.substring(0, length).toString());
+	}
+}
+
 e_void FileWriter::close() {
 	if (!m_closed) {
 		e_int check = fclose(m_file);
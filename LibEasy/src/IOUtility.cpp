@@ -40,6 +40,19 @@ String IOUtility::read(const File& file) {
 	return System::move(read(file.getFullPath()));
 }
 
+Utf8String IOUtility::readUtf8(const File& file) {
+	FileReader in{file, FileReader::UTF8};
+	ByteArray buf{(e_int)file.getSize()};
+	e_int count = in.read(buf);
+	in.close();
+	if (count == 0) return Utf8String{};
+	return System::move(Utf8String{buf.toCArray(), count});
+}
+
+Utf8String IOUtility::readUtf8(const String& file) {
+	return System::move(readUtf8(File{file}));
+}
+
 
 UByteArray IOUtility::readBin(const File& file) {
 	e_int fileLen = (e_int)file.getSize();
@@ -66,6 +79,12 @@ e_void IOUtility::write(const File& file, const String& content) {
 	out.close();
 }
 
+e_void IOUtility::write(const String& file, const Utf8String& content) {
+	FileWriter out{file, FileWriter::UTF8};
+	out.write(content);
+	out.close();
+}
+
 e_void IOUtility::writeBin(const String& file, const UByteArray& content) {
 	FileOutputStream out{file};
 	out.write(content);
@@ -13,7 +13,13 @@
  * Author: Tes Alone.
 */
 
+#include <cstring>
+#include <cwchar>
+#include <emmintrin.h>
+
 #include "Integer.hpp"
+#include "StringBuffer.hpp"
+#include "EasyC.hpp"
 
 namespace Easy {
 
@@ -22,6 +28,381 @@ e_byte digitChar[16] = {
 	'8', '9', 'a', 'b', 'c', 'd', 'e', 'f'
 };
 
+static const e_byte twoDigits[201] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+static const e_ulong powersOf10[20] = {
+	1ull, 10ull, 100ull, 1000ull, 10000ull, 100000ull, 1000000ull, 10000000ull,
+	100000000ull, 1000000000ull, 10000000000ull, 100000000000ull, 1000000000000ull,
+	10000000000000ull, 100000000000000ull, 1000000000000000ull, 10000000000000000ull,
+	100000000000000000ull, 1000000000000000000ull, 10000000000000000000ull
+};
+
+/*
+	十进制位数: 位长 * log10(2) 估计出位数, 再和 10 的幂比较一次修正.
+	v | 1 不改变位数, 只是让 0 也有 1 位.
+*/
+static inline e_int decimalLength(e_ulong v) {
+	v |= 1;
+	e_int t = ((64 - __builtin_clzll(v)) * 1233) >> 12;
+	return t + (v >= powersOf10[t]);
+}
+
+template<class C>
+static inline C* writePair(C* end, e_uint pair) {
+	end -= 2;
+	end[0] = twoDigits[pair*2];
+	end[1] = twoDigits[pair*2+1];
+	return end;
+}
+
+/*
+	从 out+len 向前写, 每次写两位.
+	32 位环境中 64 位除法要调用库函数, 所以大数先用一次 64 位除法分出低 8 位, 其余都是 32 位运算.
+*/
+template<class C>
+static e_void writeDecimal(e_ulong v, C* out, e_int len) {
+	C* p = out + len;
+	while (v > 0xffffffffull) {
+		e_ulong q = v / 100000000;
+		e_uint  r = (e_uint)(v - q * 100000000);
+		for (e_int i=0; i<4; i++) {
+			p  = writePair(p, r % 100);
+			r /= 100;
+		}
+		v = q;
+	}
+
+	e_uint u = (e_uint)v;
+	while (u >= 100) {
+		p  = writePair(p, u % 100);
+		u /= 100;
+	}
+	if (u >= 10) writePair(p, u);
+	else *--p = (C)('0' + u);
+}
+
+template<class C>
+static e_int writePow2(e_ulong v, e_int shift, C* out) {
+	e_int  len  = (64 - __builtin_clzll(v | 1) + shift - 1) / shift;
+	e_uint mask = (1u << shift) - 1;
+	for (e_int i=len-1; i>=0; i--) {
+		out[i] = digitChar[v & mask];
+		v >>= shift;
+	}
+	return len;
+}
+
+template<class C>
+static e_int writeUnsigned0(e_ulong v, e_int radix, C* out) {
+	switch (radix) {
+		case 2:  return writePow2(v, 1, out);
+		case 8:  return writePow2(v, 3, out);
+		case 16: return writePow2(v, 4, out);
+		default: {
+			e_int len = decimalLength(v);
+			writeDecimal(v, out, len);
+			return len;
+		}
+	}
+}
+
+// 负数写为 '-' 加绝对值, 与 toHexString() 等一致.
+template<class C>
+static e_int writeSigned(e_long v, e_int radix, C* out) {
+	if (v >= 0) return writeUnsigned0((e_ulong)v, radix, out);
+	*out = '-';
+	return 1 + writeUnsigned0(0ull - (e_ulong)v, radix, out+1);
+}
+
+// 供 UInteger.cpp 使用.
+e_int writeUnsigned(e_ulong v, e_int radix, e_char* out) {
+	return writeUnsigned0(v, radix, out);
+}
+
+e_int writeUnsigned(e_ulong v, e_int radix, e_byte* out) {
+	return writeUnsigned0(v, radix, out);
+}
+
+/*
+	先写入栈上的块, 块满了再追加到 sb, 每个数不需要单独调用 StringBuffer::append().
+*/
+template<class T>
+static e_void appendAll(StringBuffer& sb, const T* values, e_int length, const StringView& separator) {
+	const e_int CHUNK = 1024;
+	e_char chunk[CHUNK];
+	e_int  pos    = 0;
+	e_int  sepLen = separator.length();
+
+	for (e_int i=0; i<length; i++) {
+		if (i > 0 && sepLen > 0) {
+			if (pos + sepLen > CHUNK) {
+				sb.append(StringView{chunk, pos});
+				pos = 0;
+			}
+			if (sepLen > CHUNK) {
+				sb.append(separator);
+			} else {
+				e_memcopy(chunk+pos, separator.data(), sepLen*sizeof(e_char));
+				pos += sepLen;
+			}
+		}
+		if (pos + Long::MAX_CHARS > CHUNK) {
+			sb.append(StringView{chunk, pos});
+			pos = 0;
+		}
+		pos += writeSigned(values[i], 10, chunk+pos);
+	}
+	sb.append(StringView{chunk, pos});
+}
+
+/*
+	批量解析分隔的十进制整数.
+	第一遍用 SSE2 数出分隔符, 确定字段个数; 第二遍每次分类 16 个字符, 得到分隔符和非数字字符的位掩码,
+	只有这些位置需要逐个检查, 其余字符已经确认是数字. 合法字段每次转换 8 位数字.
+*/
+static const e_int BLOCK = 16;
+
+template<class C> struct DigitLanes;
+
+template<> struct DigitLanes<e_byte> {
+	// 16 个字符中等于 delimiter 的位和是数字的位.
+	static inline e_void classify(const e_byte* chs, e_byte delimiter, e_uint& delimiters, e_uint& digits) {
+		__m128i v = _mm_loadu_si128((const __m128i*)chs);
+		__m128i x = _mm_sub_epi8(v, _mm_set1_epi8('0'));
+		__m128i nine = _mm_set1_epi8(9);
+		delimiters = _mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_set1_epi8(delimiter)));
+		digits     = _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(x, nine), nine));
+	}
+
+	// 8 个数字字符, 每个字节减去 '0'.
+	static inline e_ulong load8(const e_byte* chs) {
+		e_ulong v;
+		::memcpy(&v, chs, sizeof(v));
+		return v - 0x3030303030303030ull;
+	}
+};
+
+template<> struct DigitLanes<e_char> {
+#if WCHAR_MAX > 0xffff
+	static const e_int LANES = 4;
+	static inline __m128i eq(__m128i a, __m128i b) {return _mm_cmpeq_epi32(a, b);}
+	static inline __m128i set1(e_uint ch) {return _mm_set1_epi32(ch);}
+	static inline __m128i sub(__m128i a, __m128i b) {return _mm_sub_epi32(a, b);}
+	static inline __m128i lt(__m128i a, __m128i b) {return _mm_cmplt_epi32(a, b);}
+	static const e_uint SIGN = 0x80000000u;
+	static inline __m128i pack(const __m128i* m) {
+		return _mm_packs_epi16(_mm_packs_epi32(m[0], m[1]), _mm_packs_epi32(m[2], m[3]));
+	}
+#else
+	static const e_int LANES = 8;
+	static inline __m128i eq(__m128i a, __m128i b) {return _mm_cmpeq_epi16(a, b);}
+	static inline __m128i set1(e_uint ch) {return _mm_set1_epi16(ch);}
+	static inline __m128i sub(__m128i a, __m128i b) {return _mm_sub_epi16(a, b);}
+	static inline __m128i lt(__m128i a, __m128i b) {return _mm_cmplt_epi16(a, b);}
+	static const e_uint SIGN = 0x8000u;
+	static inline __m128i pack(const __m128i* m) {
+		return _mm_packs_epi16(m[0], m[1]);
+	}
+#endif
+
+	// 比较结果在原宽度下得到, 再饱和压缩为每个字符一个字节, 大于 0xff 的字符不会被误认.
+	static inline e_void classify(const e_char* chs, e_char delimiter, e_uint& delimiters, e_uint& digits) {
+		const e_int VECTORS = BLOCK / LANES;
+		__m128i delim = set1(delimiter);
+		__m128i zero  = set1('0');
+		__m128i sign  = set1(SIGN);
+		__m128i limit = set1(SIGN + 10);	// 加上符号位后用有符号比较代替无符号比较
+		__m128i d[VECTORS], g[VECTORS];
+		for (e_int i=0; i<VECTORS; i++) {
+			__m128i v = _mm_loadu_si128((const __m128i*)(chs + i*LANES));
+			d[i] = eq(v, delim);
+			g[i] = lt(_mm_xor_si128(sub(v, zero), sign), limit);
+		}
+		delimiters = _mm_movemask_epi8(pack(d));
+		digits     = _mm_movemask_epi8(pack(g));
+	}
+
+	static inline e_ulong load8(const e_char* chs) {
+		const e_int VECTORS = 8 / LANES;
+		__m128i v[2];
+		for (e_int i=0; i<VECTORS; i++)
+			v[i] = _mm_loadu_si128((const __m128i*)(chs + i*LANES));
+#if WCHAR_MAX > 0xffff
+		__m128i packed = _mm_packs_epi32(v[0], v[1]);
+#else
+		__m128i packed = v[0];
+#endif
+		return (e_ulong)_mm_cvtsi128_si64(_mm_packus_epi16(packed, packed)) - 0x3030303030303030ull;
+	}
+};
+
+// 8 个数字 (低地址为高位) 合并为一个数, 每步把相邻的两组合并.
+template<class C>
+static inline e_uint eightDigits(const C* chs) {
+	e_ulong v = DigitLanes<C>::load8(chs);
+	v = (v * 10) + (v >> 8);
+	v = (((v & 0x000000ff000000ffull) * (100 + (1000000ull << 32))) +
+	     (((v >> 16) & 0x000000ff000000ffull) * (1 + (10000ull << 32)))) >> 32;
+	return (e_uint)v;
+}
+
+// n 个已经确认的数字, n <= 19.
+template<class C>
+static inline e_ulong parseDigits(const C* chs, e_int n) {
+	e_ulong v = 0;
+	for (; n >= 8; n -= 8, chs += 8) v = v * 100000000 + eightDigits(chs);
+	for (; n > 0; n--, chs++) v = v * 10 + (*chs - '0');
+	return v;
+}
+
+template<class C>
+static e_int countDelimiters(const C* chs, e_int length, C delimiter) {
+	e_int count = 0;
+	e_int i = 0;
+	for (; i+BLOCK <= length; i+=BLOCK) {
+		e_uint delimiters, digits;
+		DigitLanes<C>::classify(chs+i, delimiter, delimiters, digits);
+		count += __builtin_popcount(delimiters);
+	}
+	for (; i<length; i++) {
+		if (chs[i] == delimiter) count++;
+	}
+	return count;
+}
+
+/*
+	T 为 e_int 或 e_long. MAX_DIGITS 为 T 的最大值的十进制位数,
+	位数更少的数一定不会溢出.
+*/
+template<class T> struct FieldLimits;
+template<> struct FieldLimits<e_int>  {static const e_int MAX_DIGITS = 10; static const e_ulong MAX = INT32_MAX;};
+template<> struct FieldLimits<e_long> {static const e_int MAX_DIGITS = 19; static const e_ulong MAX = INT64_MAX;};
+
+template<class T, class C>
+class FieldParser {
+public:
+	FieldParser(const C* chs, T* values, e_int* errors)
+		: m_chs(chs), m_values(values), m_errors(errors), m_field(0), m_failed(0), m_start(0), m_bad(-1) {}
+
+	// 处理一个分隔符或非数字字符.
+	inline e_void visit(e_int pos, e_bool isDelimiter) {
+		if (isDelimiter) {
+			finish(pos);
+			m_start = pos + 1;
+			m_bad   = -1;
+		} else if (m_bad == -1 && !(pos == m_start && (m_chs[pos] == '-' || m_chs[pos] == '+'))) {
+			m_bad = pos;
+		}
+	}
+
+	// 结束 [m_start, end) 的字段.
+	e_void finish(e_int end) {
+		T     value = 0;
+		e_int error = m_bad;
+		if (error == -1) error = convert(end, value);
+		m_values[m_field] = value;
+		m_errors[m_field] = error;
+		if (error != -1) m_failed++;
+		m_field++;
+	}
+
+	inline e_int failed() const {return m_failed;}
+
+private:
+	const C* m_chs;
+	T*       m_values;
+	e_int*   m_errors;
+	e_int    m_field;
+	e_int    m_failed;
+	e_int    m_start;
+	e_int    m_bad;
+
+	// 字段中只有数字和开头的符号, 返回错误位置或 -1.
+	e_int convert(e_int end, T& value) {
+		typedef FieldLimits<T> L;
+		e_int  i = m_start;
+		e_bool negative = false;
+
+		if (i < end && (m_chs[i] == '-' || m_chs[i] == '+')) {
+			negative = m_chs[i] == '-';
+			i++;
+		}
+		if (i == end) return end;	// 空字段或只有符号
+		while (i < end-1 && m_chs[i] == '0') i++;
+
+		e_ulong limit = negative ? L::MAX + 1 : L::MAX;
+		e_int   n     = end - i;
+		if (n > L::MAX_DIGITS) {
+			// 前 MAX_DIGITS 位已经超出范围时, 错误在最后一位, 否则在下一位.
+			return parseDigits(m_chs+i, L::MAX_DIGITS) > limit ? i + L::MAX_DIGITS - 1 : i + L::MAX_DIGITS;
+		}
+
+		e_ulong v = parseDigits(m_chs+i, n);
+		if (v > limit) return end - 1;
+		value = negative ? (T)(0 - v) : (T)v;
+		return -1;
+	}
+};
+
+template<class T, class C>
+static e_int parseFields(const C* chs, e_int length, C delimiter, BasicArray<T>& values, IntArray& errors) {
+	if (chs == nullptr && length > 0)
+		throw NullPointerException{__func__, __LINE__};
+
+	e_int count = length <= 0 ? 0 : countDelimiters(chs, length, delimiter) + 1;
+	values = BasicArray<T>{count};
+	errors = IntArray{count};
+	if (count == 0) return 0;
+
+	FieldParser<T, C> parser{chs, values.toCArray(), errors.toCArray()};
+	e_int i = 0;
+	for (; i+BLOCK <= length; i+=BLOCK) {
+		e_uint delimiters, digits;
+		DigitLanes<C>::classify(chs+i, delimiter, delimiters, digits);
+		e_uint special = delimiters | (~digits & 0xffff);
+		while (special != 0) {
+			e_int bit = __builtin_ctz(special);
+			parser.visit(i + bit, (delimiters >> bit) & 1);
+			special &= special - 1;
+		}
+	}
+	for (; i<length; i++) {
+		if (chs[i] == delimiter || chs[i] < '0' || chs[i] > '9')
+			parser.visit(i, chs[i] == delimiter);
+	}
+	parser.finish(length);
+
+	return parser.failed();
+}
+
+e_int Integer::writeTo(e_int i, e_char* out, e_int radix) {
+	return writeSigned(i, radix, out);
+}
+
+e_int Integer::writeTo(e_int i, e_byte* out, e_int radix) {
+	return writeSigned(i, radix, out);
+}
+
+StringBuffer& Integer::appendTo(StringBuffer& sb, e_int i, e_int radix) {
+	e_char buf[MAX_CHARS];
+	return sb.append(StringView{buf, writeSigned(i, radix, buf)});
+}
+
+StringBuffer& Integer::appendTo(StringBuffer& sb, const IntArray& values, const StringView& separator) {
+	appendAll(sb, values.toCArray(), values.length(), separator);
+	return sb;
+}
+
 String Integer::toString(e_int i, e_int radix) {
 	if (radix == 2) {
 		return toBinaryString(i);
@@ -36,103 +417,23 @@ String Integer::toString(e_int i, e_int radix) {
 }
 
 String Integer::toHexString(e_int i) {
-    e_char buf[11];
-    e_bool negative = (i < 0);
-    e_int charPos = 9;
-    
-    buf[10] = 0;
-    
-    if (!negative) {
-        i = -i;
-    }
-    
-    while (i <= -16) {
-        buf[charPos--] = digitChar[-(i % 16)];
-        i = i / 16;
-    }
-    
-    buf[charPos] = digitChar[-i];
-    
-    if (negative) {
-        buf[--charPos] = '-';
-    }
-	
-    return String(&buf[charPos]);
+	e_char buf[MAX_CHARS];
+	return System::move(String{StringView{buf, writeTo(i, buf, 16)}});
 }
 
 String Integer::toString(e_int i) {
-	e_char buf[12];
-    e_bool negative = (i < 0);
-    e_int charPos = 10;
-    
-    buf[11] = 0;
-    
-    if (!negative) {
-        i = -i;
-    }
-    
-    while (i <= -10) {
-        buf[charPos--] = digitChar[-(i % 10)];
-        i = i / 10;
-    }
-    
-    buf[charPos] = digitChar[-i];
-    
-    if (negative) {
-        buf[--charPos] = '-';
-    }
-	
-    return String(&buf[charPos]);
+	e_char buf[MAX_CHARS];
+	return System::move(String{StringView{buf, writeTo(i, buf)}});
 }
 
 String Integer::toOctString(e_int i) {
-	e_char buf[14];
-    e_bool negative = (i < 0);
-    e_int charPos = 13;
-    
-    buf[13] = 0;
-    
-    if (!negative) {
-        i = -i;
-    }
-    
-    while (i <= -8) {
-        buf[charPos--] = digitChar[-(i % 8)];
-        i = i / 8;
-    }
-    
-    buf[charPos] = digitChar[-i];
-    
-    if (negative) {
-        buf[--charPos] = '-';
-    }
-	
-    return String(&buf[charPos]);
+	e_char buf[MAX_CHARS];
+	return System::move(String{StringView{buf, writeTo(i, buf, 8)}});
 }
 
 String Integer::toBinaryString(e_int i) {
-	e_char buf[66];
-    e_bool negative = (i < 0);
-    e_int charPos = 64;
-    
-    buf[65] = 0;
-    
-    if (!negative) {
-        i = -i;
-    }
-    
-    while (i <= -2) {
-        buf[charPos--] = digitChar[-(i % 2)];
-        i = i / 2;
-    }
-    
-    buf[charPos] = digitChar[-i];
-    
-    if (negative) {
-        buf[--charPos] = '-';
-    }
-	
-    return String(&buf[charPos]);
+	e_char buf[MAX_CHARS];
+	return System::move(String{StringView{buf, writeTo(i, buf, 2)}});
 }
 
 e_int Integer::parse(const String& s) {		
@@ -339,6 +640,32 @@ e_int Integer::parse(const String& s, e_int radix) {
 	return parse(s);
 }
 
+e_int Integer::parse(const e_char* chs, e_int length, e_char delimiter, IntArray& values, IntArray& errors) {
+	return parseFields(chs, length, delimiter, values, errors);
+}
+
+e_int Integer::parse(const e_byte* chs, e_int length, e_byte delimiter, IntArray& values, IntArray& errors) {
+	return parseFields(chs, length, delimiter, values, errors);
+}
+
+e_int Long::writeTo(e_long l, e_char* out, e_int radix) {
+	return writeSigned(l, radix, out);
+}
+
+e_int Long::writeTo(e_long l, e_byte* out, e_int radix) {
+	return writeSigned(l, radix, out);
+}
+
+StringBuffer& Long::appendTo(StringBuffer& sb, e_long l, e_int radix) {
+	e_char buf[MAX_CHARS];
+	return sb.append(StringView{buf, writeSigned(l, radix, buf)});
+}
+
+StringBuffer& Long::appendTo(StringBuffer& sb, const LongArray& values, const StringView& separator) {
+	appendAll(sb, values.toCArray(), values.length(), separator);
+	return sb;
+}
+
 String Long::toString(e_long l, e_int radix) {
 	if (radix == 2) {
 		return toBinaryString(l);
@@ -353,103 +680,23 @@ String Long::toString(e_long l, e_int radix) {
 }
 
 String Long::toString(e_long l) {
-	e_char buf[21];
-    e_bool negative = (l < 0);
-    e_int charPos = 19;
-    
-    buf[20] = 0;
-    
-    if (!negative) {
-        l = -l;
-    }
-    
-    while (l <= -10) {
-        buf[charPos--] = digitChar[-(l % 10)];
-        l = l / 10;
-    }
-    
-    buf[charPos] = digitChar[-l];
-    
-    if (negative) {
-        buf[--charPos] = '-';
-    }
-	
-    return String(&buf[charPos]);
+	e_char buf[MAX_CHARS];
+	return System::move(String{StringView{buf, writeTo(l, buf)}});
 }
 
 String Long::toHexString(e_long l) {
-    e_char buf[18];
-    e_bool negative = (l < 0);
-    e_int charPos = 16;
-    
-    buf[17] = 0;
-    
-    if (!negative) {
-        l = -l;
-    }
-    
-    while (l <= -16) {
-        buf[charPos--] = digitChar[-(l % 16)];
-        l = l / 16;
-    }
-    
-    buf[charPos] = digitChar[-l];
-    
-    if (negative) {
-        buf[--charPos] = '-';
-    }
-	
-    return String(&buf[charPos]);
+	e_char buf[MAX_CHARS];
+	return System::move(String{StringView{buf, writeTo(l, buf, 16)}});
 }
 
 String Long::toOctString(e_long l) {
-    e_char buf[23];
-    e_bool negative = (l < 0);
-    e_int charPos = 21;
-    
-    buf[22] = 0;
-    
-    if (!negative) {
-        l = -l;
-    }
-    
-    while (l <= -8) {
-        buf[charPos--] = digitChar[-(l % 8)];
-        l = l / 8;
-    }
-    
-    buf[charPos] = digitChar[-l];
-    
-    if (negative) {
-        buf[--charPos] = '-';
-    }
-	
-    return String(&buf[charPos]);
+	e_char buf[MAX_CHARS];
+	return System::move(String{StringView{buf, writeTo(l, buf, 8)}});
 }
 
 String Long::toBinaryString(e_long l) {
-    e_char buf[67];
-    e_bool negative = (l < 0);
-    e_int charPos = 65;
-    
-    buf[66] = 0;
-    
-    if (!negative) {
-        l = -l;
-    }
-    
-    while (l <= -2) {
-        buf[charPos--] = digitChar[-(l % 2)];
-        l = l / 2;
-    }
-    
-    buf[charPos] = digitChar[-l];
-    
-    if (negative) {
-        buf[--charPos] = '-';
-    }
-	
-    return String(&buf[charPos]);
+	e_char buf[MAX_CHARS];
+	return System::move(String{StringView{buf, writeTo(l, buf, 2)}});
 }
 
 e_long Long::parse(const String& s) {
@@ -645,4 +892,12 @@ e_long Long::parse(const String& s, e_int radix) {
 	return parse(s);
 }
 
+e_int Long::parse(const e_char* chs, e_int length, e_char delimiter, LongArray& values, IntArray& errors) {
+	return parseFields(chs, length, delimiter, values, errors);
+}
+
+e_int Long::parse(const e_byte* chs, e_int length, e_byte delimiter, LongArray& values, IntArray& errors) {
+	return parseFields(chs, length, delimiter, values, errors);
+}
+
 } // Easy
\ No newline at end of file
@@ -38,7 +38,7 @@ SharedPointer<Node> NodeList::addNodeByTag(const String& tag) {
 	if (tag.empty()) {
 		throw IllegalArgumentException{__func__, __LINE__};
 	}
-	return m_nodes.add(SharedPointer<Node>{new Node{tag}});
+	return m_nodes.emplace(new Node{tag});
 }
 
 
@@ -76,18 +76,12 @@ SharedPointer<Node> NodeList::getNodeByAttr(const String& name, const String& va
 	if (name.empty() || value.empty()) {
 		throw IllegalArgumentException{__func__, __LINE__};
 	}
-	for (e_int i=0; i<m_nodes.size(); i++) {
+	InternedString key = StringPool::global().lookup(name);
+	for (e_int i=0; !key.isNull() && i<m_nodes.size(); i++) {
 		SharedPointer<Node>& node = m_nodes.get(i);
-		AttrMap& attrs = node->getAttrMap();
-		try {
-			String attrValue = attrs.getAttr(name);
-			if (attrValue.equals(value)) {
-				return node;
-			}
-		} catch (HasNoSuchAttrException& e) {
-			throw HasNoSuchNodeException{__func__, __LINE__, m_parent,
-						 String{L"which has attribute '"} 
-						 	+ name + String{L"' with value '"} + value + String{L"'"}};
+		String* attrValue = node->getAttrMap().tryGetAttr(key);
+		if (attrValue && attrValue->equals(value)) {
+			return node;
 		}
 	}
 	
@@ -100,9 +94,10 @@ SharedPointer<Node> NodeList::getNodeByTag(const String& tag) const {
 	if (tag.empty()) {
 		throw IllegalArgumentException{__func__, __LINE__};
 	}
-	for (e_int i=0; i<m_nodes.size(); i++) {
+	InternedString key = StringPool::global().lookup(tag);
+	for (e_int i=0; !key.isNull() && i<m_nodes.size(); i++) {
 		SharedPointer<Node>& node = m_nodes.get(i);
-		if (node->getTag().equals(tag)) {
+		if (node->getInternedTag().equals(key)) {
 			return node;
 		}
 	}
@@ -122,7 +117,7 @@ e_void AttrMap::addAttr(const String& name, const String& value) {
 	if (name.empty()) {
 		throw IllegalArgumentException{__func__, __LINE__};
 	}
-	m_map.put(name, value);
+	m_map.put(StringPool::global().intern(name), value);
 }
 
 e_void AttrMap::removeAttr(const String& name) {
@@ -130,7 +125,7 @@ e_void AttrMap::removeAttr(const String& name) {
 		throw IllegalArgumentException{__func__, __LINE__};
 	}
 	try {
-		m_map.remove(name);
+		m_map.remove(StringPool::global().lookup(name));
 	} catch (HasNoSuchElementException& e) {
 		throw  HasNoSuchAttrException{__func__, __LINE__, m_node, name};
 	}
@@ -140,11 +135,36 @@ String& AttrMap::getAttr(const String& name) const {
 	if (name.empty()) {
 		throw IllegalArgumentException{__func__, __LINE__};
 	}
-	try {
-		return m_map.get(name);
-	} catch (HasNoSuchElementException& e) {
+	String* value = m_map.tryGet(StringPool::global().lookup(name));
+	if (value == nullptr) {
 		throw HasNoSuchAttrException{__func__, __LINE__, m_node, name};
 	}
+	return *value;
+}
+
+String& AttrMap::getAttr(const InternedString& name) const {
+	if (name.isNull()) {
+		throw IllegalArgumentException{__func__, __LINE__};
+	}
+	String* value = m_map.tryGet(name);
+	if (value == nullptr) {
+		throw HasNoSuchAttrException{__func__, __LINE__, m_node, name.get()};
+	}
+	return *value;
+}
+
+String* AttrMap::tryGetAttr(const String& name) const {
+	if (name.empty()) {
+		throw IllegalArgumentException{__func__, __LINE__};
+	}
+	return m_map.tryGet(StringPool::global().lookup(name));
+}
+
+String* AttrMap::tryGetAttr(const InternedString& name) const {
+	if (name.isNull()) {
+		throw IllegalArgumentException{__func__, __LINE__};
+	}
+	return m_map.tryGet(name);
 }
 
 e_int AttrMap::getLength()const {
@@ -152,17 +172,25 @@ e_int AttrMap::getLength()const {
 }
 
 HashSet<String> AttrMap::listAttrs() {	
-	return System::move(m_map.keySet());
+	HashSet<String> names;
+	AutoPointer<Iterator<MapEntry<InternedString, String>>> iter{m_map.iterator()};
+	while (!iter->isEnd()) {
+		names.add(iter->current().m_key.get());
+		iter->advance();
+	}
+	return System::move(names);
 }
 
 Node::Node() {
 	m_tag     = System::move(String{L"default"});
+	m_tagId   = StringPool::global().intern(m_tag);
 	m_nodes   = System::move(NodeList{m_tag});
 	m_attrs   = System::move(AttrMap{m_tag});
 }
 
 Node::Node(const String& tag) {
 	m_tag     = tag;
+	m_tagId   = StringPool::global().intern(m_tag);
 	m_nodes   = System::move(NodeList{m_tag});
 	m_attrs   = System::move(AttrMap{m_tag});
 }
@@ -171,7 +199,8 @@ e_void Node::setTag(const String& tag) {
 	if (tag.empty()) {
 		throw IllegalArgumentException{__func__, __LINE__};
 	}
-	m_tag = tag;
+	m_tag   = tag;
+	m_tagId = StringPool::global().intern(m_tag);
 }
 
 e_void Node::setContent(const String& content) {
@@ -191,6 +220,10 @@ const String& Node::getTag() const {
 	return m_tag;
 }
 
+const InternedString& Node::getInternedTag() const {
+	return m_tagId;
+}
+
 const String& Node::getContent() const {
 	return m_content;
 }
@@ -198,7 +231,7 @@ const String& Node::getContent() const {
 static e_void save0(SharedPointer<Node> parent, FileWriter& out, e_int depth);
 
 e_void  Node::save(const String& out){
-	FileWriter fw{out};
+	FileWriter fw{out, FileWriter::UTF8};
 	save0(sharedFromThis(), fw, -1);
 	fw.close();
 }
@@ -218,6 +251,7 @@ String Node::toString() const {
 	return System::move(String{m_tag});
 }
 
+// UTF-8 写入不转换换行符, 直接写 \r\n, 与文本模式写入相同.
 static e_void save0(SharedPointer<Node> parent, FileWriter& out, e_int depth) {
 	depth++;
 	out.write(String{L"\t"} * depth);
@@ -236,26 +270,26 @@ static e_void save0(SharedPointer<Node> parent, FileWriter& out, e_int depth) {
 	}
 	
 	if (parent->getNodeList().getLength()==0 && parent->getContent().empty()) {
-		out.write(String{L"/>\n"});
+		out.write(String{L"/>\r\n"});
 		return;
 	} else if (parent->getNodeList().getLength() > 0) {
-		out.write(String{L">\n"});
+		out.write(String{L">\r\n"});
 		NodeList& nodeList = parent->getNodeList();
 		for (e_int i=0; i<nodeList.getLength(); i++) {
 			SharedPointer<Node> node = nodeList.getNodeAt(i);
 			save0(node, out, depth);
 		}
 	} else if (!parent->getContent().empty()) {
-		out.write(String{L">\n"});
+		out.write(String{L">\r\n"});
 		out.write(String{L"\t"} * (depth+1));
 		out.write(parent->getContent());
-		out.write(String{L"\n"});
+		out.write(String{L"\r\n"});
 	}
 	
 	out.write(String{L"\t"} * depth);
 	out.write(String{L"</"});
 	out.write(parent->getTag());
-	out.write(String{L">\n"});
+	out.write(String{L">\r\n"});
 }
 
 /*
@@ -429,7 +463,9 @@ e_void Lexer::_filterWhiteSpace() {
 
 String Lexer::_getText(const String& fileName) {
 	try {
-		return System::move(IOUtility::read(fileName));
+		// 二进制读取不转换换行符, 在这里把 \r\n 变为 \n, 与文本模式读取相同.
+		Utf8String text = IOUtility::readUtf8(fileName).replace(Utf8String{"\r\n"}, Utf8String{"\n"});
+		return System::move(text.toString());
 	} catch (Exception& e) {
 		error(m_fileName, String{L"错误: 文件 "} + fileName + String{L" 读取失败!"});
 		return String{}; //never arrive here.
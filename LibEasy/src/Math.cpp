@@ -14,11 +14,15 @@
 */
 
 #include <cmath> // FIXME
+#include <cfloat>
+#include <emmintrin.h>
 
 #include "Math.hpp"
 #include "Integer.hpp"
 #include "Float.hpp"
 #include "AsmLib.hpp"
+#include "Random.hpp"
+#include "BasicArray.hpp"
 
 #include "Console.hpp"
 
@@ -290,51 +294,422 @@ e_double Math::mod(e_double d, e_double m) {
 	return _fmod(Math::abs(d), m);
 }
 
+// ------------------------------------
+
+constexpr e_double Math::BATCH_TRIG_LIMIT;
+
+/*
+	批量函数的核心. 每个 Kernel 提供:
+	apply() 用 SSE2 同时计算 2 个元素; special() 返回 apply() 不能处理的元素的掩码;
+	scalar() 计算这样的元素.
+*/
+template<class Kernel>
+static e_void mapArray(const DoubleArray& values, DoubleArray& results) {
+	e_int len = values.length();
+	if (results.length() != len) results = DoubleArray{len};
+
+	const e_double* in = values.toCArray();
+	e_double* out      = results.toCArray();
+	e_int i = 0;
+
+	for (; i+2 <= len; i+=2) {
+		__m128d x  = _mm_loadu_pd(in+i);
+		e_int mask = Kernel::special(x);
+		_mm_storeu_pd(out+i, Kernel::apply(x));
+		if (mask != 0) {
+			e_double xs[2];
+			_mm_storeu_pd(xs, x);
+			if (mask & 1) out[i]   = Kernel::scalar(xs[0]);
+			if (mask & 2) out[i+1] = Kernel::scalar(xs[1]);
+		}
+	}
+	if (i < len) {
+		__m128d x = _mm_load_sd(in+i);
+		e_double x0 = in[i];
+		_mm_store_sd(out+i, Kernel::apply(x));
+		if (Kernel::special(x) & 1) out[i] = Kernel::scalar(x0);
+	}
+}
+
+static inline __m128d set1(e_double d) {
+	return _mm_set1_pd(d);
+}
+
+static inline __m128d signMask() {
+	return _mm_castsi128_pd(_mm_set1_epi64x(0x8000000000000000LL));
+}
+
+// s = a + b 的舍入结果, 返回精确的舍入误差 a + b - s (Knuth TwoSum, 不要求 |a| >= |b|).
+static inline __m128d twoSum(__m128d a, __m128d b, __m128d& s) {
+	s = _mm_add_pd(a, b);
+	__m128d bb = _mm_sub_pd(s, a);
+	return _mm_add_pd(_mm_sub_pd(a, _mm_sub_pd(s, bb)), _mm_sub_pd(b, bb));
+}
+
+// c[0]*x^(N-1) + ... + c[N-1], Horner 法.
+template<e_int N>
+static inline __m128d polynomial(__m128d x, const e_double (&c)[N]) {
+	__m128d r = set1(c[0]);
+	for (e_int i=1; i<N; i++) r = _mm_add_pd(_mm_mul_pd(r, x), set1(c[i]));
+	return r;
+}
+
+/*
+	正弦和余弦 (Cephes sin.c): 取 j 为 |x|*4/pi 向上取的偶数, z = |x| - j*pi/4,
+	j/2 的低两位决定用哪个多项式和结果的符号.
+	<br/>
+	x 接近 pi/2 的倍数时 z 很小, 约简必须远比 53 位精确 (Cody-Waite). pi/4 分成四段,
+	前三段各不超过 32 位有效位, |x| <= BATCH_TRIG_LIMIT 时 j < 2^21, j*DP1 ~ j*DP3 都是精确的.
+	只有 x - j*DP1 保证没有舍入 (Sterbenz), 之后的减法都会舍入, 所以 z 用 double-double (z + zlo) 表示:
+	减 j*DP2 时用 TwoSum 保留舍入误差, j*DP3 和 j*DP4 只影响低位, 直接累加到 zlo.
+	<br/>
+	多项式只对 z 计算, zlo 按一阶导数修正: sin(z+zlo) ~ sin(z) + zlo*cos(z), cos(z+zlo) ~ cos(z) - zlo*sin(z).
+	cos 的 1 - z*z/2 也补上舍入误差 (fdlibm __kernel_cos).
+*/
+static const e_double FOUR_OVER_PI = 1.27323954473516268615;
+static const e_double DP1 = 7.85398163367062807083E-1;
+static const e_double DP2 = 3.03855025315198298830E-11;
+static const e_double DP3 = 1.01113312435558322790E-21;
+static const e_double DP4 = 4.23921383018444978499E-32;
+
+static const e_double SIN_COEFS[6] = {
+	1.58962301576546568060E-10, -2.50507477628578072866E-8, 2.75573136213857245213E-6,
+	-1.98412698295895385996E-4, 8.33333333332211858878E-3, -1.66666666666666307295E-1,
+};
+
+static const e_double COS_COEFS[6] = {
+	-1.13585365213876817300E-11, 2.08757008419747316778E-9, -2.75573141792967388112E-7,
+	2.48015872888517045348E-5, -1.38888888888730564116E-3, 4.16666666666665929218E-2,
+};
+
+template<e_bool COSINE>
+struct TrigKernel {
+	static inline __m128d apply(__m128d x) {
+		__m128d ax = _mm_andnot_pd(signMask(), x);
+		__m128i j  = _mm_cvttpd_epi32(_mm_mul_pd(ax, set1(FOUR_OVER_PI)));
+		j = _mm_and_si128(_mm_add_epi32(j, _mm_set1_epi32(1)), _mm_set1_epi32(-2));
+		__m128d y = _mm_cvtepi32_pd(j);
+
+		__m128d z1 = _mm_sub_pd(ax, _mm_mul_pd(y, set1(DP1)));
+		__m128d z2;
+		__m128d zlo = twoSum(z1, _mm_mul_pd(y, set1(-DP2)), z2);
+		zlo = _mm_sub_pd(zlo, _mm_mul_pd(y, set1(DP3)));
+		zlo = _mm_sub_pd(zlo, _mm_mul_pd(y, set1(DP4)));
+		// z2 因抵消接近 0 时 zlo 可能比它大, 所以重新规格化也用 TwoSum.
+		__m128d z;
+		zlo = twoSum(z2, zlo, z);
+		__m128d zz = _mm_mul_pd(z, z);
+		__m128d hz = _mm_mul_pd(zz, set1(0.5));
+
+		__m128d ps = _mm_mul_pd(_mm_mul_pd(z, zz), polynomial(zz, SIN_COEFS));
+		ps = _mm_add_pd(ps, _mm_sub_pd(zlo, _mm_mul_pd(hz, zlo)));
+		ps = _mm_add_pd(z, ps);
+
+		__m128d w  = _mm_sub_pd(set1(1.0), hz);
+		__m128d pc = _mm_mul_pd(_mm_mul_pd(zz, zz), polynomial(zz, COS_COEFS));
+		pc = _mm_sub_pd(pc, _mm_mul_pd(z, zlo));
+		pc = _mm_add_pd(pc, _mm_sub_pd(_mm_sub_pd(set1(1.0), w), hz));
+		pc = _mm_add_pd(w, pc);
+
+		// 把每个 j 复制到 64 位通道的高低两半.
+		__m128i jj   = _mm_shuffle_epi32(j, _MM_SHUFFLE(1,1,0,0));
+		__m128d swap = _mm_castsi128_pd(_mm_cmpeq_epi32(_mm_and_si128(jj, _mm_set1_epi32(2)), _mm_set1_epi32(2)));
+		__m128d r;
+		__m128i sign;
+		if (COSINE) {
+			r    = _mm_or_pd(_mm_and_pd(swap, ps), _mm_andnot_pd(swap, pc));
+			sign = _mm_slli_epi64(_mm_and_si128(_mm_add_epi32(jj, _mm_set1_epi32(2)), _mm_set1_epi64x(4)), 61);
+		} else {
+			r    = _mm_or_pd(_mm_and_pd(swap, pc), _mm_andnot_pd(swap, ps));
+			sign = _mm_slli_epi64(_mm_and_si128(jj, _mm_set1_epi64x(4)), 61);
+			sign = _mm_xor_si128(sign, _mm_castpd_si128(_mm_and_pd(signMask(), x)));
+		}
+		return _mm_xor_pd(r, _mm_castsi128_pd(sign));
+	}
+
+	// NaN 和 cmpnle 比较的结果也是真.
+	static inline e_int special(__m128d x) {
+		return _mm_movemask_pd(_mm_cmpnle_pd(_mm_andnot_pd(signMask(), x), set1(Math::BATCH_TRIG_LIMIT)));
+	}
+
+	static inline e_double scalar(e_double d) {
+		return COSINE ? ::cos(d) : ::sin(d);
+	}
+};
+
+/*
+	e 的幂 (Cephes exp.c): x = k*ln2 + r, ln2 分成两段;
+	e^r = 1 + 2*P(r^2)*r / (Q(r^2) - P(r^2)*r), 再把 k 加到指数位上.
+*/
+static const e_double LOG2E = 1.4426950408889634073599;
+static const e_double EXP_C1 = 6.93145751953125E-1;
+static const e_double EXP_C2 = 1.42860682030941723212E-6;
+static const e_double EXP_LIMIT = 708.0;
+
+static const e_double EXP_P[3] = {
+	1.26177193074810590878E-4, 3.02994407707441961300E-2, 9.99999999999999999910E-1,
+};
+
+static const e_double EXP_Q[4] = {
+	3.00198505138664455042E-6, 2.52448340349684104192E-3, 2.27265548208155028766E-1, 2.00000000000000000009E0,
+};
+
+struct ExpKernel {
+	static inline __m128d apply(__m128d x) {
+		__m128i k  = _mm_cvtpd_epi32(_mm_mul_pd(x, set1(LOG2E)));
+		__m128d kd = _mm_cvtepi32_pd(k);
+
+		__m128d r  = _mm_sub_pd(x, _mm_mul_pd(kd, set1(EXP_C1)));
+		r = _mm_sub_pd(r, _mm_mul_pd(kd, set1(EXP_C2)));
+		__m128d rr = _mm_mul_pd(r, r);
+		__m128d px = _mm_mul_pd(r, polynomial(rr, EXP_P));
+		__m128d qx = polynomial(rr, EXP_Q);
+		r = _mm_div_pd(px, _mm_sub_pd(qx, px));
+		r = _mm_add_pd(set1(1.0), _mm_add_pd(r, r));
+
+		// 2^k: 带偏移的指数放到 64 位通道的第 52 位.
+		__m128i biased = _mm_add_epi32(k, _mm_set1_epi32(1023));
+		__m128i scale  = _mm_slli_epi64(_mm_unpacklo_epi32(biased, _mm_setzero_si128()), 52);
+		return _mm_mul_pd(r, _mm_castsi128_pd(scale));
+	}
+
+	static inline e_int special(__m128d x) {
+		return _mm_movemask_pd(_mm_cmpnle_pd(_mm_andnot_pd(signMask(), x), set1(EXP_LIMIT)));
+	}
+
+	static inline e_double scalar(e_double d) {
+		return ::exp(d);
+	}
+};
+
+/*
+	自然对数 (fdlibm e_log.c): x = 2^e * m, sqrt(2)/2 <= m < sqrt(2), f = m - 1, s = f / (2+f),
+	ln(m) = f - (f^2/2 - s*(f^2/2 + R(s^2))), R 按奇偶项分成两个多项式并行计算, ln2 分成两段和 e 相乘.
+*/
+static const e_double SQRTH  = 0.70710678118654752440;
+static const e_double LN2_HI = 6.93147180369123816490e-01;
+static const e_double LN2_LO = 1.90821492927058770002e-10;
+
+static const e_double LOG_ODD[4] = {
+	1.479819860511658591e-01, 1.818357216161805012e-01, 2.857142874366239149e-01, 6.666666666666735130e-01,
+};
+
+static const e_double LOG_EVEN[3] = {
+	1.531383769920937332e-01, 2.222219843214978396e-01, 3.999999999940941908e-01,
+};
+
+struct LogKernel {
+	static inline __m128d apply(__m128d x) {
+		__m128i bits = _mm_castpd_si128(x);
+		__m128i e32  = _mm_shuffle_epi32(_mm_srli_epi64(bits, 52), _MM_SHUFFLE(3,1,2,0));
+		__m128d e    = _mm_sub_pd(_mm_cvtepi32_pd(e32), set1(1022.0));
+		__m128d m    = _mm_castsi128_pd(_mm_or_si128(
+			_mm_and_si128(bits, _mm_set1_epi64x(0x000fffffffffffffLL)), _mm_set1_epi64x(0x3fe0000000000000LL)));
+
+		// m 在 [0.5, 1) 中, 小于 sqrt(2)/2 时改为 2m, 指数减 1.
+		__m128d small = _mm_cmplt_pd(m, set1(SQRTH));
+		e = _mm_sub_pd(e, _mm_and_pd(small, set1(1.0)));
+		__m128d f = _mm_add_pd(_mm_sub_pd(m, set1(1.0)), _mm_and_pd(small, m));
+		__m128d s = _mm_div_pd(f, _mm_add_pd(set1(2.0), f));
+		__m128d z = _mm_mul_pd(s, s);
+		__m128d w = _mm_mul_pd(z, z);
+
+		__m128d r    = _mm_add_pd(_mm_mul_pd(z, polynomial(w, LOG_ODD)), _mm_mul_pd(w, polynomial(w, LOG_EVEN)));
+		__m128d hfsq = _mm_mul_pd(_mm_mul_pd(f, f), set1(0.5));
+		__m128d y    = _mm_add_pd(_mm_mul_pd(s, _mm_add_pd(hfsq, r)), _mm_mul_pd(e, set1(LN2_LO)));
+		y = _mm_sub_pd(f, _mm_sub_pd(hfsq, y));
+		return _mm_add_pd(_mm_mul_pd(e, set1(LN2_HI)), y);
+	}
+
+	// 0, 负数, 非规格化数, 无穷大和 NaN.
+	static inline e_int special(__m128d x) {
+		return _mm_movemask_pd(_mm_or_pd(_mm_cmpnge_pd(x, set1(DBL_MIN)), _mm_cmpnle_pd(x, set1(DBL_MAX))));
+	}
+
+	static inline e_double scalar(e_double d) {
+		return ::log(d);
+	}
+};
+
+struct SqrtKernel {
+	static inline __m128d apply(__m128d x) {return _mm_sqrt_pd(x);}
+	static inline e_int special(__m128d x) {return 0;}
+	static inline e_double scalar(e_double d) {return d;}
+};
+
+struct AbsKernel {
+	static inline __m128d apply(__m128d x) {return _mm_andnot_pd(signMask(), x);}
+	static inline e_int special(__m128d x) {return 0;}
+	static inline e_double scalar(e_double d) {return d;}
+};
+
+e_void Math::sin(const DoubleArray& values, DoubleArray& results) {
+	mapArray<TrigKernel<false>>(values, results);
+}
+
+e_void Math::cos(const DoubleArray& values, DoubleArray& results) {
+	mapArray<TrigKernel<true>>(values, results);
+}
+
+e_void Math::epow(const DoubleArray& values, DoubleArray& results) {
+	mapArray<ExpKernel>(values, results);
+}
+
+e_void Math::ln(const DoubleArray& values, DoubleArray& results) {
+	mapArray<LogKernel>(values, results);
+}
+
+e_void Math::sqrt(const DoubleArray& values, DoubleArray& results) {
+	mapArray<SqrtKernel>(values, results);
+}
+
+e_void Math::abs(const DoubleArray& values, DoubleArray& results) {
+	mapArray<AbsKernel>(values, results);
+}
+
+/*
+	成对求和的项. load() 取第 i, i+1 项, at() 取第 i 项.
+*/
+struct Terms {
+	const e_double* p;
+	inline __m128d load(e_int i) const {return _mm_loadu_pd(p+i);}
+	inline e_double at(e_int i) const {return p[i];}
+};
+
+struct Products {
+	const e_double* a;
+	const e_double* b;
+	inline __m128d load(e_int i) const {return _mm_mul_pd(_mm_loadu_pd(a+i), _mm_loadu_pd(b+i));}
+	inline e_double at(e_int i) const {return a[i] * b[i];}
+};
+
+struct Deviations {
+	const e_double* p;
+	e_double mean;
+	inline __m128d load(e_int i) const {
+		__m128d d = _mm_sub_pd(_mm_loadu_pd(p+i), _mm_set1_pd(mean));
+		return _mm_mul_pd(d, d);
+	}
+	inline e_double at(e_int i) const {return (p[i]-mean) * (p[i]-mean);}
+};
+
+// 块内元素个数, 必须是 8 的倍数.
+static const e_int PAIRWISE_BLOCK = 128;
+
+template<class T>
+static e_double pairwiseSum(const T& terms, e_int begin, e_int n) {
+	if (n > PAIRWISE_BLOCK) {
+		e_int half = n / 2;
+		half -= half % 8;
+		return pairwiseSum(terms, begin, half) + pairwiseSum(terms, begin+half, n-half);
+	}
+
+	__m128d s0 = _mm_setzero_pd(), s1 = _mm_setzero_pd();
+	__m128d s2 = _mm_setzero_pd(), s3 = _mm_setzero_pd();
+	e_int end = begin + n;
+	e_int i   = begin;
+	for (; i+8 <= end; i+=8) {
+		s0 = _mm_add_pd(s0, terms.load(i));
+		s1 = _mm_add_pd(s1, terms.load(i+2));
+		s2 = _mm_add_pd(s2, terms.load(i+4));
+		s3 = _mm_add_pd(s3, terms.load(i+6));
+	}
+	__m128d s = _mm_add_pd(_mm_add_pd(s0, s1), _mm_add_pd(s2, s3));
+	e_double sum = _mm_cvtsd_f64(_mm_add_sd(s, _mm_unpackhi_pd(s, s)));
+	for (; i<end; i++) sum += terms.at(i);
+	return sum;
+}
+
+e_double Math::sum(const DoubleArray& values) {
+	return pairwiseSum(Terms{values.toCArray()}, 0, values.length());
+}
+
+e_double Math::dot(const DoubleArray& a, const DoubleArray& b) {
+	if (a.length() != b.length()) throw IllegalArgumentException{__func__, __LINE__};
+	return pairwiseSum(Products{a.toCArray(), b.toCArray()}, 0, a.length());
+}
+
+template<e_bool MAXIMUM>
+static e_double extremum(const DoubleArray& values) {
+	const e_double* p = values.toCArray();
+	e_int len = values.length();
+
+	__m128d r   = _mm_set1_pd(p[0]);
+	__m128d nan = _mm_setzero_pd();
+	e_int i = 0;
+	for (; i+2 <= len; i+=2) {
+		__m128d v = _mm_loadu_pd(p+i);
+		r   = MAXIMUM ? _mm_max_pd(r, v) : _mm_min_pd(r, v);
+		nan = _mm_or_pd(nan, _mm_cmpunord_pd(v, v));
+	}
+	if (i < len) {
+		__m128d v = _mm_set1_pd(p[i]);
+		r   = MAXIMUM ? _mm_max_pd(r, v) : _mm_min_pd(r, v);
+		nan = _mm_or_pd(nan, _mm_cmpunord_pd(v, v));
+	}
+	if (_mm_movemask_pd(nan) != 0) return NAN;
+
+	r = MAXIMUM ? _mm_max_sd(r, _mm_unpackhi_pd(r, r)) : _mm_min_sd(r, _mm_unpackhi_pd(r, r));
+	return _mm_cvtsd_f64(r);
+}
+
+e_double Math::min(const DoubleArray& values) {
+	if (values.length() == 0) throw IllegalArgumentException{__func__, __LINE__};
+	return extremum<false>(values);
+}
+
+e_double Math::max(const DoubleArray& values) {
+	if (values.length() == 0) throw IllegalArgumentException{__func__, __LINE__};
+	return extremum<true>(values);
+}
+
+e_double Math::mean(const DoubleArray& values) {
+	if (values.length() == 0) throw IllegalArgumentException{__func__, __LINE__};
+	return Math::sum(values) / values.length();
+}
+
+e_double Math::variance(const DoubleArray& values) {
+	e_double m = Math::mean(values);
+	return pairwiseSum(Deviations{values.toCArray(), m}, 0, values.length()) / values.length();
+}
+
 e_bool Math::nextBool() {
-	return (rand() % 2) == 0;
+	return Random::current().nextBool();
 }
 
 e_char Math::nextChar() {
-	return (e_char)(rand() & 0x0000ffff);
+	return (e_char)(Random::current().next() >> 48);
 }
 
 e_byte Math::nextByte() {
-	return (e_byte)((Math::abs(rand())) % 256);
+	return (e_byte)(Random::current().next() >> 56);
 }
 
+/*
+	(-max, max) 中共有 2*max-1 个整数, 在其中均匀地取一个.
+*/
 e_short Math::nextShort(e_short max) {
 	if (max <= 0) throw IllegalArgumentException{__func__, __LINE__};
-	
-	e_int tmp1 = rand(); //FIXME
-	e_int tmp2 = rand();
-	return (e_short) ((tmp2%2==0) ? (Math::abs(tmp1*tmp2)%max) : -(Math::abs(tmp1*tmp2)%max));
+	return (e_short)(Random::current().nextInt(2*max - 1) - (max - 1));
 }
 
 e_int Math::nextInt(e_int max)
 {
 	if (max <= 0) throw IllegalArgumentException{__func__, __LINE__};
-	
-	e_int tmp1 = rand(); //FIXME
-	e_int tmp2 = rand();
-	return (tmp2%2==0) ? (Math::abs(tmp1*tmp2)%max) : -(Math::abs(tmp1*tmp2)%max);
+	return (e_int)(Random::current().nextULong(2*(e_ulong)max - 1) - (max - 1));
 }
 
 e_long Math::nextLong(e_long max) {
 	if (max <= 0) throw IllegalArgumentException{__func__, __LINE__};
-	
-	e_long tmp1 = rand(); //FIXME
-	e_long tmp2 = rand();
-	e_long tmp3 = rand();
-	e_long tmp4 = rand();
-	return (tmp2%2==0) ? (Math::abs(tmp1*tmp2*tmp3+tmp4)%max) : -(Math::abs(tmp1*tmp2*tmp3+tmp4)%max);
+	return (e_long)(Random::current().nextULong(2*(e_ulong)max - 1) - (e_ulong)(max - 1));
 }
 
 e_float Math::nextFloat() {
-	return (0.5f / 1000000) * Math::nextInt(1000000) + 0.5f;
+	return Random::current().nextFloat();
 }
 
 e_double Math::nextDouble() {
-	return (0.5 / 100000000) * Math::nextLong(100000000) + 0.5;
+	return Random::current().nextDouble();
 }
 
 }
\ No newline at end of file
@@ -0,0 +1,180 @@
+/*
+ * 文件名: NodePool.cpp
+ *
+ * 日期/时间:
+ *		开始: 2026年10月18日 16:47:33 周日
+ *		结束:
+ *
+ * 版本: 1.0
+ *
+ * 作者: Tes Alone
+ *
+ * 备注:
+*/
+
+#include <windows.h>
+
+#include "NodePool.hpp"
+
+extern "C" {
+
+void WINAPI AcquireSRWLockExclusive (PSRWLOCK);
+void WINAPI ReleaseSRWLockExclusive (PSRWLOCK);
+
+}
+
+namespace Easy {
+
+constexpr e_int NodePool::GRANULE;
+constexpr e_int NodePool::MAX_BLOCK;
+constexpr e_int NodePool::SLAB_SIZE;
+constexpr e_int NodePool::LEVELS;
+
+NodePool::NodePool() {
+	for (e_int i=0; i<LEVELS; i++) {
+		m_free[i]   = nullptr;
+		m_cursor[i] = nullptr;
+		m_limit[i]  = nullptr;
+	}
+	m_slabs = nullptr;
+	m_stats = NodePoolStats{0, 0, 0, 0, 0};
+}
+
+NodePool::~NodePool() {
+	while (m_slabs) {
+		e_void* next = *static_cast<e_void**>(m_slabs);
+		::operator delete(m_slabs);
+		m_slabs = next;
+	}
+}
+
+e_void NodePool::adopt(NodePool& other) {
+	for (e_int i=0; i<LEVELS; i++) {
+		// other 还未切分的部分变成空闲节点, 不再有单独的游标
+		e_int size = (i + 1) * GRANULE;
+		for (; other.m_cursor[i] && other.m_cursor[i]+size <= other.m_limit[i]; other.m_cursor[i] += size) {
+			Block* block  = reinterpret_cast<Block*>(other.m_cursor[i]);
+			block->m_next = other.m_free[i];
+			other.m_free[i] = block;
+		}
+		if (other.m_free[i]) {
+			Block* tail = other.m_free[i];
+			while (tail->m_next) {
+				tail = tail->m_next;
+			}
+			tail->m_next = m_free[i];
+			m_free[i]    = other.m_free[i];
+		}
+		other.m_free[i]   = nullptr;
+		other.m_cursor[i] = nullptr;
+		other.m_limit[i]  = nullptr;
+	}
+	while (other.m_slabs) {
+		e_void* next = *static_cast<e_void**>(other.m_slabs);
+		*static_cast<e_void**>(other.m_slabs) = m_slabs;
+		m_slabs = other.m_slabs;
+		other.m_slabs = next;
+	}
+	m_stats.m_allocations += other.m_stats.m_allocations;
+	m_stats.m_frees       += other.m_stats.m_frees;
+	m_stats.m_reused      += other.m_stats.m_reused;
+	m_stats.m_oversized   += other.m_stats.m_oversized;
+	m_stats.m_slabs       += other.m_stats.m_slabs;
+	other.m_stats = NodePoolStats{0, 0, 0, 0, 0};
+}
+
+e_void* NodePool::_carve(e_int level) {
+	e_int size = (level + 1) * GRANULE;
+	if (m_cursor[level] == nullptr || m_cursor[level]+size > m_limit[level]) {
+		e_byte* slab = static_cast<e_byte*>(::operator new(SLAB_SIZE));
+		*reinterpret_cast<e_void**>(slab) = m_slabs;
+		m_slabs = slab;
+		m_stats.m_slabs++;
+		// 开头保存链接, 之后的节点保持 GRANULE 对齐
+		m_cursor[level] = slab + GRANULE;
+		m_limit[level]  = slab + SLAB_SIZE;
+	}
+	e_void* block = m_cursor[level];
+	m_cursor[level] += size;
+	return block;
+}
+
+// 全局池永不销毁, 静态对象析构时仍可能释放节点.
+static NodePool& _globalPool() {
+	static NodePool* pool = new NodePool();
+	return *pool;
+}
+
+static SRWLOCK _globalLock = SRWLOCK_INIT;
+
+e_void* PoolAllocator::allocate(size_t size) {
+	AcquireSRWLockExclusive(&_globalLock);
+	e_void* block;
+	try {
+		block = _globalPool().allocate(size);
+	} catch (...) {
+		ReleaseSRWLockExclusive(&_globalLock);
+		throw;
+	}
+	ReleaseSRWLockExclusive(&_globalLock);
+	return block;
+}
+
+e_void PoolAllocator::deallocate(e_void* block, size_t size) {
+	AcquireSRWLockExclusive(&_globalLock);
+	_globalPool().deallocate(block, size);
+	ReleaseSRWLockExclusive(&_globalLock);
+}
+
+NodePoolStats PoolAllocator::stats() {
+	AcquireSRWLockExclusive(&_globalLock);
+	NodePoolStats stats = _globalPool().stats();
+	ReleaseSRWLockExclusive(&_globalLock);
+	return stats;
+}
+
+/*
+	线程退出时把池并入全局池, 别的线程里的容器仍在使用其中的节点.
+	_localPool 析构之后, 同一线程中还可能有容器释放节点: 先析构的是它之前构造的 thread_local 对象,
+	主线程中还有之后才析构的静态对象. _localPoolGone 没有析构函数, 直到线程结束都可以读取,
+	置位之后分配和释放都交给全局池.
+*/
+static thread_local e_bool _localPoolGone = false;
+
+class LocalPool {
+public:
+	NodePool m_pool;
+
+	~LocalPool() {
+		AcquireSRWLockExclusive(&_globalLock);
+		_globalPool().adopt(m_pool);
+		ReleaseSRWLockExclusive(&_globalLock);
+		_localPoolGone = true;
+	}
+};
+
+static thread_local LocalPool _localPool;
+
+e_void* ThreadLocalPoolAllocator::allocate(size_t size) {
+	if (_localPoolGone) {
+		return PoolAllocator::allocate(size);
+	}
+	return _localPool.m_pool.allocate(size);
+}
+
+e_void ThreadLocalPoolAllocator::deallocate(e_void* block, size_t size) {
+	if (_localPoolGone) {
+		PoolAllocator::deallocate(block, size);
+		return;
+	}
+	_localPool.m_pool.deallocate(block, size);
+}
+
+NodePoolStats ThreadLocalPoolAllocator::stats() {
+	if (_localPoolGone) {
+		return NodePoolStats{0, 0, 0, 0, 0};
+	}
+	return _localPool.m_pool.stats();
+}
+
+} // Easy
@@ -0,0 +1,283 @@
+/*
+ * 文件名: Random.cpp
+ *
+ * 日期/时间:
+ *		开始: 2026年10月17日 21:32:46 周六
+ *		结束:
+ *
+ * 版本: 1.0
+ *
+ * 作者: Tes Alone
+ *
+ * 备注:
+*/
+
+#include <windows.h>
+#include <cstring>
+#include <emmintrin.h>
+
+#include "Random.hpp"
+#include "Integer.hpp"
+#include "UInteger.hpp"
+#include "StringBuffer.hpp"
+#include "StringView.hpp"
+#include "Exception.hpp"
+
+extern "C" {
+
+void WINAPI AcquireSRWLockExclusive (PSRWLOCK);
+void WINAPI ReleaseSRWLockExclusive (PSRWLOCK);
+
+}
+
+namespace Easy {
+
+static const e_ulong JUMP[4] = {
+	0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL
+};
+
+static const e_ulong LONG_JUMP[4] = {
+	0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL, 0x77710069854ee241ULL, 0x39109bb02acbe635ULL
+};
+
+// 少于这么多个 64 位数时, 初始化 4 个生成器不划算, 直接调用 next().
+static const e_int LANE_THRESHOLD = 32;
+
+/*
+	SplitMix64, 把一个种子展开为 xoshiro256** 的状态.
+	即使种子只差一位, 展开的状态也毫不相关, 并且不会全为 0.
+*/
+static inline e_ulong splitMix(e_ulong& x) {
+	e_ulong z = (x += 0x9e3779b97f4a7c15ULL);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return z ^ (z >> 31);
+}
+
+/*
+	4 个 xoshiro256** 生成器, 每个 __m128i 存放 2 个生成器的同一个状态字:
+	s[k][0] 是生成器 0, 1 的第 k 个状态字, s[k][1] 是生成器 2, 3 的.
+	SSE2 没有 64 位乘法和循环移位, 乘 5 和乘 9 用移位加代替, 循环移位用两次移位代替.
+*/
+struct XoshiroLanes {
+	__m128i s[4][2];
+
+	explicit XoshiroLanes(Random& random) {
+		e_ulong words[4][4];
+		for (e_int lane=0; lane<4; lane++) {
+			e_ulong seed = random.next();
+			for (e_int k=0; k<4; k++) words[k][lane] = splitMix(seed);
+		}
+		for (e_int k=0; k<4; k++) {
+			s[k][0] = _mm_loadu_si128((const __m128i*)&words[k][0]);
+			s[k][1] = _mm_loadu_si128((const __m128i*)&words[k][2]);
+		}
+	}
+
+	template<e_int K>
+	static inline __m128i rotl(__m128i x) {
+		return _mm_or_si128(_mm_slli_epi64(x, K), _mm_srli_epi64(x, 64 - K));
+	}
+
+	static inline __m128i step(__m128i (&s)[4][2], e_int h) {
+		__m128i s1 = s[1][h];
+		__m128i x5 = _mm_add_epi64(_mm_slli_epi64(s1, 2), s1);
+		__m128i r  = rotl<7>(x5);
+		__m128i result = _mm_add_epi64(_mm_slli_epi64(r, 3), r);
+		__m128i t  = _mm_slli_epi64(s1, 17);
+
+		s[2][h] = _mm_xor_si128(s[2][h], s[0][h]);
+		s[3][h] = _mm_xor_si128(s[3][h], s1);
+		s[1][h] = _mm_xor_si128(s1, s[2][h]);
+		s[0][h] = _mm_xor_si128(s[0][h], s[3][h]);
+		s[2][h] = _mm_xor_si128(s[2][h], t);
+		s[3][h] = rotl<45>(s[3][h]);
+
+		return result;
+	}
+
+	// 生成 4 个 64 位随机数.
+	inline e_void next(__m128i& lo, __m128i& hi) {
+		lo = step(s, 0);
+		hi = step(s, 1);
+	}
+};
+
+// [1.0, 2.0) 的指数位加上 52 位随机尾数, 再减去 1.0.
+static inline __m128d toUnit(__m128i bits) {
+	const __m128i ONE = _mm_set1_epi64x(0x3ff0000000000000LL);
+	__m128d d = _mm_castsi128_pd(_mm_or_si128(_mm_srli_epi64(bits, 12), ONE));
+	return _mm_sub_pd(d, _mm_set1_pd(1.0));
+}
+
+static inline e_double toUnit(e_ulong bits) {
+	e_ulong b = (bits >> 12) | 0x3ff0000000000000ULL;
+	e_double d;
+	::memcpy(&d, &b, sizeof(d));
+	return d - 1.0;
+}
+
+Random::Random() {
+	static SRWLOCK lock = SRWLOCK_INIT;
+	static Random* master = nullptr;
+
+	AcquireSRWLockExclusive(&lock);
+	if (master == nullptr) {
+		LARGE_INTEGER counter;
+		counter.QuadPart = 0;
+		::QueryPerformanceCounter(&counter);
+		e_ulong seed = (e_ulong)counter.QuadPart;
+		seed ^= (e_ulong)GetCurrentProcessId() << 32;
+		seed ^= (e_ulong)GetCurrentThreadId();
+		seed ^= (e_ulong)reinterpret_cast<e_long>(&lock);
+		master = new Random{seed};
+	}
+	::memcpy(m_state, master->m_state, sizeof(m_state));
+	master->jump();
+	ReleaseSRWLockExclusive(&lock);
+}
+
+Random::Random(e_ulong seed) {
+	for (e_int i=0; i<4; i++) m_state[i] = splitMix(seed);
+}
+
+e_int Random::nextInt(e_int bound) {
+	if (bound <= 0) throw IllegalArgumentException{__func__, __LINE__};
+
+	// Lemire: 用乘法代替取模, 只有落入长度为 2^32 % bound 的区间时才重新生成.
+	e_ulong m = (next() >> 32) * (e_ulong)bound;
+	e_uint low = (e_uint)m;
+	if (low < (e_uint)bound) {
+		e_uint threshold = (0u - (e_uint)bound) % (e_uint)bound;
+		while (low < threshold) {
+			m   = (next() >> 32) * (e_ulong)bound;
+			low = (e_uint)m;
+		}
+	}
+	return (e_int)(m >> 32);
+}
+
+e_long Random::nextLong(e_long bound) {
+	if (bound <= 0) throw IllegalArgumentException{__func__, __LINE__};
+	return (e_long)nextULong((e_ulong)bound);
+}
+
+e_ulong Random::nextULong(e_ulong bound) {
+	if (bound == 0) throw IllegalArgumentException{__func__, __LINE__};
+
+	unsigned __int128 m = (unsigned __int128)next() * bound;
+	e_ulong low = (e_ulong)m;
+	if (low < bound) {
+		e_ulong threshold = (0 - bound) % bound;
+		while (low < threshold) {
+			m   = (unsigned __int128)next() * bound;
+			low = (e_ulong)m;
+		}
+	}
+	return (e_ulong)(m >> 64);
+}
+
+e_void Random::jump() {
+	_jump(JUMP);
+}
+
+e_void Random::longJump() {
+	_jump(LONG_JUMP);
+}
+
+e_void Random::_jump(const e_ulong (&poly)[4]) {
+	e_ulong s[4] = {0, 0, 0, 0};
+	for (e_int i=0; i<4; i++) {
+		for (e_int b=0; b<64; b++) {
+			if (poly[i] & (1ULL << b)) {
+				for (e_int k=0; k<4; k++) s[k] ^= m_state[k];
+			}
+			next();
+		}
+	}
+	::memcpy(m_state, s, sizeof(m_state));
+}
+
+e_void Random::fill(IntArray& values) {
+	e_int* out = values.toCArray();
+	e_int len  = values.length();
+	e_int i    = 0;
+
+	if (len >= LANE_THRESHOLD * 2) {
+		XoshiroLanes lanes{*this};
+		__m128i lo, hi;
+		for (; i+8 <= len; i+=8) {
+			lanes.next(lo, hi);
+			_mm_storeu_si128((__m128i*)(out+i), lo);
+			_mm_storeu_si128((__m128i*)(out+i+4), hi);
+		}
+	}
+	for (; i<len; i++) out[i] = nextInt();
+}
+
+e_void Random::fill(LongArray& values) {
+	e_long* out = values.toCArray();
+	e_int len   = values.length();
+	e_int i     = 0;
+
+	if (len >= LANE_THRESHOLD) {
+		XoshiroLanes lanes{*this};
+		__m128i lo, hi;
+		for (; i+4 <= len; i+=4) {
+			lanes.next(lo, hi);
+			_mm_storeu_si128((__m128i*)(out+i), lo);
+			_mm_storeu_si128((__m128i*)(out+i+2), hi);
+		}
+	}
+	for (; i<len; i++) out[i] = nextLong();
+}
+
+e_void Random::fill(DoubleArray& values) {
+	e_double* out = values.toCArray();
+	e_int len     = values.length();
+	e_int i       = 0;
+
+	if (len >= LANE_THRESHOLD) {
+		XoshiroLanes lanes{*this};
+		__m128i lo, hi;
+		for (; i+4 <= len; i+=4) {
+			lanes.next(lo, hi);
+			_mm_storeu_pd(out+i, toUnit(lo));
+			_mm_storeu_pd(out+i+2, toUnit(hi));
+		}
+	}
+	for (; i<len; i++) out[i] = toUnit(next());
+}
+
+Random& Random::current() {
+	static thread_local Random random;
+	return random;
+}
+
+e_bool Random::equals(const Random& other) const {
+	return ::memcmp(m_state, other.m_state, sizeof(m_state)) == 0;
+}
+
+e_int Random::compare(const Random& other) const {
+	for (e_int i=0; i<4; i++) {
+		if (m_state[i] != other.m_state[i])
+			return m_state[i] > other.m_state[i] ? 1 : -1;
+	}
+	return 0;
+}
+
+e_int Random::hashCode() const {
+	return Long::hashCode((e_long)(m_state[0] ^ m_state[1] ^ m_state[2] ^ m_state[3]));
+}
+
+String Random::toString() const {
+	StringBuffer sb{80};
+	sb.append(StringView{L"Random: "});
+	for (e_int i=0; i<4; i++) {
+		if (i > 0) sb.append(L' ', 1);
+		sb.append(ULong::toString(m_state[i], 16));
+	}
+	return sb.toString();
+}
+
+} // Easy
@@ -0,0 +1,319 @@
+/*
+ * 文件名: Searcher.cpp
+ *
+ * 日期/时间:
+ *		开始: 2026年10月17日 09:40:18 周六
+ *		结束:
+ *
+ * 版本: 1.0
+ *
+ * 作者: Tes Alone
+ *
+ * 备注:
+*/
+
+#include <cstring>
+#include <cwchar>
+#include <emmintrin.h>
+
+#include "Searcher.hpp"
+
+namespace Easy {
+
+constexpr e_int Searcher::TWO_WAY_LIMIT;
+
+typedef Searcher::Factorization Factorization;
+
+/*
+	按代码单元的宽度选择 SSE2 比较指令. e_char 在 Windows 上是 16 位, 每个向量比较 8 个字符;
+	e_byte 用于 Utf8String, 每个向量比较 16 个字节.
+*/
+template<class C> struct Lanes;
+
+template<> struct Lanes<e_byte> {
+	static inline __m128i set1(e_byte ch) {return _mm_set1_epi8(ch);}
+	static inline __m128i eq(__m128i a, __m128i b) {return _mm_cmpeq_epi8(a, b);}
+};
+
+template<> struct Lanes<e_char> {
+#if WCHAR_MAX > 0xffff
+	static inline __m128i set1(e_char ch) {return _mm_set1_epi32(ch);}
+	static inline __m128i eq(__m128i a, __m128i b) {return _mm_cmpeq_epi32(a, b);}
+#else
+	static inline __m128i set1(e_char ch) {return _mm_set1_epi16(ch);}
+	static inline __m128i eq(__m128i a, __m128i b) {return _mm_cmpeq_epi16(a, b);}
+#endif
+};
+
+/*
+	Forward 按原顺序访问字符序列, Backward 从尾到头访问,
+	在 Backward 上正序查找相当于在原序列上倒序查找.
+*/
+template<class C>
+struct Forward {
+	const C* chs;
+	inline C operator[](e_int i) const {return chs[i];}
+};
+
+template<class C>
+struct Backward {
+	const C* chs;
+	e_int    len;
+	inline C operator[](e_int i) const {return chs[len-1-i];}
+};
+
+template<class A>
+static e_void factorize(const A& sub, e_int len, Factorization& fact);
+
+template<class T, class S>
+static e_int twoWay(const T& chs, e_int len, const S& sub, e_int subLen, const Factorization& fact);
+
+template<class C>
+static e_int filterFirst(const C* chs, e_int len, const C* sub, e_int subLen, e_int offset);
+template<class C>
+static e_int filterLast(const C* chs, const C* sub, e_int subLen, e_int offset);
+
+template<class C>
+static e_int findFirst(const C* chs, e_int len, const C* sub, e_int subLen, e_int offset);
+template<class C>
+static e_int findLast(const C* chs, const C* sub, e_int subLen, e_int offset);
+
+Searcher::Searcher(const StringView& sub) : m_sub(sub) {
+	e_int subLen = m_sub.length();
+	if (subLen >= TWO_WAY_LIMIT) {
+		factorize(Forward<e_char>{m_sub.toCStr()}, subLen, m_forward);
+		factorize(Backward<e_char>{m_sub.toCStr(), subLen}, subLen, m_backward);
+	}
+}
+
+e_int Searcher::indexOf(const e_char* chs, e_int len, e_int offset) const {
+	e_int subLen = m_sub.length();
+
+	if (offset<0 || offset>=len) return -1;
+	if (subLen == 0) return offset;
+	if (len-offset < subLen) return -1;
+
+	if (subLen < TWO_WAY_LIMIT)
+		return filterFirst(chs, len, m_sub.toCStr(), subLen, offset);
+
+	e_int index = twoWay(Forward<e_char>{chs+offset}, len-offset, Forward<e_char>{m_sub.toCStr()}, subLen, m_forward);
+	return index == -1 ? -1 : index + offset;
+}
+
+e_int Searcher::lastIndexOf(const e_char* chs, e_int len, e_int offset) const {
+	e_int subLen = m_sub.length();
+
+	if (offset == -1) offset = len - 1;
+	if (offset<0 || offset>=len) return -1;
+	if (subLen == 0) return offset;
+	if (offset+1 < subLen) return -1;
+
+	if (subLen < TWO_WAY_LIMIT)
+		return filterLast(chs, m_sub.toCStr(), subLen, offset);
+
+	e_int index = twoWay(Backward<e_char>{chs, offset+1}, offset+1, Backward<e_char>{m_sub.toCStr(), subLen}, subLen, m_backward);
+	return index == -1 ? -1 : offset + 1 - subLen - index;
+}
+
+e_int Searcher::find(const e_char* chs, e_int len, const e_char* sub, e_int subLen, e_int offset) {
+	return findFirst(chs, len, sub, subLen, offset);
+}
+
+e_int Searcher::findLast(const e_char* chs, e_int len, const e_char* sub, e_int subLen, e_int offset) {
+	return Easy::findLast(chs, sub, subLen, offset);
+}
+
+e_int Searcher::find(const e_byte* chs, e_int len, const e_byte* sub, e_int subLen, e_int offset) {
+	return findFirst(chs, len, sub, subLen, offset);
+}
+
+e_int Searcher::findLast(const e_byte* chs, e_int len, const e_byte* sub, e_int subLen, e_int offset) {
+	return Easy::findLast(chs, sub, subLen, offset);
+}
+
+// ------------------------------------
+
+template<class C>
+static e_int findFirst(const C* chs, e_int len, const C* sub, e_int subLen, e_int offset) {
+	if (subLen == 0) return offset;
+	if (len-offset < subLen) return -1;
+
+	if (subLen < Searcher::TWO_WAY_LIMIT)
+		return filterFirst(chs, len, sub, subLen, offset);
+
+	Factorization fact;
+	factorize(Forward<C>{sub}, subLen, fact);
+	e_int index = twoWay(Forward<C>{chs+offset}, len-offset, Forward<C>{sub}, subLen, fact);
+	return index == -1 ? -1 : index + offset;
+}
+
+template<class C>
+static e_int findLast(const C* chs, const C* sub, e_int subLen, e_int offset) {
+	if (subLen == 0) return offset;
+	if (offset+1 < subLen) return -1;
+
+	if (subLen < Searcher::TWO_WAY_LIMIT)
+		return filterLast(chs, sub, subLen, offset);
+
+	Factorization fact;
+	factorize(Backward<C>{sub, subLen}, subLen, fact);
+	e_int index = twoWay(Backward<C>{chs, offset+1}, offset+1, Backward<C>{sub, subLen}, subLen, fact);
+	return index == -1 ? -1 : offset + 1 - subLen - index;
+}
+
+// 首尾字符已经相等, 比较中间部分.
+template<class C>
+static inline e_bool matchMiddle(const C* chs, const C* sub, e_int subLen) {
+	return subLen <= 2 || ::memcmp(chs+1, sub+1, (subLen-2)*sizeof(C)) == 0;
+}
+
+/*
+	每次比较 LANES 个候选位置: 一个向量取候选位置的字符和 sub 的首字符比较,
+	另一个向量取候选位置 + subLen-1 的字符和 sub 的尾字符比较, 两者都相等才逐字确认.
+*/
+template<class C>
+static e_int filterFirst(const C* chs, e_int len, const C* sub, e_int subLen, e_int offset) {
+	const e_int  LANES     = sizeof(__m128i) / sizeof(C);
+	const e_uint LANE_BITS = (1u << sizeof(C)) - 1;
+	const __m128i first = Lanes<C>::set1(sub[0]);
+	const __m128i last  = Lanes<C>::set1(sub[subLen-1]);
+	e_int end = len - subLen;
+	e_int i   = offset;
+
+	for (; i+LANES-1 <= end; i+=LANES) {
+		__m128i head = _mm_loadu_si128((const __m128i*)(chs+i));
+		__m128i tail = _mm_loadu_si128((const __m128i*)(chs+i+subLen-1));
+		e_uint mask  = _mm_movemask_epi8(_mm_and_si128(Lanes<C>::eq(head, first), Lanes<C>::eq(tail, last)));
+		while (mask != 0) {
+			e_int bit = __builtin_ctz(mask);
+			e_int pos = i + bit / sizeof(C);
+			if (matchMiddle(chs+pos, sub, subLen)) return pos;
+			mask &= ~(LANE_BITS << bit);
+		}
+	}
+
+	for (; i<=end; i++) {
+		if (chs[i]==sub[0] && chs[i+subLen-1]==sub[subLen-1] && matchMiddle(chs+i, sub, subLen))
+			return i;
+	}
+
+	return -1;
+}
+
+template<class C>
+static e_int filterLast(const C* chs, const C* sub, e_int subLen, e_int offset) {
+	const e_int  LANES     = sizeof(__m128i) / sizeof(C);
+	const e_uint LANE_BITS = (1u << sizeof(C)) - 1;
+	const __m128i first = Lanes<C>::set1(sub[0]);
+	const __m128i last  = Lanes<C>::set1(sub[subLen-1]);
+	e_int i = offset - subLen + 1;
+
+	for (; i-LANES+1 >= 0; i-=LANES) {
+		e_int base   = i - LANES + 1;
+		__m128i head = _mm_loadu_si128((const __m128i*)(chs+base));
+		__m128i tail = _mm_loadu_si128((const __m128i*)(chs+base+subLen-1));
+		e_uint mask  = _mm_movemask_epi8(_mm_and_si128(Lanes<C>::eq(head, first), Lanes<C>::eq(tail, last)));
+		while (mask != 0) {
+			e_int bit = (31 - __builtin_clz(mask)) / sizeof(C) * sizeof(C);
+			e_int pos = base + bit / sizeof(C);
+			if (matchMiddle(chs+pos, sub, subLen)) return pos;
+			mask &= ~(LANE_BITS << bit);
+		}
+	}
+
+	for (; i>=0; i--) {
+		if (chs[i]==sub[0] && chs[i+subLen-1]==sub[subLen-1] && matchMiddle(chs+i, sub, subLen))
+			return i;
+	}
+
+	return -1;
+}
+
+/*
+	Crochemore-Perrin 临界分解: 分别按两种字符顺序求最大后缀, 取较长的一个.
+	skip 取同一低 8 位的字符中最靠后的一个到结尾的距离, 冲突时只会跳得更少.
+*/
+template<class A>
+static e_void factorize(const A& sub, e_int len, Factorization& fact) {
+	e_ushort maxSkip = len < 0xffff ? len : 0xffff;
+	for (e_int i=0; i<256; i++) fact.skip[i] = maxSkip;
+	for (e_int i=0; i<len; i++) {
+		e_int skip = len - 1 - i;
+		fact.skip[sub[i] & 0xff] = skip < 0xffff ? skip : 0xffff;
+	}
+
+	e_int ip = -1, jp = 0, k = 1, p = 1;
+	while (jp+k < len) {
+		if (sub[ip+k] == sub[jp+k]) {
+			if (k == p) {jp += p; k = 1;}
+			else k++;
+		} else if (sub[ip+k] > sub[jp+k]) {
+			jp += k; k = 1; p = jp - ip;
+		} else {
+			ip = jp++; k = p = 1;
+		}
+	}
+	e_int split  = ip;
+	e_int period = p;
+
+	ip = -1; jp = 0; k = p = 1;
+	while (jp+k < len) {
+		if (sub[ip+k] == sub[jp+k]) {
+			if (k == p) {jp += p; k = 1;}
+			else k++;
+		} else if (sub[ip+k] < sub[jp+k]) {
+			jp += k; k = 1; p = jp - ip;
+		} else {
+			ip = jp++; k = p = 1;
+		}
+	}
+	if (ip > split) {
+		split  = ip;
+		period = p;
+	}
+
+	fact.split  = split;
+	fact.period = period;
+	fact.memory = len - period;
+	for (e_int i=0; i<=split; i++) {
+		if (sub[i] != sub[i+period]) {
+			fact.period = (split > len-split-1 ? split : len-split-1) + 1;
+			fact.memory = 0;
+			break;
+		}
+	}
+}
+
+template<class T, class S>
+static e_int twoWay(const T& chs, e_int len, const S& sub, e_int subLen, const Factorization& fact) {
+	e_int pos = 0;
+	e_int mem = 0;
+
+	while (pos+subLen <= len) {
+		e_int skip = fact.skip[chs[pos+subLen-1] & 0xff];
+		if (skip != 0) {
+			pos += skip;
+			mem  = 0;
+			continue;
+		}
+
+		e_int k = (fact.split+1 > mem) ? fact.split+1 : mem;
+		while (k<subLen && sub[k]==chs[pos+k]) k++;
+		if (k < subLen) {
+			pos += k - fact.split;
+			mem  = 0;
+			continue;
+		}
+
+		k = fact.split + 1;
+		while (k>mem && sub[k-1]==chs[pos+k-1]) k--;
+		if (k <= mem) return pos;
+
+		pos += fact.period;
+		mem  = fact.memory;
+	}
+
+	return -1;
+}
+
+} // Easy
@@ -24,12 +24,15 @@
 #include "StringBuffer.hpp"
 #include "Math.hpp"
 #include "Vector.hpp"
+#include "Searcher.hpp"
 #include "BasicArray.hpp"
 #include "BasicArray.tcc"
 
 #include "EasyC.hpp"
 
 namespace Easy {
+
+constexpr e_int String::SSO_CAPACITY;
 	
 String::String(const e_char* str, e_int start, e_int end) {
 	if (str == nullptr) 
@@ -39,72 +42,95 @@ String::String(const e_char* str, e_int start, e_int end) {
 	
 	if (m_length == 0)
 	{
-		m_str = new e_char[1];
-		m_str[m_length] = '\0';
+		_init(0);
 	}
 	else
 	{			
 		_checkStartAndEnd(start, end, __func__, __LINE__);
-		m_length = end - start;
-		m_str    = new e_char[m_length+1];
+		_init(end - start);
 		e_memcopy(m_str, &str[start], m_length*sizeof(e_char));
-		m_str[m_length] = '\0';
 	}
 }
 
 String::String(const e_byte* bytes) {
 	if (bytes == nullptr)
 		throw NullPointerException{__func__, __LINE__};
-	m_length = MultiByteToWideChar(CP_ACP, 0, (const char*)bytes, -1, nullptr, 0);
-	m_str    = new e_char[m_length];
-	MultiByteToWideChar(CP_ACP, 0, (const char*)bytes, -1, m_str, m_length);
-	m_length--;
+	e_int len = MultiByteToWideChar(CP_ACP, 0, (const char*)bytes, -1, nullptr, 0);
+	_init(len-1);
+	MultiByteToWideChar(CP_ACP, 0, (const char*)bytes, -1, m_str, len);
+}
+
+String::String(const StringView& view) {
+	_init(view.length());
+	e_memcopy(m_str, view.data(), m_length*sizeof(e_char));
 }
 
 String::String(const String& copy) {
-	if (copy.m_length == 0) {
-		m_length = 0;
-		m_str    = new e_char[1];
-		m_str[0] = '\0';
-	} else {
-		m_length = copy.m_length;
-		m_str    = new e_char[m_length+1];
-		e_memcopy(m_str, copy.m_str, m_length*sizeof(e_char));
-		m_str[m_length] = '\0';
-	}
+	_share(copy);
 }
 
 String& String::operator=(const String& copy) {
-	delete [] m_str;
-	if (copy.m_length == 0) {
-		m_length = 0;
-		m_str    = new e_char[1];
-		m_str[0] = '\0';
-	} else {
-		m_length = copy.m_length;
-		m_str    = new e_char[m_length+1];
-		e_memcopy(m_str, copy.m_str, m_length*sizeof(e_char));
-		m_str[m_length] = '\0';
-	}
+	if (this == &copy) return *this;
+	if (m_str != m_buf) _release();
+	_share(copy);
 	return *this;
 }
 
 String::String(String&& move) {
-	m_length = move.m_length;
-	m_str 	 = move.m_str;
-	move.m_str = new e_char[1];
-	move.m_length = 0;
-	move.m_str[0] = '\0';
+	_steal(move);
 }
 	
 String& String::operator=(String&& move) {
-	delete [] m_str;
+	if (this == &move) return *this;
+	if (m_str != m_buf) _release();
+	_steal(move);
+	return *this;
+}
+
+// 引用计数放在字符之前, 占用 8 字节以保证字符的对齐.
+static const e_int SHARED_HEADER = sizeof(e_long);
+
+static inline e_long* sharedCount(const e_char* chs) {
+	return (e_long*)((e_ubyte*)chs - SHARED_HEADER);
+}
+
+e_char* String::_allocShared(e_int length) {
+	e_ubyte* block = new e_ubyte[SHARED_HEADER + (length+1)*sizeof(e_char)];
+	*(e_long*)block = 1;
+	return (e_char*)(block + SHARED_HEADER);
+}
+
+e_void String::_share(const String& copy) {
+	m_length = copy.m_length;
+	m_hash   = __atomic_load_n(&copy.m_hash, __ATOMIC_RELAXED);
+	if (copy.m_str == copy.m_buf) {
+		m_str = m_buf;
+		e_memcopy(m_buf, copy.m_buf, (m_length+1)*sizeof(e_char));
+	} else {
+		m_str = copy.m_str;
+		__atomic_add_fetch(sharedCount(m_str), 1, __ATOMIC_RELAXED);
+	}
+}
+
+e_void String::_release() {
+	e_long* count = sharedCount(m_str);
+	if (__atomic_sub_fetch(count, 1, __ATOMIC_ACQ_REL) == 0)
+		delete [] (e_ubyte*)count;
+}
+
+e_void String::_steal(String& move) {
 	m_length = move.m_length;
-	m_str 	 = move.m_str;
-	move.m_str = new e_char[1];
+	m_hash   = move.m_hash;
+	if (move.m_str == move.m_buf) {
+		m_str = m_buf;
+		e_memcopy(m_buf, move.m_buf, (m_length+1)*sizeof(e_char));
+	} else {
+		m_str = move.m_str;
+	}
+	move.m_str    = move.m_buf;
 	move.m_length = 0;
-	move.m_str[0] = '\0';
-	return *this;
+	move.m_hash   = -1;
+	move.m_buf[0] = '\0';
 }
 
 e_bool String::equals(const String& other) const {		
@@ -133,18 +159,16 @@ e_int String::compare(const String& other) const
     return (this->m_length > other.m_length) ? 1 : -1;
 }
 
+// 多个线程可能同时计算同一个 String 的哈希值. 结果只取决于内容, 谁先写入都一样,
+// 所以 relaxed 的原子读写就够了, 只是不能让普通读写构成数据竞争.
 e_int String::hashCode() const {
-	const e_int p = 31;
-	const e_int m = 1e9 + 9;
-	e_long hash_value = 0;
-	e_long p_pow      = 1;
-	
-	for (e_int i=0; i<m_length; i++) {
-		hash_value = (hash_value + (m_str[i] * p_pow)) % m;
-		p_pow = (p_pow * p) % m;
+	e_int hash = __atomic_load_n(&m_hash, __ATOMIC_RELAXED);
+	if (hash < 0) {
+		e_ulong h = e_hash(m_str, m_length*sizeof(e_char));
+		hash = (e_int)((h ^ (h >> 32)) & 0x7fffffff);
+		__atomic_store_n(&m_hash, hash, __ATOMIC_RELAXED);
 	}
-	
-	return Math::abs(hash_value);
+	return hash;
 }
 
 String String::operator*(int times) const {
@@ -197,177 +221,82 @@ String String::substring(e_int start, e_int end) const
 	if (m_length == 0) return String{};
 	
 	_checkStartAndEnd(start, end, __func__, __LINE__);
-	return System::move(String{this->m_str, start, end});
+	return System::move(String{StringView{m_str+start, end-start}});
 }
 
-e_bool String::endsWith(const String& chs) const
-{			
-	if (m_length < chs.length()) return false;
-
-	for (e_int i=chs.length()-1,j=m_length-1; i>=0; i--,j--) {
-		if (m_str[j] != chs[i]) return false;
-	}
+StringView String::view(e_int start, e_int end) const
+{
+	if (m_length == 0) return StringView{};
+	
+	_checkStartAndEnd(start, end, __func__, __LINE__);
+	return StringView{m_str+start, end-start};
+}
 
-	return true;
+e_bool String::endsWith(const StringView& chs) const
+{			
+	return StringView{*this}.endsWith(chs);
 }
 
-e_bool String::startsWith(const String& chs) const
+e_bool String::startsWith(const StringView& chs) const
 {
-	if (m_length < chs.length()) return false;
- 
-	for (e_int i=0; i<chs.length(); i++) {
-		if (m_str[i] != chs[i]) return false;
-	}
-
-	return true;
+	return StringView{*this}.startsWith(chs);
 }
 
 
 String String::toUpperCase() const
 {		
-	e_char* upperChs = new e_char[m_length+1];
+	String upperStr{};
+	e_char* upperChs = upperStr._init(m_length);
 		
 	for (e_int i=0; i<m_length; i++)
 	{
 		upperChs[i] = Character::toUpperCase(m_str[i]);
 	}
 	
-	upperChs[m_length] = '\0';
-	
-	String upperStr{};
-	delete [] upperStr.m_str;
-
-	upperStr.m_str    = upperChs;
-	upperStr.m_length = m_length;
-	
 	return System::move(upperStr);
 }
 
 
 String String::toLowerCase() const
 {		
-	e_char* lowerChs = new e_char[m_length+1];
+	String lowerStr{};
+	e_char* lowerChs = lowerStr._init(m_length);
 		
 	for (e_int i=0; i<m_length; i++)
 	{
 		lowerChs[i] = Character::toLowerCase(m_str[i]);
 	}
 	
-	lowerChs[m_length] = '\0';
-	
-	String lowerStr{};
-	delete [] lowerStr.m_str;
-
-	lowerStr.m_str    = lowerChs;
-	lowerStr.m_length = m_length;
-	
 	return System::move(lowerStr);
 }
 
-static e_void nextPosForSub(IntArray& next, const String& str);
-
-e_int String::indexOf(const String& chs, e_int offset) const
+e_int String::indexOf(const StringView& chs, e_int offset) const
 {		
 	if (offset<0 || offset>=m_length)
 		throw  IndexOutOfBoundsException{__func__, __LINE__, String{L"String"}, m_length, offset};
 
-	if (chs.empty())
-		return offset;
-
-    e_int i=0, j=0, subLen=chs.length();
-	IntArray next{subLen};
-
-	nextPosForSub(next, chs);
-
-    for (i=offset, j=0; i<m_length; )
-    {
-        if (m_str[i] == chs[j])
-        {
-            j++;
-            if (j == subLen)
-            {
-                return i-j+1;
-            }
-            i++;
-        }
-        else if (j == 0)
-        {
-            i++;
-        }
-        else
-        {
-            j = next[j];
-        }
-    }
-
-    return -1;
+	return Searcher::find(m_str, m_length, chs.data(), chs.length(), offset);
 }
 
-static e_void frontPosForSub(IntArray& front, const String& str);
-
-e_int String::lastIndexOf(const String& chs, e_int offset) const 
+e_int String::lastIndexOf(const StringView& chs, e_int offset) const 
 {			
 	if (offset == -1) offset = m_length - 1;
 	
 	if (offset<0 || offset>=m_length)
 		throw  IndexOutOfBoundsException{__func__, __LINE__, String{L"String"}, m_length, offset};
 	
-	if (chs.empty())
-		return offset;
-	
-	e_int i=0, j=0, subLen=chs.length();
-	IntArray front{subLen};
-
-	frontPosForSub(front, chs);
-
-    for (i=offset, j=subLen-1; i>=0;)
-    {
-        if (m_str[i] == chs[j])
-        {
-            j--;
-            if (-1 == j)
-            {
-                return i;
-            }
-            i--;
-        }
-        else if (j == subLen-1)
-        {
-            i--;
-        }
-        else
-        {
-            j = front[j];
-        }
-    }
+	return Searcher::findLast(m_str, m_length, chs.data(), chs.length(), offset);
+}
 
-    return -1;
+e_bool String::contains(const StringView& chs) const
+{
+	return StringView{*this}.contains(chs);
 }
 
 
 String String::trim() const
 {		
-	e_int start = 0;
-	e_int end   = m_length;
-	
-	for (e_int i=0; i<m_length; i++)
-	{
-		if (Character::isWhiteSpace(m_str[i])) start++;
-		else break;
-	}
-	
-	if (start == m_length)
-	{
-		return String{};
-	}
-	
-	for (e_int i=end-1; i>0; i--)
-	{
-		if (Character::isWhiteSpace(m_str[i])) end--;
-		else break;
-	}
-	
-	return System::move(this->substring(start, end));
+	return System::move(String{StringView{*this}.trim()});
 }
 	
 String String::concat(const String& chs) const
@@ -376,27 +305,20 @@ String String::concat(const String& chs) const
 	e_int len  = chs.length() + len1;
 	
 	String cat{};
-	delete [] cat.m_str;
-	cat.m_str = new e_char[len+1];
+	cat._init(len);
 		
 	e_memcopy(cat.m_str, m_str, sizeof(e_char)*len1);
 	e_memcopy(&cat.m_str[len1], chs.m_str, sizeof(e_char)*(len-len1));
-	cat.m_str[len] = '\0';	
-	cat.m_length   = len;
 	
 	return System::move(cat);
 }
 
 String String::reverse() const {
-	e_char* chs = new e_char[m_length+1];
+	String str{};
+	e_char* chs = str._init(m_length);
 	for (e_int i=0,j=m_length-1; i<m_length; i++,j--) {
 		chs[j] = m_str[i];
 	}
-	chs[m_length] = '\0';
-	String str{};
-	delete [] str.m_str;
-	str.m_length = m_length;
-	str.m_str    = chs;
 	return System::move(str);
 }
 
@@ -418,29 +340,13 @@ String String::replace(const String& oldWord, const String& newWord) const
 	return System::move(sb.toString());
 }
 
-Vector<String> String::split(const String& sub) const {
-	e_int index    = 0;
-	e_int preIndex = 0;
+Vector<String> String::split(const StringView& sub) const {
 	Vector<String> result;
 	
-	if (sub.empty()) {
-		result.add(*this);
-		return System::move(result);
+	for (StringView::Splitter parts = StringView{*this}.split(sub); !parts.isEnd(); parts.advance()) {
+		result.emplace(parts.current());
 	}
 	
-	try {
-		while (true) {
-			index = this->indexOf(sub, index);
-			if (preIndex == index) {
-				preIndex = index = index + sub.length();
-			} else {
-				result.add(this->substring(preIndex, index));
-				if (index == -1) break;
-				preIndex = index = index + sub.length();
-			}
-		}
-	} catch (Exception& e) {}
-	
 	return System::move(result);
 }
 
@@ -456,52 +362,4 @@ e_void String::_checkStartAndEnd(e_int& start, e_int& end, const String& func, e
 }
 
 
-// ------------------------------------
-
-static e_void nextPosForSub(IntArray& next, const String& str)
-{		
-	e_int len = str.length();
-    e_int t = 0;
-    next[0] = 0;
-
-    for (e_int i=1; i<len; i++)
-    {
-        while (t>0 && (str[i] != str[t]))
-            t = next[t-1];
-
-        if (str[i] == str[t])
-        {
-            next[i] = t;
-            t = t + 1;
-        }
-        else
-		{
-			next[i] = 0;	
-		}
-    }
-}
-
-static e_void frontPosForSub(IntArray& front, const String& str)
-{		
-    e_int len = str.length();
-    e_int t = len - 1;
-    front[t] = t;
-
-    for (e_int i=t-1; i>=0; i--)
-    {
-        while ((t<len-1) && str[i] != str[t])
-            t = front[t+1];
-
-        if (str[i] == str[t])
-        {
-            front[i] = t;
-            t--;
-        }
-        else
-		{
-			front[i] = len - 1;	
-		}
-    }
-}
-
 } //Easy
\ No newline at end of file
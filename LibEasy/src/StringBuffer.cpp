@@ -20,6 +20,7 @@
 #include "Integer.hpp"
 #include "Array.hpp"
 #include "System.hpp"
+#include "Searcher.hpp"
 
 #include "EasyC.hpp"
 
@@ -121,6 +122,12 @@ StringBuffer& StringBuffer::append(const StringBuffer& buf, e_int start, e_int e
 	return *this;
 }
 
+StringBuffer& StringBuffer::append(const StringView& view) {
+	if (view.empty()) return *this;
+	_append(view.data(), view.length(), 0, view.length());
+	return *this;
+}
+
 StringBuffer& StringBuffer::append(const CharArray& buf, e_int len) {
 	if (buf.length()==0 || len==0) return *this;
 	if (len<0 || len>buf.length()) {
@@ -130,6 +137,19 @@ StringBuffer& StringBuffer::append(const CharArray& buf, e_int len) {
 	return *this;
 }
 
+StringBuffer& StringBuffer::append(e_char ch, e_int count) {
+	if (count < 0) 
+		throw IllegalArgumentException{__func__, __LINE__};
+	
+	_reserve(m_length + count);
+	for (e_int i=0; i<count; i++) {
+		m_strBuf[m_length+i] = ch;
+	}
+	m_length += count;
+	m_strBuf[m_length] = '\0';
+	return *this;
+}
+
 StringBuffer& StringBuffer::trimToLength() {
 	if (m_capacity == 16) 
 		return *this;
@@ -229,15 +249,12 @@ StringBuffer& StringBuffer::replace(const String& oldWord, const String& newWord
 	if (oldWord.empty())
 		return *this;
 		
-	e_int index = indexOf(oldWord, 0);
+	Searcher searcher{oldWord};
+	e_int index = searcher.indexOf(m_strBuf, m_length, 0);
 	
 	while (index != -1)	{
-		try {
-			replace(newWord, index, oldWord.length()+index);
-			index = indexOf(oldWord, index+newWord.length());
-		} catch (Exception& e) {
-			index = -1;
-		}
+		replace(newWord, index, oldWord.length()+index);
+		index = searcher.indexOf(m_strBuf, m_length, index+newWord.length());
 	}
 	
 	return *this;
@@ -264,10 +281,24 @@ String StringBuffer::substring(e_int start, e_int end) const
 	if (start > end) throw IllegalArgumentException{__func__, __LINE__};
 	if (start == end) end++;
 	
-	return System::move(String{m_strBuf, start, end});
+	return System::move(String{StringView{m_strBuf+start, end-start}});
+}
+
+StringView StringBuffer::view(e_int start, e_int end) const
+{
+	if (m_length == 0) return StringView{};
+	if (end == -1)	end = m_length;
+	if (start<0 || start>=m_length)
+		throw  IndexOutOfBoundsException{__func__, __LINE__, String{L"StringBuffer"}, m_length, start};
+	if (end<0 || end>m_length)
+		throw  IndexOutOfBoundsException{__func__, __LINE__, String{L"StringBuffer"}, m_length, end};
+	if (start > end) throw IllegalArgumentException{__func__, __LINE__};
+	if (start == end) end++;
+	
+	return StringView{m_strBuf+start, end-start};
 }
 
-e_int StringBuffer::indexOf(const String& str, e_int offset) const
+e_int StringBuffer::indexOf(const StringView& str, e_int offset) const
 {	
 	if (offset<0 || offset>=m_length)
 		throw  IndexOutOfBoundsException{__func__, __LINE__, String{L"StringBuffer"}, m_length, offset};
@@ -275,11 +306,11 @@ e_int StringBuffer::indexOf(const String& str, e_int offset) const
     if (str.length() == 0)
 		return offset;
 	
-	return _indexOf(str.toCStr(), str.length(), offset);
+	return _indexOf(str.data(), str.length(), offset);
 }
 
 
-e_int StringBuffer::lastIndexOf(const String& str, e_int offset) const
+e_int StringBuffer::lastIndexOf(const StringView& str, e_int offset) const
 {
 
 	if (offset == -1) offset = m_length - 1;	
@@ -290,91 +321,34 @@ e_int StringBuffer::lastIndexOf(const String& str, e_int offset) const
 	if (str.length() == 0)
 		return offset;
 	
-	return _lastIndexOf(str.toCStr(), str.length(), offset);
+	return _lastIndexOf(str.data(), str.length(), offset);
 }
 
-e_bool StringBuffer::endsWith(const String& chs) const
+e_bool StringBuffer::endsWith(const StringView& chs) const
 {			
-	if (m_length < chs.length()) return false;
-
-	for (e_int i=chs.length()-1,j=m_length-1; i>=0; i--,j--) {
-		if (m_strBuf[j] != chs[i]) return false;
-	}
-
-	return true;
+	return StringView{m_strBuf, m_length}.endsWith(chs);
 }
 
-e_bool StringBuffer::startsWith(const String& chs) const
+e_bool StringBuffer::startsWith(const StringView& chs) const
 {
-	if (m_length < chs.length()) return false;
- 
-	for (e_int i=0; i<chs.length(); i++) {
-		if (m_strBuf[i] != chs[i]) return false;
-	}
-
-	return true;
+	return StringView{m_strBuf, m_length}.startsWith(chs);
 }
 
 //-------------------------------
-static e_void frontPosForSub(IntArray& front, const e_char* chs, e_int len);
-static e_void nextPosForSub(IntArray& next, const e_char* chs, e_int len);
 
 e_int StringBuffer::_lastIndexOf(const e_char* chs, e_int len, e_int offset) const {
-	e_int i=0, j=0;
-	IntArray front{len};
-	
-	frontPosForSub(front, chs, len);
-
-    for (i=offset, j=len-1; i>=0;) {
-        if (m_strBuf[i] == chs[j]) {
-            j--;
-            if (-1 == j) {
-                return i;
-            }
-            i--;
-        } else if (j == len-1) {
-            i--;
-        } else {
-            j = front[j];
-        }
-    }
-
-    return -1;
+	return Searcher::findLast(m_strBuf, m_length, chs, len, offset);
 }
 
-e_int StringBuffer::_indexOf(const e_char* chs, e_int len, e_int offset) const
-{
-	e_int i=0, j=0;
-	IntArray next{len};
-
-	nextPosForSub(next, chs, len);
-
-    for (i=offset, j=0; i<m_length; ) {
-        if (m_strBuf[i] == chs[j]) {
-            j++;
-            if (j == len) {
-                return i-j+1;
-            }
-            i++;
-        } else if (j == 0) {
-            i++;
-        } else {
-            j = next[j];
-        }
-    }
-
-    return -1;
+e_int StringBuffer::_indexOf(const e_char* chs, e_int len, e_int offset) const {
+	return Searcher::find(m_strBuf, m_length, chs, len, offset);
 }
 
 e_void StringBuffer::_insert(const e_char* chs, e_int len, e_int offset)
 {
 	e_int resultLen = m_length + len;
 	
-	if (resultLen>m_capacity && resultLen<m_capacity*2) {
-		_updateCapa(m_capacity * 2);
-	} else if (resultLen >= m_capacity*2) {
-		_updateCapa(resultLen + 1);
-	}
+	_reserve(resultLen);
 
 	e_memmove(&m_strBuf[offset+len], &m_strBuf[offset], (m_length-offset)*sizeof(e_char));
 	e_memcopy(&m_strBuf[offset], chs, len*sizeof(e_char));
@@ -397,13 +371,9 @@ e_void StringBuffer::_remove(e_int resultLen, e_int moveLen, e_int start, e_int
 e_void StringBuffer::_append(const e_char* chs, e_int len, e_int start, e_int end)
 {
 	e_int addLen    = end - start;
-	e_int resultLen = len + m_length;
+	e_int resultLen = m_length + addLen;
 
-	if (resultLen>m_capacity && resultLen<m_capacity*2)	{
-		_updateCapa(m_capacity * 2);
-	} else if (resultLen >= m_capacity*2) {
-		_updateCapa(resultLen + 1);
-	}
+	_reserve(resultLen);
 	
 	if (addLen == 1) {
 		m_strBuf[m_length] = chs[start];
@@ -416,6 +386,15 @@ e_void StringBuffer::_append(const e_char* chs, e_int len, e_int start, e_int en
 	m_strBuf[m_length] = '\0';
 }
 
+// 保证能容纳 resultLen 个字符和结尾的 '\0'.
+e_void StringBuffer::_reserve(e_int resultLen) {
+	if (resultLen>=m_capacity && resultLen<m_capacity*2) {
+		_updateCapa(m_capacity * 2);
+	} else if (resultLen >= m_capacity*2) {
+		_updateCapa(resultLen + 1);
+	}
+}
+
 e_void StringBuffer::_updateCapa(e_int newCapa) {
 	m_capacity     = newCapa;
 	e_char* newBuf = new e_char[m_capacity];	
@@ -427,38 +406,4 @@ e_void StringBuffer::_updateCapa(e_int newCapa) {
 	m_strBuf[m_length] = '\0';
 }
 
-static e_void nextPosForSub(IntArray& next, const e_char* str, e_int len) {				
-    e_int t = 0;
-    next[0] = 0;
-
-    for (e_int i=1; i<len; i++) {
-        while (t>0 && (str[i] != str[t]))
-            t = next[t-1];
-
-        if (str[i] == str[t]) {
-            next[i] = t;
-            t = t + 1;
-        } else {
-			next[i] = 0;	
-		}
-    }
-}
-
-static e_void frontPosForSub(IntArray& front, const e_char* str, e_int len) {
-    e_int t = len - 1;
-    front[t] = t;
-
-    for (e_int i=t-1; i>=0; i--) {
-        while ((t<len-1) && str[i] != str[t])
-            t = front[t+1];
-
-        if (str[i] == str[t]) {
-            front[i] = t;
-            t--;
-        } else {
-			front[i] = len - 1;	
-		}
-    }
-}
-
 } // Easy
\ No newline at end of file
@@ -0,0 +1,180 @@
+/*
+ * 文件名: StringPool.cpp
+ *
+ * 日期/时间:
+ *		开始: 2026年10月17日 16:48:05 周六
+ *		结束:
+ *
+ * 版本: 1.0
+ *
+ * 作者: Tes Alone
+ *
+ * 备注:
+*/
+
+#include "StringPool.hpp"
+#include "StringView.hpp"
+#include "Integer.hpp"
+
+extern "C" {
+
+void WINAPI InitializeSRWLock (PSRWLOCK);
+void WINAPI AcquireSRWLockExclusive (PSRWLOCK);
+void WINAPI AcquireSRWLockShared (PSRWLOCK);
+void WINAPI ReleaseSRWLockExclusive (PSRWLOCK);
+void WINAPI ReleaseSRWLockShared (PSRWLOCK);
+
+}
+
+namespace Easy {
+
+constexpr e_int StringPool::SHARD_COUNT;
+
+/*
+	哈希值的低 4 位选择分片, 其余位选择分片内的槽位,
+	这样同一分片中的字符串在槽位上仍然分布均匀.
+*/
+static const e_int SHARD_BITS = 4;
+static const e_int INIT_CAPACITY = 64;
+
+static_assert((1 << SHARD_BITS) == StringPool::SHARD_COUNT, "SHARD_COUNT must be 2^SHARD_BITS");
+
+static inline e_int slotOf(e_int hash, e_int capacity) {
+	return (hash >> SHARD_BITS) & (capacity - 1);
+}
+
+e_int InternedString::compare(const InternedString& other) const {
+	if (m_entry == other.m_entry) return 0;
+	if (m_entry == nullptr) return -1;
+	if (other.m_entry == nullptr) return 1;
+	return m_entry->m_str.compare(other.m_entry->m_str);
+}
+
+String InternedString::toString() const {
+	return m_entry ? m_entry->m_str : String{};
+}
+
+// ------------------------------------
+
+StringPool::StringPool() {
+	for (e_int i=0; i<SHARD_COUNT; i++) {
+		Shard& shard = m_shards[i];
+		InitializeSRWLock(&shard.m_lock);
+		shard.m_capacity = INIT_CAPACITY;
+		shard.m_size     = 0;
+		shard.m_table    = new Entry*[INIT_CAPACITY];
+		for (e_int j=0; j<INIT_CAPACITY; j++) shard.m_table[j] = nullptr;
+	}
+}
+
+StringPool::~StringPool() {
+	for (e_int i=0; i<SHARD_COUNT; i++) {
+		Shard& shard = m_shards[i];
+		for (e_int j=0; j<shard.m_capacity; j++) {
+			Entry* cur = shard.m_table[j];
+			while (cur) {
+				Entry* old = cur;
+				cur = cur->m_next;
+				delete old;
+			}
+		}
+		delete [] shard.m_table;
+	}
+}
+
+InternedString StringPool::intern(const StringView& str) {
+	e_int hash   = str.hashCode();
+	Shard& shard = m_shards[hash & (SHARD_COUNT-1)];
+
+	AcquireSRWLockShared(&shard.m_lock);
+	const Entry* found = _find(shard, str, hash);
+	ReleaseSRWLockShared(&shard.m_lock);
+	if (found) return InternedString{found};
+
+	// 先在锁外复制字符串, 持有独占锁的时间只用于插入.
+	Entry* entry = new Entry{String{str}, hash, nullptr};
+
+	AcquireSRWLockExclusive(&shard.m_lock);
+	found = _find(shard, str, hash);	// 其他线程可能已经插入
+	if (found == nullptr) {
+		if (shard.m_size >= shard.m_capacity - (shard.m_capacity >> 2))
+			_rehash(shard);
+		e_int slot = slotOf(hash, shard.m_capacity);
+		entry->m_next = shard.m_table[slot];
+		shard.m_table[slot] = entry;
+		shard.m_size++;
+		found = entry;
+		entry = nullptr;
+	}
+	ReleaseSRWLockExclusive(&shard.m_lock);
+
+	delete entry;
+	return InternedString{found};
+}
+
+InternedString StringPool::lookup(const StringView& str) const {
+	e_int hash = str.hashCode();
+	const Shard& shard = m_shards[hash & (SHARD_COUNT-1)];
+
+	AcquireSRWLockShared(&shard.m_lock);
+	const Entry* found = _find(shard, str, hash);
+	ReleaseSRWLockShared(&shard.m_lock);
+
+	return InternedString{found};
+}
+
+e_int StringPool::size() const {
+	e_int total = 0;
+	for (e_int i=0; i<SHARD_COUNT; i++) {
+		AcquireSRWLockShared(&m_shards[i].m_lock);
+		total += m_shards[i].m_size;
+		ReleaseSRWLockShared(&m_shards[i].m_lock);
+	}
+	return total;
+}
+
+StringPool& StringPool::global() {
+	static StringPool* pool = new StringPool;
+	return *pool;
+}
+
+e_int StringPool::hashCode() const {
+	return Long::hashCode(reinterpret_cast<e_long>(this));
+}
+
+String StringPool::toString() const {
+	return String{L"StringPool: "} + Integer::toString(size());
+}
+
+const StringPool::Entry* StringPool::_find(const Shard& shard, const StringView& str, e_int hash) {
+	const Entry* cur = shard.m_table[slotOf(hash, shard.m_capacity)];
+	while (cur) {
+		if (cur->m_hash == hash && StringView{cur->m_str}.equals(str))
+			return cur;
+		cur = cur->m_next;
+	}
+	return nullptr;
+}
+
+e_void StringPool::_rehash(Shard& shard) {
+	e_int newCapacity = shard.m_capacity * 2;
+	Entry** newTable  = new Entry*[newCapacity];
+	for (e_int i=0; i<newCapacity; i++) newTable[i] = nullptr;
+
+	for (e_int i=0; i<shard.m_capacity; i++) {
+		Entry* cur = shard.m_table[i];
+		while (cur) {
+			Entry* next = cur->m_next;
+			e_int slot  = slotOf(cur->m_hash, newCapacity);
+			cur->m_next = newTable[slot];
+			newTable[slot] = cur;
+			cur = next;
+		}
+	}
+
+	delete [] shard.m_table;
+	shard.m_table    = newTable;
+	shard.m_capacity = newCapacity;
+}
+
+} // Easy
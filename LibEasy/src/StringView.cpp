@@ -0,0 +1,163 @@
+/*
+ * 文件名: StringView.cpp
+ *
+ * 日期/时间:
+ *		开始: 2026年10月17日 13:58:41 周六
+ *		结束:
+ *
+ * 版本: 1.0
+ *
+ * 作者: Tes Alone
+ *
+ * 备注:
+*/
+
+#include <cstring>
+
+#include "StringView.hpp"
+#include "String.hpp"
+#include "Searcher.hpp"
+#include "Character.hpp"
+#include "Exception.hpp"
+#include "EasyC.hpp"
+
+namespace Easy {
+
+StringView::StringView(const e_char* str, e_int length) {
+	if (str == nullptr)
+		throw NullPointerException{__func__, __LINE__};
+	if (length < 0)
+		throw IllegalArgumentException{__func__, __LINE__};
+	m_str    = str;
+	m_length = length;
+}
+
+StringView::StringView(const e_char* str) {
+	m_str    = str;
+	m_length = String::length(str);
+}
+
+e_bool StringView::equals(const StringView& other) const {
+	if (m_length != other.m_length) return false;
+	return ::memcmp(m_str, other.m_str, m_length*sizeof(e_char)) == 0;
+}
+
+e_int StringView::compare(const StringView& other) const {
+	e_int len = m_length < other.m_length ? m_length : other.m_length;
+
+	for (e_int i=0; i<len; i++) {
+		if (m_str[i] > other.m_str[i]) return 1;
+		if (m_str[i] < other.m_str[i]) return -1;
+	}
+
+	if (m_length == other.m_length) return 0;
+	return (m_length > other.m_length) ? 1 : -1;
+}
+
+e_int StringView::hashCode() const {
+	e_ulong h = e_hash(m_str, m_length*sizeof(e_char));
+	return (e_int)((h ^ (h >> 32)) & 0x7fffffff);
+}
+
+String StringView::toString() const {
+	return System::move(String{*this});
+}
+
+e_char StringView::charAt(e_int index) const {
+	if (index<0 || index>=m_length)
+		throw IndexOutOfBoundsException{__func__, __LINE__, String{L"StringView"}, m_length, index};
+	return m_str[index];
+}
+
+StringView StringView::substring(e_int start, e_int end) const {
+	if (m_length == 0) return StringView{};
+
+	if (end == -1) end = m_length;
+	if (start<0 || start>=m_length)
+		throw IndexOutOfBoundsException{__func__, __LINE__, String{L"StringView"}, m_length, start};
+	if (end<0 || end>m_length)
+		throw IndexOutOfBoundsException{__func__, __LINE__, String{L"StringView"}, m_length, end};
+	if (start > end)
+		throw IllegalArgumentException{__func__, __LINE__};
+	if (start == end) end++;
+
+	return StringView{m_str+start, end-start};
+}
+
+StringView StringView::trim() const {
+	e_int start = 0;
+	e_int end   = m_length;
+
+	while (start<end && Character::isWhiteSpace(m_str[start])) start++;
+	while (end>start && Character::isWhiteSpace(m_str[end-1])) end--;
+
+	return StringView{m_str+start, end-start};
+}
+
+e_int StringView::indexOf(const StringView& sub, e_int offset) const {
+	if (offset<0 || offset>=m_length) return -1;
+	return Searcher::find(m_str, m_length, sub.m_str, sub.m_length, offset);
+}
+
+e_int StringView::lastIndexOf(const StringView& sub, e_int offset) const {
+	if (offset == -1) offset = m_length - 1;
+	if (offset<0 || offset>=m_length) return -1;
+	return Searcher::findLast(m_str, m_length, sub.m_str, sub.m_length, offset);
+}
+
+e_bool StringView::startsWith(const StringView& sub) const {
+	if (m_length < sub.m_length) return false;
+	return ::memcmp(m_str, sub.m_str, sub.m_length*sizeof(e_char)) == 0;
+}
+
+e_bool StringView::endsWith(const StringView& sub) const {
+	if (m_length < sub.m_length) return false;
+	return ::memcmp(m_str+m_length-sub.m_length, sub.m_str, sub.m_length*sizeof(e_char)) == 0;
+}
+
+StringView::Splitter StringView::split(const StringView& sep) const {
+	return Splitter{*this, sep};
+}
+
+// ------------------------------------
+
+StringView::Splitter::Splitter(const StringView& str, const StringView& sep)
+	: m_str(str), m_sep(sep), m_next(0), m_end(false) {
+	if (m_sep.empty()) {
+		m_current = m_str;
+		m_next    = m_str.length();
+	} else {
+		advance();
+	}
+}
+
+const StringView& StringView::Splitter::current() const {
+	if (m_end)
+		throw IteratorIsEndException{__func__, __LINE__};
+	return m_current;
+}
+
+e_bool StringView::Splitter::advance() {
+	e_int len = m_str.length();
+
+	if (m_sep.empty()) {
+		m_end = true;
+		return false;
+	}
+
+	while (m_next < len) {
+		e_int index = Searcher::find(m_str.m_str, len, m_sep.m_str, m_sep.m_length, m_next);
+		if (index == -1) index = len;
+		if (index > m_next) {
+			m_current = StringView{m_str.m_str+m_next, index-m_next};
+			m_next    = index + m_sep.m_length;
+			return true;
+		}
+		m_next = index + m_sep.m_length;
+	}
+
+	m_end = true;
+	return false;
+}
+
+} // Easy
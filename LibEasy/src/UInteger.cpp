@@ -15,39 +15,36 @@
 
 #include "UInteger.hpp"
 #include "EasyC.hpp"
+#include "StringBuffer.hpp"
 
 namespace Easy {
 
 extern e_byte digitChar[16];
 
+extern e_int writeUnsigned(e_ulong v, e_int radix, e_char* out);
+extern e_int writeUnsigned(e_ulong v, e_int radix, e_byte* out);
+
+e_int UInteger::writeTo(e_uint i, e_char* out, e_int radix) {
+	return writeUnsigned(i, radix, out);
+}
+
+e_int UInteger::writeTo(e_uint i, e_byte* out, e_int radix) {
+	return writeUnsigned(i, radix, out);
+}
+
+StringBuffer& UInteger::appendTo(StringBuffer& sb, e_uint i, e_int radix) {
+	e_char buf[MAX_CHARS];
+	return sb.append(StringView{buf, writeUnsigned(i, radix, buf)});
+}
+
 String UInteger::toHexString(e_uint i) {
-	e_char buf[9];
-    e_int  charPos  = 8;
-	buf[charPos--] = '\0';
-	
-	while (i >= 16)
-	{
-		buf[charPos--] = digitChar[i & 0xF];
-		i = i >> 4;
-	}
-	
-	buf[charPos] = digitChar[i];	
-	return System::move(String{&buf[charPos]});
+	e_char buf[MAX_CHARS];
+	return System::move(String{StringView{buf, writeTo(i, buf, 16)}});
 }
 
 String UInteger::toString(e_uint i) {
-	e_char buf[20];
-    e_int  charPos  = 19;
-	buf[charPos--] = '\0';
-	
-	while (i >= 10)
-	{
-		buf[charPos--] = (i%10) + '0';
-		i = i / 10;
-	}
-	
-	buf[charPos] = i + '0';	
-	return System::move(String{&buf[charPos]});	
+	e_char buf[MAX_CHARS];
+	return System::move(String{StringView{buf, writeTo(i, buf)}});
 }
 
 String UInteger::toString(e_uint i, e_int radix) {
@@ -64,33 +61,13 @@ String UInteger::toString(e_uint i, e_int radix) {
 }
 
 String UInteger::toOctString(e_uint i) {
-	e_char buf[20];
-    e_int  charPos  = 19;
-	buf[charPos--] = '\0';
-	
-	while (i >= 8)
-	{
-		buf[charPos--] = (i&07) + '0';
-		i = i >> 3;
-	}
-	
-	buf[charPos] = i + '0';	
-	return System::move(String{&buf[charPos]});
+	e_char buf[MAX_CHARS];
+	return System::move(String{StringView{buf, writeTo(i, buf, 8)}});
 }
 
 String UInteger::toBinaryString(e_uint i) {
-	e_char buf[33];
-    e_int  charPos  = 32;
-	buf[charPos--] = '\0';
-	
-	while (i >= 2)
-	{
-		buf[charPos--] = (i&1) + '0';
-		i = i >> 1;
-	}
-	
-	buf[charPos] = i + '0';	
-	return System::move(String{&buf[charPos]});
+	e_char buf[MAX_CHARS];
+	return System::move(String{StringView{buf, writeTo(i, buf, 2)}});
 }
 
 e_uint UInteger::parse(const String& s) {	
@@ -237,6 +214,19 @@ e_uint UInteger::parse(const String& s, e_int radix) {
 	return parse(s);
 }
 
+e_int ULong::writeTo(e_ulong l, e_char* out, e_int radix) {
+	return writeUnsigned(l, radix, out);
+}
+
+e_int ULong::writeTo(e_ulong l, e_byte* out, e_int radix) {
+	return writeUnsigned(l, radix, out);
+}
+
+StringBuffer& ULong::appendTo(StringBuffer& sb, e_ulong l, e_int radix) {
+	e_char buf[MAX_CHARS];
+	return sb.append(StringView{buf, writeUnsigned(l, radix, buf)});
+}
+
 String ULong::toString(e_ulong l, e_int radix) {
 	if (radix == 2) {
 		return toBinaryString(l);
@@ -251,63 +241,23 @@ String ULong::toString(e_ulong l, e_int radix) {
 }
 
 String ULong::toString(e_ulong l) {
-    e_char buf[32];
-    e_int  charPos  = 31;
-	buf[charPos--] = '\0';
-	
-	while (l >= 10)
-	{
-		buf[charPos--] = (l % 10) + '0';
-		l = l / 10;
-	}
-	
-	buf[charPos] = l + '0';	
-	return System::move(String{&buf[charPos]});
+	e_char buf[MAX_CHARS];
+	return System::move(String{StringView{buf, writeTo(l, buf)}});
 }
 
 String ULong::toHexString(e_ulong l) {
-    e_char buf[17];
-    e_int  charPos  = 16;
-	buf[charPos--] = '\0';
-	
-	while (l >= 16)
-	{
-		buf[charPos--] = digitChar[(l & 0xF)];
-		l = l >> 4;
-	}
-	
-	buf[charPos] = digitChar[l];	
-	return System::move(String{&buf[charPos]});
+	e_char buf[MAX_CHARS];
+	return System::move(String{StringView{buf, writeTo(l, buf, 16)}});
 }
 
 String ULong::toOctString(e_ulong l) {
-    e_char buf[23];
-    e_int  charPos  = 22;
-	buf[charPos--] = '\0';
-	
-	while (l >= 8)
-	{
-		buf[charPos--] = (l & 07) + '0';
-		l = l >> 3;
-	}
-	
-	buf[charPos] = l + '0';	
-	return System::move(String{&buf[charPos]});
+	e_char buf[MAX_CHARS];
+	return System::move(String{StringView{buf, writeTo(l, buf, 8)}});
 }
 
 String ULong::toBinaryString(e_ulong l) {
-    e_char buf[65];
-    e_int  charPos  = 64;
-	buf[charPos--] = '\0';
-	
-	while (l >= 2)
-	{
-		buf[charPos--] = (l & 1) + '0';
-		l = l >> 1;
-	}
-	
-	buf[charPos] = l + '0';	
-	return System::move(String{&buf[charPos]});
+	e_char buf[MAX_CHARS];
+	return System::move(String{StringView{buf, writeTo(l, buf, 2)}});
 }
 
 e_ulong ULong::parse(const String& s) {		
@@ -0,0 +1,598 @@
+/*
+ * 文件名: Utf8String.cpp
+ *
+ * 日期/时间:
+ *		开始: 2026年10月17日 15:41:09 周六
+ *		结束:
+ *
+ * 版本: 1.0
+ *
+ * 作者: Tes Alone
+ *
+ * 备注:
+*/
+
+#include <cstring>
+#include <cwchar>
+#include <emmintrin.h>
+
+#include "Utf8String.hpp"
+#include "Searcher.hpp"
+#include "Vector.hpp"
+#include "Exception.hpp"
+#include "EasyC.hpp"
+
+namespace Easy {
+
+constexpr e_int Utf8String::SSO_CAPACITY;
+
+static const e_int REPLACEMENT = 0xfffd;
+
+// 每次向量处理 16 个 ASCII 字符.
+static const e_int BLOCK = sizeof(__m128i);
+
+static inline __m128i load(const e_void* p) {
+	return _mm_loadu_si128((const __m128i*)p);
+}
+
+/*
+	检查从 chs 开始的 16 个 e_char 是否都是 ASCII, 并把它们压缩为 16 个字节.
+	只有 ascii 为真时返回值才有意义.
+*/
+#if WCHAR_MAX > 0xffff
+static inline __m128i narrow(const e_char* chs, e_bool& ascii) {
+	__m128i a = load(chs), b = load(chs+4), c = load(chs+8), d = load(chs+12);
+	__m128i any = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+	__m128i high = _mm_and_si128(any, _mm_set1_epi32((e_int)0xffffff80));
+	ascii = _mm_movemask_epi8(_mm_cmpeq_epi32(high, _mm_setzero_si128())) == 0xffff;
+	return _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d));
+}
+
+static inline e_void widen(__m128i v, e_char* out) {
+	const __m128i zero = _mm_setzero_si128();
+	__m128i lo = _mm_unpacklo_epi8(v, zero);
+	__m128i hi = _mm_unpackhi_epi8(v, zero);
+	_mm_storeu_si128((__m128i*)(out),    _mm_unpacklo_epi16(lo, zero));
+	_mm_storeu_si128((__m128i*)(out+4),  _mm_unpackhi_epi16(lo, zero));
+	_mm_storeu_si128((__m128i*)(out+8),  _mm_unpacklo_epi16(hi, zero));
+	_mm_storeu_si128((__m128i*)(out+12), _mm_unpackhi_epi16(hi, zero));
+}
+#else
+static inline __m128i narrow(const e_char* chs, e_bool& ascii) {
+	__m128i a = load(chs), b = load(chs+8);
+	__m128i high = _mm_and_si128(_mm_or_si128(a, b), _mm_set1_epi16((e_short)0xff80));
+	ascii = _mm_movemask_epi8(_mm_cmpeq_epi16(high, _mm_setzero_si128())) == 0xffff;
+	return _mm_packus_epi16(a, b);
+}
+
+static inline e_void widen(__m128i v, e_char* out) {
+	const __m128i zero = _mm_setzero_si128();
+	_mm_storeu_si128((__m128i*)(out),   _mm_unpacklo_epi8(v, zero));
+	_mm_storeu_si128((__m128i*)(out+8), _mm_unpackhi_epi8(v, zero));
+}
+#endif
+
+/*
+	读取 chs[i] 开始的一个代码点, i 移动到下一个字符.
+	UTF-16 的代理对合并为一个代码点, 不成对的代理项和超出范围的值替换为 U+FFFD.
+*/
+static inline e_int nextCodePoint(const e_char* chs, e_int& i, e_int length) {
+	e_uint c = (e_uint)chs[i++];
+#if WCHAR_MAX > 0xffff
+	if ((c>=0xd800 && c<=0xdfff) || c>0x10ffff) return REPLACEMENT;
+#else
+	c &= 0xffff;
+	if (c>=0xd800 && c<=0xdfff) {
+		if (c<=0xdbff && i<length) {
+			e_uint low = (e_uint)chs[i] & 0xffff;
+			if (low>=0xdc00 && low<=0xdfff) {
+				i++;
+				return 0x10000 + ((c-0xd800) << 10) + (low-0xdc00);
+			}
+		}
+		return REPLACEMENT;
+	}
+#endif
+	return (e_int)c;
+}
+
+static inline e_int encodedSize(e_int cp) {
+	if (cp < 0x80)    return 1;
+	if (cp < 0x800)   return 2;
+	if (cp < 0x10000) return 3;
+	return 4;
+}
+
+static inline e_int putUtf8(e_int cp, e_byte* out) {
+	if (cp < 0x80) {
+		out[0] = (e_byte)cp;
+		return 1;
+	}
+	if (cp < 0x800) {
+		out[0] = (e_byte)(0xc0 | (cp >> 6));
+		out[1] = (e_byte)(0x80 | (cp & 0x3f));
+		return 2;
+	}
+	if (cp < 0x10000) {
+		out[0] = (e_byte)(0xe0 | (cp >> 12));
+		out[1] = (e_byte)(0x80 | ((cp >> 6) & 0x3f));
+		out[2] = (e_byte)(0x80 | (cp & 0x3f));
+		return 3;
+	}
+	out[0] = (e_byte)(0xf0 | (cp >> 18));
+	out[1] = (e_byte)(0x80 | ((cp >> 12) & 0x3f));
+	out[2] = (e_byte)(0x80 | ((cp >> 6) & 0x3f));
+	out[3] = (e_byte)(0x80 | (cp & 0x3f));
+	return 4;
+}
+
+static inline e_int putChar(e_int cp, e_char* out) {
+#if WCHAR_MAX <= 0xffff
+	if (cp >= 0x10000) {
+		cp -= 0x10000;
+		out[0] = (e_char)(0xd800 | (cp >> 10));
+		out[1] = (e_char)(0xdc00 | (cp & 0x3ff));
+		return 2;
+	}
+#endif
+	out[0] = (e_char)cp;
+	return 1;
+}
+
+// 解码一个多字节字符, 调用者保证编码合法.
+static inline e_int getUtf8(const e_ubyte* s, e_int& i) {
+	e_int c = s[i];
+	if (c < 0x80) {
+		i += 1;
+		return c;
+	}
+	if (c < 0xe0) {
+		c = ((c & 0x1f) << 6) | (s[i+1] & 0x3f);
+		i += 2;
+	} else if (c < 0xf0) {
+		c = ((c & 0x0f) << 12) | ((s[i+1] & 0x3f) << 6) | (s[i+2] & 0x3f);
+		i += 3;
+	} else {
+		c = ((c & 0x07) << 18) | ((s[i+1] & 0x3f) << 12) | ((s[i+2] & 0x3f) << 6) | (s[i+3] & 0x3f);
+		i += 4;
+	}
+	return c;
+}
+
+/*
+	检查 s[i] 开始的多字节字符, 返回它的字节数, 不合法返回 0.
+	第二个字节的范围按 Unicode 标准表 3-7 收紧, 以拒绝过长编码、代理项和超过 U+10FFFF 的值.
+*/
+static inline e_int checkSequence(const e_ubyte* s, e_int i, e_int length) {
+	e_ubyte c  = s[i];
+	e_ubyte lo = 0x80;
+	e_ubyte hi = 0xbf;
+	e_int   n;
+
+	if (c>=0xc2 && c<=0xdf) {
+		n = 2;
+	} else if (c>=0xe0 && c<=0xef) {
+		n = 3;
+		if (c == 0xe0) lo = 0xa0;
+		else if (c == 0xed) hi = 0x9f;
+	} else if (c>=0xf0 && c<=0xf4) {
+		n = 4;
+		if (c == 0xf0) lo = 0x90;
+		else if (c == 0xf4) hi = 0x8f;
+	} else {
+		return 0;
+	}
+
+	if (length-i < n) return 0;
+	if (s[i+1]<lo || s[i+1]>hi) return 0;
+	for (e_int k=2; k<n; k++)
+		if ((s[i+k] & 0xc0) != 0x80) return 0;
+	return n;
+}
+
+/*
+	统计不是后续字节 (0x80~0xbf) 的字节数, 也就是代码点的个数.
+	pairs 为真时, 四字节字符 (首字节 >= 0xf0) 多算一次, 得到 UTF-16 的长度.
+*/
+static e_int countUnits(const e_byte* bytes, e_int length, e_bool pairs) {
+	const e_ubyte* s = (const e_ubyte*)bytes;
+	const __m128i cont = _mm_set1_epi8((e_byte)0xbf);
+	const __m128i four = _mm_set1_epi8((e_byte)0xf0);
+	e_int count = 0;
+	e_int i     = 0;
+
+	for (; i+BLOCK<=length; i+=BLOCK) {
+		__m128i v = load(s+i);
+		count += __builtin_popcount(_mm_movemask_epi8(_mm_cmpgt_epi8(v, cont)));
+		if (pairs)
+			count += __builtin_popcount(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(v, four), v)));
+	}
+
+	for (; i<length; i++) {
+		if ((s[i] & 0xc0) != 0x80) count++;
+		if (pairs && s[i] >= 0xf0) count++;
+	}
+
+	return count;
+}
+
+e_int Utf8String::validate(const e_byte* bytes, e_int length) {
+	const e_ubyte* s = (const e_ubyte*)bytes;
+	e_int i = 0;
+
+	while (i < length) {
+		for (; i+BLOCK<=length; i+=BLOCK) {
+			e_uint mask = _mm_movemask_epi8(load(s+i));
+			if (mask != 0) {
+				i += __builtin_ctz(mask);
+				break;
+			}
+		}
+		if (i >= length) break;
+
+		if (s[i] < 0x80) {
+			i++;
+			continue;
+		}
+		e_int n = checkSequence(s, i, length);
+		if (n == 0) return i;
+		i += n;
+	}
+
+	return -1;
+}
+
+e_int Utf8String::decodedLength(const e_byte* bytes, e_int length) {
+	return countUnits(bytes, length, WCHAR_MAX <= 0xffff);
+}
+
+e_int Utf8String::decode(const e_byte* bytes, e_int length, e_char* out) {
+	const e_ubyte* s = (const e_ubyte*)bytes;
+	e_int i = 0;
+	e_int o = 0;
+
+	while (i < length) {
+		for (; i+BLOCK<=length; i+=BLOCK, o+=BLOCK) {
+			__m128i v   = load(s+i);
+			e_uint mask = _mm_movemask_epi8(v);
+			if (mask != 0) {
+				for (e_int end=i+__builtin_ctz(mask); i<end; i++)
+					out[o++] = s[i];
+				break;
+			}
+			widen(v, out+o);
+		}
+		if (i >= length) break;
+
+		o += putChar(getUtf8(s, i), out+o);
+	}
+
+	return o;
+}
+
+e_int Utf8String::encodedLength(const e_char* chs, e_int length) {
+	e_int count = 0;
+	e_int i     = 0;
+
+	while (i < length) {
+		for (; i+BLOCK<=length; i+=BLOCK, count+=BLOCK) {
+			e_bool ascii;
+			narrow(chs+i, ascii);
+			if (!ascii) break;
+		}
+		if (i >= length) break;
+
+		count += encodedSize(nextCodePoint(chs, i, length));
+	}
+
+	return count;
+}
+
+e_int Utf8String::encode(const e_char* chs, e_int length, e_byte* out) {
+	e_int i = 0;
+	e_int o = 0;
+
+	while (i < length) {
+		for (; i+BLOCK<=length; i+=BLOCK, o+=BLOCK) {
+			e_bool ascii;
+			__m128i v = narrow(chs+i, ascii);
+			if (!ascii) break;
+			_mm_storeu_si128((__m128i*)(out+o), v);
+		}
+		if (i >= length) break;
+
+		o += putUtf8(nextCodePoint(chs, i, length), out+o);
+	}
+
+	return o;
+}
+
+// ------------------------------------
+
+Utf8String::Utf8String(const e_byte* bytes) {
+	if (bytes == nullptr)
+		throw NullPointerException{__func__, __LINE__};
+	_assign(bytes, ::strlen(bytes));
+}
+
+Utf8String::Utf8String(const e_byte* bytes, e_int length) {
+	if (bytes == nullptr)
+		throw NullPointerException{__func__, __LINE__};
+	if (length < 0)
+		throw IllegalArgumentException{__func__, __LINE__};
+	_assign(bytes, length);
+}
+
+Utf8String::Utf8String(const StringView& str) {
+	_init(encodedLength(str.data(), str.length()));
+	encode(str.data(), str.length(), m_str);
+}
+
+Utf8String::Utf8String(const Utf8String& copy) {
+	_share(copy);
+}
+
+Utf8String::Utf8String(Utf8String&& move) {
+	_steal(move);
+}
+
+Utf8String& Utf8String::operator=(const Utf8String& copy) {
+	if (this == &copy) return *this;
+	if (m_str != m_buf) _release();
+	_share(copy);
+	return *this;
+}
+
+Utf8String& Utf8String::operator=(Utf8String&& move) {
+	if (this == &move) return *this;
+	if (m_str != m_buf) _release();
+	_steal(move);
+	return *this;
+}
+
+// 共享内存的布局同 String: [引用计数][字节...'\0'].
+static const e_int SHARED_HEADER = sizeof(e_long);
+
+static inline e_long* sharedCount(const e_byte* bytes) {
+	return (e_long*)((e_ubyte*)bytes - SHARED_HEADER);
+}
+
+e_byte* Utf8String::_allocShared(e_int length) {
+	e_ubyte* block = new e_ubyte[SHARED_HEADER + length + 1];
+	*(e_long*)block = 1;
+	return (e_byte*)(block + SHARED_HEADER);
+}
+
+e_void Utf8String::_share(const Utf8String& copy) {
+	m_length = copy.m_length;
+	m_hash   = __atomic_load_n(&copy.m_hash, __ATOMIC_RELAXED);
+	if (copy.m_str == copy.m_buf) {
+		m_str = m_buf;
+		e_memcopy(m_buf, copy.m_buf, m_length+1);
+	} else {
+		m_str = copy.m_str;
+		__atomic_add_fetch(sharedCount(m_str), 1, __ATOMIC_RELAXED);
+	}
+}
+
+e_void Utf8String::_release() {
+	e_long* count = sharedCount(m_str);
+	if (__atomic_sub_fetch(count, 1, __ATOMIC_ACQ_REL) == 0)
+		delete [] (e_ubyte*)count;
+}
+
+e_void Utf8String::_steal(Utf8String& move) {
+	m_length = move.m_length;
+	m_hash   = move.m_hash;
+	if (move.m_str == move.m_buf) {
+		m_str = m_buf;
+		e_memcopy(m_buf, move.m_buf, m_length+1);
+	} else {
+		m_str = move.m_str;
+	}
+	move.m_str    = move.m_buf;
+	move.m_length = 0;
+	move.m_hash   = -1;
+	move.m_buf[0] = '\0';
+}
+
+e_void Utf8String::_assign(const e_byte* bytes, e_int length) {
+	if (validate(bytes, length) != -1)
+		throw IllegalArgumentException{__func__, __LINE__};
+	_init(length);
+	e_memcopy(m_str, bytes, length);
+}
+
+e_bool Utf8String::_isBoundary(e_int index) const {
+	return index == m_length || (m_str[index] & 0xc0) != 0x80;
+}
+
+// ------------------------------------
+
+e_bool Utf8String::equals(const Utf8String& other) const {
+	if (m_length != other.m_length) return false;
+	return ::memcmp(m_str, other.m_str, m_length) == 0;
+}
+
+e_int Utf8String::compare(const Utf8String& other) const {
+	e_int len  = m_length < other.m_length ? m_length : other.m_length;
+	e_int flag = ::memcmp(m_str, other.m_str, len);
+
+	if (flag != 0) return flag > 0 ? 1 : -1;
+	if (m_length == other.m_length) return 0;
+	return (m_length > other.m_length) ? 1 : -1;
+}
+
+// 同 String::hashCode().
+e_int Utf8String::hashCode() const {
+	e_int hash = __atomic_load_n(&m_hash, __ATOMIC_RELAXED);
+	if (hash < 0) {
+		e_ulong h = e_hash(m_str, m_length);
+		hash = (e_int)((h ^ (h >> 32)) & 0x7fffffff);
+		__atomic_store_n(&m_hash, hash, __ATOMIC_RELAXED);
+	}
+	return hash;
+}
+
+String Utf8String::toString() const {
+	String str{};
+	decode(m_str, m_length, str._init(decodedLength(m_str, m_length)));
+	return System::move(str);
+}
+
+e_int Utf8String::codePointCount() const {
+	return countUnits(m_str, m_length, false);
+}
+
+e_int Utf8String::codePointAt(e_int index) const {
+	if (index<0 || index>=m_length)
+		throw IndexOutOfBoundsException{__func__, __LINE__, String{L"Utf8String"}, m_length, index};
+	if (!_isBoundary(index))
+		throw IllegalArgumentException{__func__, __LINE__};
+	return getUtf8((const e_ubyte*)m_str, index);
+}
+
+Utf8String Utf8String::substring(e_int start, e_int end) const {
+	if (m_length == 0) return Utf8String{};
+
+	if (end == -1) end = m_length;
+	if (start<0 || start>=m_length)
+		throw IndexOutOfBoundsException{__func__, __LINE__, String{L"Utf8String"}, m_length, start};
+	if (end<0 || end>m_length)
+		throw IndexOutOfBoundsException{__func__, __LINE__, String{L"Utf8String"}, m_length, end};
+	if (start > end)
+		throw IllegalArgumentException{__func__, __LINE__};
+	if (!_isBoundary(start) || !_isBoundary(end))
+		throw IllegalArgumentException{__func__, __LINE__};
+	// 同 String::substring(), start 等于 end 时取 start 处的一个字符.
+	if (start == end) getUtf8((const e_ubyte*)m_str, end);
+
+	Utf8String sub{};
+	e_memcopy(sub._init(end-start), m_str+start, end-start);
+	return System::move(sub);
+}
+
+e_bool Utf8String::startsWith(const Utf8String& sub) const {
+	if (m_length < sub.m_length) return false;
+	return ::memcmp(m_str, sub.m_str, sub.m_length) == 0;
+}
+
+e_bool Utf8String::endsWith(const Utf8String& sub) const {
+	if (m_length < sub.m_length) return false;
+	return ::memcmp(m_str+m_length-sub.m_length, sub.m_str, sub.m_length) == 0;
+}
+
+/*
+	合法的 UTF-8 可以自同步: 非空子串以首字节开始, 所以按字节匹配到的位置总在字符边界上.
+*/
+e_int Utf8String::indexOf(const Utf8String& sub, e_int offset) const {
+	if (offset<0 || offset>=m_length) return -1;
+	return Searcher::find(m_str, m_length, sub.m_str, sub.m_length, offset);
+}
+
+e_int Utf8String::lastIndexOf(const Utf8String& sub, e_int offset) const {
+	if (offset == -1) offset = m_length - 1;
+	if (offset<0 || offset>=m_length) return -1;
+	return Searcher::findLast(m_str, m_length, sub.m_str, sub.m_length, offset);
+}
+
+Utf8String Utf8String::toUpperCase() const {
+	Utf8String upper{};
+	e_byte* bytes = upper._init(m_length);
+
+	for (e_int i=0; i<m_length; i++) {
+		e_byte b = m_str[i];
+		bytes[i] = (b>='a' && b<='z') ? b-'a'+'A' : b;
+	}
+
+	return System::move(upper);
+}
+
+Utf8String Utf8String::toLowerCase() const {
+	Utf8String lower{};
+	e_byte* bytes = lower._init(m_length);
+
+	for (e_int i=0; i<m_length; i++) {
+		e_byte b = m_str[i];
+		bytes[i] = (b>='A' && b<='Z') ? b-'A'+'a' : b;
+	}
+
+	return System::move(lower);
+}
+
+static inline e_bool isAsciiSpace(e_byte b) {
+	return b==' ' || (b>='\t' && b<='\r');
+}
+
+Utf8String Utf8String::trim() const {
+	e_int start = 0;
+	e_int end   = m_length;
+
+	while (start<end && isAsciiSpace(m_str[start])) start++;
+	while (end>start && isAsciiSpace(m_str[end-1])) end--;
+
+	if (start==0 && end==m_length) return *this;
+
+	Utf8String trimmed{};
+	e_memcopy(trimmed._init(end-start), m_str+start, end-start);
+	return System::move(trimmed);
+}
+
+Utf8String Utf8String::concat(const Utf8String& other) const {
+	Utf8String cat{};
+	e_byte* bytes = cat._init(m_length + other.m_length);
+
+	e_memcopy(bytes, m_str, m_length);
+	e_memcopy(bytes+m_length, other.m_str, other.m_length);
+	return System::move(cat);
+}
+
+Utf8String Utf8String::replace(const Utf8String& oldWord, const Utf8String& newWord) const {
+	if (oldWord.empty())
+		return *this;
+
+	e_int count = 0;
+	for (e_int i=indexOf(oldWord); i!=-1; i=indexOf(oldWord, i+oldWord.m_length))
+		count++;
+	if (count == 0) return *this;
+
+	Utf8String result{};
+	e_byte* bytes = result._init(m_length + count*(newWord.m_length-oldWord.m_length));
+	e_int from = 0;
+
+	for (e_int i=indexOf(oldWord); i!=-1; i=indexOf(oldWord, from)) {
+		e_memcopy(bytes, m_str+from, i-from);
+		bytes += i - from;
+		e_memcopy(bytes, newWord.m_str, newWord.m_length);
+		bytes += newWord.m_length;
+		from = i + oldWord.m_length;
+	}
+	e_memcopy(bytes, m_str+from, m_length-from);
+
+	return System::move(result);
+}
+
+Vector<Utf8String> Utf8String::split(const Utf8String& sub) const {
+	Vector<Utf8String> result;
+
+	if (sub.empty()) {
+		result.add(*this);
+		return System::move(result);
+	}
+
+	e_int next = 0;
+	while (next < m_length) {
+		e_int index = Searcher::find(m_str, m_length, sub.m_str, sub.m_length, next);
+		if (index == -1) index = m_length;
+		if (index > next) {
+			Utf8String part{};
+			e_memcopy(part._init(index-next), m_str+next, index-next);
+			result.add(System::move(part));
+		}
+		next = index + sub.m_length;
+	}
+
+	return System::move(result);
+}
+
+} // Easy
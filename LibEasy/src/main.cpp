@@ -41,11 +41,6 @@ int main(int argc, char** argv)
 		args.setAt(i, String{wide.toCArray()});
 	}
 	
-	SYSTEMTIME st;
-    GetSystemTime(&st);
-
-    ::srand(st.wMilliseconds);
-	
 	e_int result = 0;
 	
 	try {
@@ -20,6 +20,7 @@
 using namespace Easy;
 
 #include <pthread.h>
+#include <cmath>
 
 e_void test0(); 
 e_void test1();
@@ -537,6 +538,1039 @@ e_void testInteger3() {
 	Console::outln(T::parse(str, 16));
 }
 
+// e_memcopy 各级别与 memcpy 的比较, 每个长度共复制 1GB.
+e_void testMemCopy() {
+	const e_int sizes[] = {7, 16, 100, 1024, 64*1024, 1024*1024, 16*1024*1024};
+	const e_long total  = 1024L * 1024 * 1024;
+	e_int best = e_memlevel();
+	UByteArray src{16*1024*1024 + 64};
+	UByteArray des{16*1024*1024 + 64};
+	TimeCounter tc;
+	for (e_int size : sizes) {
+		e_long rounds = total / size;
+		Console::out(String{L"size "} + Integer{size} + L":");
+		for (e_int level=E_MEM_SCALAR; level<=best; level++) {
+			e_setmemlevel(level);
+			tc.start();
+			for (e_long i=0; i<rounds; i++) {
+				e_memcopy(des.toCArray()+(i&31), src.toCArray()+1, size);
+			}
+			tc.stop();
+			Console::out(String{L" level"} + Integer{level} + L"=" + Long{tc.getTimeMillis()} + L"ms");
+		}
+		tc.start();
+		for (e_long i=0; i<rounds; i++) {
+			::memcpy(des.toCArray()+(i&31), src.toCArray()+1, size);
+		}
+		tc.stop();
+		Console::outln(String{L" memcpy="} + Long{tc.getTimeMillis()} + L"ms");
+	}
+	e_setmemlevel(best);
+}
+
+e_void testStringMap() {
+	const e_int count = 1000000;
+	Vector<String> keys;
+	for (e_int i=0; i<count; i++) {
+		keys.add(String{L"k"} + Integer{i});
+	}
+	HashMap<String, String> map;
+	TimeCounter tc;
+	tc.start();
+	for (e_int i=0; i<count; i++) {
+		map.put(keys[i], Integer{i}.toString());
+	}
+	tc.stop();
+	Console::outln(String{L"put: "} + Long{tc.getTimeMillis()} + L"ms");
+	e_long total = 0;
+	tc.start();
+	for (e_int i=0; i<count; i++) {
+		total += map.get(keys[i]).length();
+	}
+	tc.stop();
+	Console::outln(String{L"get: "} + Long{tc.getTimeMillis()} + L"ms");
+	Console::outln(Long{total});
+}
+
+e_void testSearch() {
+	StringBuffer sb;
+	for (e_int i=0; i<20000; i++) {
+		sb.append(String{L"lorem ipsum dolor sit amet, consectetur "});
+	}
+	sb.append(String{L"needle-in-the-haystack"});
+	String text = sb.toString();
+	String shortSub{L"needle"};
+	Searcher longSub{String{L"lorem ipsum dolor sit amet, consectetur needle-in-the"}};
+	e_long total = 0;
+	TimeCounter tc;
+	tc.start();
+	for (e_int i=0; i<200; i++) {
+		total += text.indexOf(shortSub);
+	}
+	tc.stop();
+	Console::outln(String{L"short: "} + Long{tc.getTimeMillis()} + L"ms");
+	tc.start();
+	for (e_int i=0; i<200; i++) {
+		total += longSub.indexOf(text);
+	}
+	tc.stop();
+	Console::outln(String{L"long: "} + Long{tc.getTimeMillis()} + L"ms");
+	tc.start();
+	for (e_int i=0; i<200; i++) {
+		total += text.lastIndexOf(String{L"XYZ"});
+	}
+	tc.stop();
+	Console::outln(String{L"last: "} + Long{tc.getTimeMillis()} + L"ms");
+	Console::outln(Long{total});
+}
+
+e_void testSplit() {
+	String line = String{L"2026-10-17 13:58:41 INFO worker-3 request done, "} * 20000;
+	e_long total = 0;
+	TimeCounter tc;
+	tc.start();
+	Vector<String> words = line.split(String{L" "});
+	for (e_int i=0; i<words.size(); i++) {
+		total += words[i].trim().length();
+	}
+	tc.stop();
+	Console::outln(String{L"split: "} + Long{tc.getTimeMillis()} + L"ms");
+	tc.start();
+	for (StringView::Splitter parts = line.view().split(L" "); !parts.isEnd(); parts.advance()) {
+		total += parts.current().trim().length();
+	}
+	tc.stop();
+	Console::outln(String{L"view split: "} + Long{tc.getTimeMillis()} + L"ms");
+	Console::outln(Long{total});
+}
+
+e_void testTreeMapCopy() {
+	TreeMap<String, String> map;
+	for (e_int i=0; i<1000000; i++) {
+		map.put(String{L"element-key-"} + Integer{i}, String{L"element-value-"} + Integer{i});
+	}
+	TimeCounter tc;
+	tc.start();
+	TreeMap<String, String> copy{map};
+	tc.stop();
+	Console::outln(String{L"copy: "} + Long{tc.getTimeMillis()} + L"ms");
+	Console::outln(Integer{copy.size()});
+}
+
+e_void testUtf8() {
+	String text = String{L"2026-10-17 15:41:09 INFO 请求完成 worker-3 request done, "} * 200000;
+	ByteArray bytes{text.length()*3+1};
+	CharArray chars{text.length()+1};
+	TimeCounter tc;
+
+	tc.start();
+	e_int count = WideCharToMultiByte(CP_UTF8, 0, text.toCStr(), text.length(), bytes.toCArray(), bytes.length(), nullptr, nullptr);
+	MultiByteToWideChar(CP_UTF8, 0, bytes.toCArray(), count, chars.toCArray(), chars.length());
+	tc.stop();
+	Console::outln(String{L"WideCharToMultiByte + MultiByteToWideChar: "} + Long{tc.getTimeMillis()} + L"ms");
+
+	tc.start();
+	Utf8String utf8{text};
+	String back = utf8.toString();
+	tc.stop();
+	Console::outln(String{L"Utf8String + toString: "} + Long{tc.getTimeMillis()} + L"ms");
+	Console::outln(String{L"bytes: "} + Integer{utf8.length()} + L" / " + Integer{text.length()*(e_int)sizeof(e_char)});
+	Console::outln(Bool{back.equals(text)});
+}
+
+e_void testStringPool() {
+	const e_int NAMES = 64, ROUNDS = 20000;
+	Vector<String> names;
+	for (e_int i=0; i<NAMES; i++) names.add(String{L"attribute-name-"} + Integer{i});
+
+	HashMap<String, e_int> byString;
+	HashMap<InternedString, e_int> byHandle;
+	Vector<InternedString> handles;
+	for (e_int i=0; i<NAMES; i++) {
+		byString.put(names.get(i), i);
+		handles.add(StringPool::global().intern(names.get(i)));
+		byHandle.put(handles.get(i), i);
+	}
+
+	TimeCounter tc;
+	e_long sum = 0;
+	tc.start();
+	for (e_int r=0; r<ROUNDS; r++)
+		for (e_int i=0; i<NAMES; i++) sum += byString.get(names.get(i));
+	tc.stop();
+	Console::outln(String{L"HashMap<String>: "} + Long{tc.getTimeMillis()} + L"ms");
+
+	tc.start();
+	for (e_int r=0; r<ROUNDS; r++)
+		for (e_int i=0; i<NAMES; i++) sum -= byHandle.get(handles.get(i));
+	tc.stop();
+	Console::outln(String{L"HashMap<InternedString>: "} + Long{tc.getTimeMillis()} + L"ms");
+	Console::outln(Bool{sum == 0});
+}
+
+e_void testFormat() {
+	const e_int ROUNDS = 200000;
+	String name{L"worker"};
+	TimeCounter tc;
+
+	StringBuffer sb{64};
+	tc.start();
+	for (e_int i=0; i<ROUNDS; i++) {
+		sb.clean();
+		sb.appendFormat(L"[%-8s] %05s %s", name, Integer{i}, name);
+	}
+	tc.stop();
+	Console::outln(String{L"appendFormat(String): "} + Long{tc.getTimeMillis()} + L"ms");
+
+	tc.start();
+	for (e_int i=0; i<ROUNDS; i++) {
+		sb.clean();
+		sb.appendFormat(EASY_FORMAT(L"[%-8s] %05s %s"), name, Integer{i}, name);
+	}
+	tc.stop();
+	Console::outln(String{L"appendFormat(EASY_FORMAT): "} + Long{tc.getTimeMillis()} + L"ms");
+	Console::outln(sb.toString());
+}
+
+// 正负都有、位数不等的整数列. 乘积超出 e_int, 用 e_long 计算后截断.
+static IntArray intColumn(e_int count) {
+	IntArray column{count};
+	for (e_int i=0; i<count; i++) column[i] = (e_int)((e_long)i * 7919 - count);
+	return column;
+}
+
+e_void testIntFormat() {
+	const e_int COUNT = 1000000;
+	IntArray column = intColumn(COUNT);
+	TimeCounter tc;
+
+	StringBuffer sb{COUNT * 12};
+	tc.start();
+	for (e_int i=0; i<COUNT; i++) {
+		sb.append(Integer::toString(column[i]));
+		sb.append(L',', 1);
+	}
+	tc.stop();
+	Console::outln(String{L"Integer::toString: "} + Long{tc.getTimeMillis()} + L"ms");
+
+	sb.clean();
+	tc.start();
+	for (e_int i=0; i<COUNT; i++) {
+		Integer::appendTo(sb, column[i]);
+		sb.append(L',', 1);
+	}
+	tc.stop();
+	Console::outln(String{L"Integer::appendTo: "} + Long{tc.getTimeMillis()} + L"ms");
+
+	sb.clean();
+	tc.start();
+	Integer::appendTo(sb, column, StringView{L","});
+	tc.stop();
+	Console::outln(String{L"Integer::appendTo(IntArray): "} + Long{tc.getTimeMillis()} + L"ms");
+}
+
+e_void testIntParse() {
+	const e_int COUNT = 1000000;
+	IntArray column = intColumn(COUNT);
+	StringBuffer sb{COUNT * 12};
+	Integer::appendTo(sb, column, StringView{L","});
+	String text = sb.toString();
+	TimeCounter tc;
+
+	e_int bad = 0;
+	tc.start();
+	for (StringView::Splitter parts = text.view().split(L","); !parts.isEnd(); parts.advance()) {
+		try {
+			Integer::parse(String{parts.current()});
+		} catch (NumberFormatException& e) {
+			bad++;
+		}
+	}
+	tc.stop();
+	Console::outln(String{L"Integer::parse(String): "} + Long{tc.getTimeMillis()} + L"ms, " + Integer{bad} + L" bad");
+
+	IntArray values;
+	IntArray errors;
+	tc.start();
+	bad = Integer::parse(text.toCStr(), text.length(), L',', values, errors);
+	tc.stop();
+	Console::outln(String{L"Integer::parse(const e_char*, ...): "} + Long{tc.getTimeMillis()} + L"ms, " + Integer{bad} + L" bad, "
+		+ (values.equals(column) ? L"same values" : L"different values"));
+}
+
+// [0, 1004) 之间、小数位数不等的 e_double 列. 乘积超出 e_int, 用 e_long 计算.
+static DoubleArray doubleColumn(e_int count) {
+	DoubleArray column{count};
+	for (e_int i=0; i<count; i++) column[i] = ((e_long)i * 7919 % 1000003) / 997.0;
+	return column;
+}
+
+e_void testDoubleFormat() {
+	const e_int COUNT = 1000000;
+	DoubleArray column = doubleColumn(COUNT);
+	TimeCounter tc;
+
+	StringBuffer sb{COUNT * 20};
+	tc.start();
+	Double::appendTo(sb, column, StringView{L","});
+	tc.stop();
+	Console::outln(String{L"Double::appendTo(DoubleArray): "} + Long{tc.getTimeMillis()} + L"ms, "
+		+ Integer{sb.length()} + L" chars");
+}
+
+e_void testDoubleParse() {
+	const e_int COUNT = 1000000;
+	DoubleArray column = doubleColumn(COUNT);
+	StringBuffer sb{COUNT * 20};
+	Double::appendTo(sb, column, StringView{L","});
+	String text = sb.toString();
+	TimeCounter tc;
+
+	e_int index = 0;
+	e_int bad   = 0;
+	tc.start();
+	for (StringView::Splitter parts = text.view().split(L","); !parts.isEnd(); parts.advance()) {
+		const StringView& field = parts.current();
+		e_double d;
+		if (Double::parse(field.data(), field.length(), d) != -1 || d != column[index])
+			bad++;
+		index++;
+	}
+	tc.stop();
+	Console::outln(String{L"Double::parse(const e_char*, e_int, e_double&): "} + Long{tc.getTimeMillis()} + L"ms, "
+		+ Integer{bad} + L" mismatches");
+}
+
+class PiWorker : public Thread {
+public:
+	e_long& inside;
+
+	PiWorker(e_long& result) : inside(result) {}
+
+	void run() override {
+		const e_int COUNT = 1 << 20;
+		Random& random = Random::current();
+		DoubleArray xs{COUNT};
+		DoubleArray ys{COUNT};
+		for (e_int r=0; r<8; r++) {
+			random.fill(xs);
+			random.fill(ys);
+			for (e_int i=0; i<COUNT; i++)
+				if (xs[i]*xs[i] + ys[i]*ys[i] < 1.0) inside++;
+		}
+	}
+}; // PiWorker
+
+e_void testRandom() {
+	const e_int COUNT = 10000000;
+	TimeCounter tc;
+
+	IntArray values{COUNT};
+	tc.start();
+	for (e_int i=0; i<COUNT; i++) values[i] = Math::nextInt();
+	tc.stop();
+	Console::outln(String{L"Math::nextInt: "} + Long{tc.getTimeMillis()} + L"ms");
+
+	tc.start();
+	Random::current().fill(values);
+	tc.stop();
+	Console::outln(String{L"Random::fill(IntArray): "} + Long{tc.getTimeMillis()} + L"ms");
+
+	const e_int THREADS = 4;
+	SharedPointer<Thread> workers[THREADS];
+	e_long results[THREADS] = {0};
+	tc.start();
+	for (e_int i=0; i<THREADS; i++) {
+		workers[i] = SharedPointer<Thread>{new PiWorker(results[i])};
+		workers[i]->start();
+	}
+	e_long inside = 0;
+	for (e_int i=0; i<THREADS; i++) {
+		workers[i]->join();
+		inside += results[i];
+	}
+	tc.stop();
+	Console::outln(String{L"Monte-Carlo pi with "} + Integer{THREADS} + L" threads: "
+		+ Double{4.0 * inside / (THREADS * 8.0 * (1 << 20))} + L", " + Long{tc.getTimeMillis()} + L"ms");
+}
+
+e_void testBatchMath() {
+	const e_int COUNT = 1 << 20;
+	DoubleArray values{COUNT};
+	DoubleArray results{COUNT};
+	Random random{20261017};
+	random.fill(values);
+	TimeCounter tc;
+
+	tc.start();
+	for (e_int i=0; i<COUNT; i++) results[i] = Math::sin(values[i]);
+	tc.stop();
+	Console::outln(String{L"Math::sin(e_double): "} + Long{tc.getTimeMillis()} + L"ms");
+
+	tc.start();
+	Math::sin(values, results);
+	tc.stop();
+	Console::outln(String{L"Math::sin(DoubleArray): "} + Long{tc.getTimeMillis()} + L"ms");
+
+	e_double naive = 0.0;
+	tc.start();
+	for (e_int i=0; i<COUNT; i++) naive += values[i];
+	tc.stop();
+	Console::outln(String{L"loop sum: "} + Double{naive} + L", " + Long{tc.getTimeMillis()} + L"ms");
+
+	tc.start();
+	e_double sum = Math::sum(values);
+	tc.stop();
+	Console::outln(String{L"Math::sum: "} + Double{sum} + L", " + Long{tc.getTimeMillis()} + L"ms");
+	Console::outln(String{L"mean: "} + Double{Math::mean(values)} + L", variance: " + Double{Math::variance(values)});
+}
+
+template<class M>
+e_void benchMap(const String& name, const IntArray& keys, e_int rounds) {
+	e_int count = keys.length();
+	TimeCounter tc;
+	M map;
+
+	tc.start();
+	for (e_int i=0; i<count; i++) map.put(Integer{keys[i]}, Integer{i});
+	tc.stop();
+	e_long putTime = tc.getTimeMillis();
+
+	e_long sum = 0;
+	tc.start();
+	for (e_int r=0; r<rounds; r++)
+		for (e_int i=0; i<count; i++) sum += map.get(Integer{keys[i]}).getValue();
+	tc.stop();
+	e_long getTime = tc.getTimeMillis();
+
+	tc.start();
+	for (e_int i=0; i<count; i++) sum -= map.remove(Integer{keys[i]}).getValue();
+	tc.stop();
+
+	Console::outln(name + L": put " + Long{putTime} + L"ms, get x" + Integer{rounds} + L" "
+		+ Long{getTime} + L"ms, remove " + Long{tc.getTimeMillis()} + L"ms, " + Long{sum});
+}
+
+static e_double ulpDistance(e_double result, e_double expect) {
+	if (result == expect) return 0.0;
+	e_double ulp = ::nextafter(::fabs(expect), INFINITY) - ::fabs(expect);
+	return ::fabs(result - expect) / ulp;
+}
+
+static e_void checkBatchTrig(const String& name, const DoubleArray& values, e_double maxError) {
+	DoubleArray sines;
+	DoubleArray cosines;
+	Math::sin(values, sines);
+	Math::cos(values, cosines);
+
+	e_double sinError = 0.0;
+	e_double cosError = 0.0;
+	for (e_int i=0; i<values.length(); i++) {
+		e_double e = ulpDistance(sines[i], ::sin(values[i]));
+		if (e > sinError) sinError = e;
+		e = ulpDistance(cosines[i], ::cos(values[i]));
+		if (e > cosError) cosError = e;
+	}
+	Console::outln(String{L"Math::sin(DoubleArray) "} + name + L", max error: " + Double{sinError} + L" ulp");
+	Console::outln(String{L"Math::cos(DoubleArray) "} + name + L", max error: " + Double{cosError} + L" ulp");
+	Console::outln(sinError <= maxError && cosError <= maxError);
+}
+
+// 承诺的误差是 1 ulp, 参照值 ::sin/::cos 本身还有最多 0.5 ulp 的误差, 所以和参照值相比允许 1.5 ulp.
+// k*pi/2 和相邻的 double 让约简后的自变量接近 0, 最能暴露约简的精度不足;
+// 随机自变量覆盖整个 [-BATCH_TRIG_LIMIT, BATCH_TRIG_LIMIT], 暴露约简和多项式其余部分的舍入误差.
+e_void testBatchTrig() {
+	const e_double HALF_PI = 1.57079632679489661923;
+	const e_int COUNT = (e_int)(Math::BATCH_TRIG_LIMIT / HALF_PI);
+	DoubleArray values{COUNT * 3};
+	for (e_int k=1; k<=COUNT; k++) {
+		e_double x = k * HALF_PI;
+		values[3*k-3] = x;
+		values[3*k-2] = ::nextafter(x, 0.0);
+		values[3*k-1] = ::nextafter(x, INFINITY);
+	}
+	checkBatchTrig(L"at k*pi/2", values, 1.5);
+
+	Random random{20261017};
+	DoubleArray randoms{4000000};
+	random.fill(randoms);
+	for (e_int i=0; i<randoms.length(); i++) randoms[i] = (randoms[i] * 2.0 - 1.0) * Math::BATCH_TRIG_LIMIT;
+	checkBatchTrig(L"at random", randoms, 1.5);
+}
+
+e_void testFlatHashMap() {
+	const e_int SIZES[] = {1000, 1000000, 50000000};
+	Random random{20261017};
+
+	for (e_int size : SIZES) {
+		// 键互不相同: 下标乘以奇数再异或一个随机数, 相当于 2^30 内的一个置换.
+		IntArray keys{size};
+		e_uint mask = random.nextInt(1 << 30);
+		for (e_int i=0; i<size; i++) keys[i] = (((e_uint)i * 0x2545F491u) ^ mask) & 0x3fffffff;
+		e_int rounds = size < 10000000 ? 10000000 / size : 1;
+
+		Console::outln(String{L"entries: "} + Integer{size});
+		benchMap<HashMap<Integer, Integer>>(String{L"HashMap"}, keys, rounds);
+		benchMap<FlatHashMap<Integer, Integer>>(String{L"FlatHashMap"}, keys, rounds);
+	}
+}
+
+e_void testTryGet() {
+	const e_int COUNT = 100000;
+	HashMap<Integer, Integer> even, odd;
+	for (e_int i=0; i<COUNT; i++) {
+		even.put(Integer{i * 2}, Integer{i});
+		odd.put(Integer{i * 2 + 1}, Integer{i});
+	}
+
+	// 一半命中一半失败, 失败时 get() 抛出异常.
+	TimeCounter tc;
+	e_long hits = 0;
+	tc.start();
+	for (e_int i=0; i<COUNT; i++) {
+		try {
+			hits += even.get(Integer{i}).getValue();
+		} catch (HasNoSuchElementException& e) {}
+	}
+	tc.stop();
+	Console::outln(String{L"get + catch: "} + Long{hits} + L", " + Long{tc.getTimeMillis()} + L"ms");
+
+	hits = 0;
+	tc.start();
+	for (e_int i=0; i<COUNT; i++) {
+		Integer* value = even.tryGet(Integer{i});
+		if (value) hits += value->getValue();
+	}
+	tc.stop();
+	Console::outln(String{L"tryGet: "} + Long{hits} + L", " + Long{tc.getTimeMillis()} + L"ms");
+
+	// 同一个哈希值在两个 map 中查找.
+	hits = 0;
+	tc.start();
+	for (e_int i=0; i<COUNT; i++) {
+		Integer key{i};
+		e_int hash = key.hashCode();
+		Integer* value = even.tryGet(key, hash);
+		if (value == nullptr) value = odd.tryGet(key, hash);
+		hits += value->getValue();
+	}
+	tc.stop();
+	Console::outln(String{L"tryGet with hash: "} + Long{hits} + L", " + Long{tc.getTimeMillis()} + L"ms");
+}
+
+// 没有该属性的节点被跳过, 不会中止查找.
+e_void testNodeByAttr() {
+	LXML::Node root{String{L"root"}};
+	NodeList& nodes = root.getNodeList();
+	nodes.addNodeByTag(String{L"first"});
+	SharedPointer<LXML::Node> second = nodes.addNodeByTag(String{L"second"});
+	second->getAttrMap().addAttr(String{L"id"}, String{L"2"});
+	nodes.addNodeByTag(String{L"third"});
+	SharedPointer<LXML::Node> fourth = nodes.addNodeByTag(String{L"fourth"});
+	fourth->getAttrMap().addAttr(String{L"id"}, String{L"4"});
+
+	Console::outln(nodes.getNodeByAttr(String{L"id"}, String{L"2"})->getTag().equals(String{L"second"}));
+	Console::outln(nodes.getNodeByAttr(String{L"id"}, String{L"4"})->getTag().equals(String{L"fourth"}));
+
+	e_bool thrown = false;
+	try {
+		nodes.getNodeByAttr(String{L"id"}, String{L"3"});
+	} catch (HasNoSuchNodeException& e) {
+		thrown = true;
+	}
+	Console::outln(thrown);
+}
+
+/*
+	逐个计时 put(), 统计延迟分布. 计数器的一个单位通常是 100ns,
+	超过直方图范围的延迟都记在最后一格, 最大值另外记录.
+*/
+e_void benchPutLatency(const String& name, HashMap<Integer, Integer>& map, e_int count) {
+	const e_int BUCKETS = 1 << 16;
+	LongArray histogram{BUCKETS};
+	LARGE_INTEGER frequency, start, stop;
+	::QueryPerformanceFrequency(&frequency);
+	e_long maxTicks = 0, total = 0;
+
+	for (e_int i=0; i<count; i++) {
+		::QueryPerformanceCounter(&start);
+		map.put(Integer{i}, Integer{i});
+		::QueryPerformanceCounter(&stop);
+		e_long ticks = stop.QuadPart - start.QuadPart;
+		histogram[ticks < BUCKETS ? (e_int)ticks : BUCKETS-1]++;
+		if (ticks > maxTicks) maxTicks = ticks;
+		total += ticks;
+	}
+
+	const e_double PERCENTS[] = {0.5, 0.99, 0.999};
+	StringBuffer sb{128};
+	sb.append(name).append(StringView{L": total "}).append(Long{total * 1000 / frequency.QuadPart}).append(StringView{L"ms"});
+	for (e_double p : PERCENTS) {
+		e_long rank = (e_long)(count * p), seen = 0;
+		e_int ticks = 0;
+		while (seen + histogram[ticks] <= rank && ticks < BUCKETS-1) seen += histogram[ticks++];
+		sb.append(StringView{L", p"}).append(Double{p * 100}).append(StringView{L" "})
+		  .append(Long{ticks * 1000000000LL / frequency.QuadPart}).append(StringView{L"ns"});
+	}
+	sb.append(StringView{L", max "}).append(Long{maxTicks * 1000 / frequency.QuadPart}).append(StringView{L"ms"});
+	Console::outln(sb.toString());
+}
+
+e_void testRehashLatency() {
+	const e_int COUNT = 20000000;
+	{
+		HashMap<Integer, Integer> map;
+		benchPutLatency(String{L"rehash at once"}, map, COUNT);
+	}
+	{
+		HashMap<Integer, Integer> map;
+		map.setIncrementalRehash(true);
+		benchPutLatency(String{L"incremental rehash"}, map, COUNT);
+	}
+	{
+		HashMap<Integer, Integer> map;
+		map.reserve(COUNT);
+		benchPutLatency(String{L"reserve"}, map, COUNT);
+	}
+}
+
+const e_int MAP_KEYS = 1 << 20;
+const e_int MAP_OPS  = 2000000;
+
+// 90% 读, 10% 写, 键均匀分布在预先填充的 MAP_KEYS 个键中.
+class ConcurrentMapWorker : public Thread {
+public:
+	ConcurrentHashMap<Integer, Integer>& map;
+	e_long hits;
+
+	ConcurrentMapWorker(ConcurrentHashMap<Integer, Integer>& m) : map(m), hits(0) {}
+
+	void run() override {
+		Random& random = Random::current();
+		Integer value;
+		for (e_int i=0; i<MAP_OPS; i++) {
+			Integer key{random.nextInt(MAP_KEYS)};
+			if (random.nextInt(10) == 0) {
+				map.put(key, Integer{i});
+			} else if (map.tryGet(key, value)) {
+				hits++;
+			}
+		}
+	}
+}; // ConcurrentMapWorker
+
+// 同样的负载, HashMap 由所有线程共享的一把锁保护.
+class LockedMapWorker : public Thread {
+public:
+	HashMap<Integer, Integer>& map;
+	e_long hits;
+
+	LockedMapWorker(HashMap<Integer, Integer>& m) : map(m), hits(0) {}
+
+	void run() override {
+		Random& random = Random::current();
+		for (e_int i=0; i<MAP_OPS; i++) {
+			Integer key{random.nextInt(MAP_KEYS)};
+			e_bool write = random.nextInt(10) == 0;
+			lock();
+			if (write) {
+				map.put(key, Integer{i});
+			} else if (map.tryGet(key)) {
+				hits++;
+			}
+			unlock();
+		}
+	}
+}; // LockedMapWorker
+
+e_void benchConcurrentMap(e_int threads) {
+	ConcurrentHashMap<Integer, Integer> concurrent{MAP_KEYS * 2};
+	HashMap<Integer, Integer> locked;
+	locked.reserve(MAP_KEYS);
+	for (e_int i=0; i<MAP_KEYS; i++) {
+		concurrent.put(Integer{i}, Integer{i});
+		locked.put(Integer{i}, Integer{i});
+	}
+
+	TimeCounter tc;
+	Vector<SharedPointer<Thread>> workers;
+	tc.start();
+	for (e_int i=0; i<threads; i++) {
+		workers.add(SharedPointer<Thread>{new ConcurrentMapWorker(concurrent)});
+		workers[i]->start();
+	}
+	for (e_int i=0; i<threads; i++) workers[i]->join();
+	tc.stop();
+	e_long concurrentMillis = tc.getTimeMillis();
+
+	SharedPointer<Lock> lk{new Lock()};
+	workers.clean();
+	tc.start();
+	for (e_int i=0; i<threads; i++) {
+		workers.add(SharedPointer<Thread>{new LockedMapWorker(locked)});
+		workers[i]->setLock(lk);
+		workers[i]->start();
+	}
+	for (e_int i=0; i<threads; i++) workers[i]->join();
+	tc.stop();
+	e_long lockedMillis = tc.getTimeMillis();
+
+	e_long ops = (e_long)threads * MAP_OPS;
+	Console::outln(String{L"threads "} + Integer{threads}
+		+ L": ConcurrentHashMap " + Long{ops / (concurrentMillis + 1)} + L" ops/ms"
+		+ L", locked HashMap " + Long{ops / (lockedMillis + 1)} + L" ops/ms");
+}
+
+e_void testConcurrentMap() {
+	SYSTEM_INFO info;
+	::GetSystemInfo(&info);
+	e_int cores = (e_int)info.dwNumberOfProcessors;
+	for (e_int threads=1; threads<cores; threads*=2) benchConcurrentMap(threads);
+	benchConcurrentMap(cores);
+}
+
+e_void testBTreeMap() {
+	const e_int COUNT = 2000000;
+	IntArray keys{COUNT};
+	for (e_int i=0; i<COUNT; i++) keys[i] = i;
+	Random& random = Random::current();
+	for (e_int i=COUNT-1; i>0; i--) {
+		e_int j = random.nextInt(i + 1);
+		e_int t = keys[i]; keys[i] = keys[j]; keys[j] = t;
+	}
+
+	TimeCounter tc;
+	TreeMap<Integer, Integer> tree;
+	BTreeMap<Integer, Integer> btree;
+	tc.start();
+	for (e_int i=0; i<COUNT; i++) tree.put(Integer{keys[i]}, Integer{i});
+	tc.stop();
+	Console::outln(String{L"TreeMap put: "} + Long{tc.getTimeMillis()} + L"ms");
+	tc.start();
+	for (e_int i=0; i<COUNT; i++) btree.put(Integer{keys[i]}, Integer{i});
+	tc.stop();
+	Console::outln(String{L"BTreeMap put: "} + Long{tc.getTimeMillis()} + L"ms");
+
+	Array<MapEntry<Integer, Integer>> sorted{COUNT};
+	for (e_int i=0; i<COUNT; i++) sorted[i] = MapEntry<Integer, Integer>{Integer{i}, Integer{i}};
+	tc.start();
+	BTreeMap<Integer, Integer> loaded{sorted};
+	tc.stop();
+	Console::outln(String{L"BTreeMap bulk load: "} + Long{tc.getTimeMillis()} + L"ms");
+
+	e_long sum = 0;
+	tc.start();
+	for (e_int i=0; i<COUNT; i++) sum += tree.get(Integer{keys[COUNT-1-i]}).getValue();
+	tc.stop();
+	Console::outln(String{L"TreeMap get: "} + Long{sum} + L", " + Long{tc.getTimeMillis()} + L"ms");
+
+	sum = 0;
+	tc.start();
+	for (e_int i=0; i<COUNT; i++) sum += btree.get(Integer{keys[COUNT-1-i]}).getValue();
+	tc.stop();
+	Console::outln(String{L"BTreeMap get: "} + Long{sum} + L", " + Long{tc.getTimeMillis()} + L"ms");
+
+	sum = 0;
+	tc.start();
+	for (e_int i=0; i<COUNT; i++) sum += loaded.get(Integer{keys[i]}).getValue();
+	tc.stop();
+	Console::outln(String{L"bulk loaded BTreeMap get: "} + Long{sum} + L", " + Long{tc.getTimeMillis()} + L"ms");
+
+	sum = 0;
+	tc.start();
+	{
+		AutoPointer<Iterator<MapEntry<Integer, Integer>>> iter{tree.iterator()};
+		for (; !iter->isEnd(); iter->advance()) sum += iter->current().m_value.getValue();
+	}
+	tc.stop();
+	Console::outln(String{L"TreeMap scan: "} + Long{sum} + L", " + Long{tc.getTimeMillis()} + L"ms");
+
+	sum = 0;
+	tc.start();
+	{
+		AutoPointer<Iterator<MapEntry<Integer, Integer>>> iter{btree.iterator()};
+		for (; !iter->isEnd(); iter->advance()) sum += iter->current().m_value.getValue();
+	}
+	tc.stop();
+	Console::outln(String{L"BTreeMap scan: "} + Long{sum} + L", " + Long{tc.getTimeMillis()} + L"ms");
+}
+
+e_void testBigMemorySparse() {
+	const e_long SIZE   = 16LL << 30;
+	const e_long REGION = 512LL << 20;
+	const e_int  COUNT  = 1000000;
+	BigMemory bm{SIZE};
+	UByteArray buf{16};
+	for (e_int i=0; i<buf.length(); i++) buf[i] = i;
+	Random& random = Random::current();
+
+	TimeCounter tc;
+	tc.start();
+	for (e_int i=0; i<COUNT; i++) {
+		e_long start = (4LL << 30) + random.nextLong(REGION);
+		bm.write(buf, start, start + buf.length());
+	}
+	tc.stop();
+	Console::outln(String{L"BigMemory write: "} + Long{tc.getTimeMillis()} + L"ms, "
+					+ Long{bm.getAllocatedSize() >> 20} + L"MB allocated");
+
+	e_long sum = 0;
+	tc.start();
+	for (e_int i=0; i<COUNT; i++) {
+		e_long start = (4LL << 30) + random.nextLong(REGION);
+		UByteArray data = bm.read(start, start + 16);
+		sum += data[0];
+	}
+	tc.stop();
+	Console::outln(String{L"BigMemory read: "} + Long{sum} + L", " + Long{tc.getTimeMillis()} + L"ms");
+
+	sum = 0;
+	tc.start();
+	e_int length;
+	for (e_long i=0; i<SIZE; i+=length) {
+		const e_ubyte* bytes = bm.view(i, SIZE, length);
+		sum += bytes[length-1];
+	}
+	tc.stop();
+	Console::outln(String{L"BigMemory view scan: "} + Long{sum} + L", " + Long{tc.getTimeMillis()} + L"ms");
+}
+
+e_void testBigMemorySnapshot() {
+	const e_long SIZE = 1LL << 30;
+	BigMemory bm{SIZE};
+	UByteArray block{1 << 20};
+	for (e_long start=0; start<SIZE; start+=block.length()) {
+		bm.write(block, start, start + block.length());
+	}
+
+	TimeCounter tc;
+	tc.start();
+	const BigMemory checkpoint = bm.snapshot();
+	tc.stop();
+	Console::outln(String{L"BigMemory snapshot: "} + Long{tc.getTimeMillis()} + L"ms");
+
+	UByteArray buf{16};
+	for (e_int i=0; i<buf.length(); i++) buf[i] = i + 1;
+	Random& random = Random::current();
+	tc.start();
+	for (e_int i=0; i<1000; i++) {
+		e_long start = random.nextLong(SIZE - buf.length());
+		bm.write(buf, start, start + buf.length());
+	}
+	tc.stop();
+	Console::outln(String{L"BigMemory write after snapshot: "} + Long{tc.getTimeMillis()} + L"ms");
+	Console::outln(checkpoint.read(0, SIZE >> 10).equals(UByteArray{(e_int)(SIZE >> 10)}));
+	Console::outln(checkpoint.equals(bm));
+}
+
+// 元素为 10, 20, ..., 1000, 逐个与线性查找的结果比较, 包括最小值之下, 最大值之上, 命中和落在两个元素之间.
+e_void testTreeBounds() {
+	TreeSet<Integer> set;
+	TreeMap<Integer, Integer> map;
+	Console::outln(Bool{set.floor(Integer{1}) == nullptr && map.ceiling(Integer{1}) == nullptr});
+	{
+		AutoPointer<Iterator<Integer>> iter{set.lowerBound(Integer{1})};
+		Console::outln(Bool{iter->isEnd()});
+	}
+
+	for (e_int i=100; i>=1; i--) {
+		set.add(Integer{i * 10});
+		map.put(Integer{i * 10}, Integer{i});
+	}
+
+	e_bool ok = true;
+	for (e_int key=0; key<=1010; key++) {
+		e_int floor   = key < 10 ? -1 : (key > 1000 ? 1000 : key / 10 * 10);
+		e_int ceiling = key > 1000 ? -1 : (key < 10 ? 10 : (key + 9) / 10 * 10);
+		e_int upper   = key >= 1000 ? -1 : (key < 10 ? 10 : key / 10 * 10 + 10);
+
+		Integer* setFloor   = set.floor(Integer{key});
+		Integer* setCeiling = set.ceiling(Integer{key});
+		ok = ok && (setFloor ? setFloor->getValue() : -1) == floor;
+		ok = ok && (setCeiling ? setCeiling->getValue() : -1) == ceiling;
+
+		MapEntry<Integer, Integer>* mapFloor   = map.floor(Integer{key});
+		MapEntry<Integer, Integer>* mapCeiling = map.ceiling(Integer{key});
+		ok = ok && (mapFloor ? mapFloor->m_key.getValue() : -1) == floor;
+		ok = ok && (mapCeiling ? mapCeiling->m_value.getValue() * 10 : -1) == ceiling;
+
+		AutoPointer<Iterator<Integer>> lower{set.lowerBound(Integer{key})};
+		AutoPointer<Iterator<Integer>> higher{set.upperBound(Integer{key})};
+		ok = ok && (lower->isEnd() ? -1 : lower->current().getValue()) == ceiling;
+		ok = ok && (higher->isEnd() ? -1 : higher->current().getValue()) == upper;
+
+		AutoPointer<Iterator<MapEntry<Integer, Integer>>> mapLower{map.lowerBound(Integer{key})};
+		AutoPointer<Iterator<MapEntry<Integer, Integer>>> mapHigher{map.upperBound(Integer{key})};
+		ok = ok && (mapLower->isEnd() ? -1 : mapLower->current().m_key.getValue()) == ceiling;
+		ok = ok && (mapHigher->isEnd() ? -1 : mapHigher->current().m_key.getValue()) == upper;
+	}
+	Console::outln(Bool{ok});
+
+	// 从中间开始遍历到结尾, 依次经过之后的每个元素.
+	e_int expect = 260;
+	{
+		AutoPointer<Iterator<Integer>> iter{set.lowerBound(Integer{255})};
+		for (; !iter->isEnd(); iter->advance(), expect += 10) {
+			ok = ok && iter->current().getValue() == expect;
+		}
+	}
+	Console::outln(Bool{ok && expect == 1010});
+
+	expect = 510;
+	{
+		AutoPointer<Iterator<MapEntry<Integer, Integer>>> iter{map.upperBound(Integer{500})};
+		for (; !iter->isEnd(); iter->advance(), expect += 10) {
+			ok = ok && iter->current().m_key.getValue() == expect && iter->current().m_value.getValue() == expect / 10;
+		}
+	}
+	Console::outln(Bool{ok && expect == 1010});
+}
+
+// 统计构造和析构次数, 两者相等说明没有泄漏, 也没有重复析构.
+class CountedString {
+public:
+	static e_int s_constructed;
+	static e_int s_destroyed;
+
+	String m_text;
+
+	CountedString(const String& text) : m_text(text) {s_constructed++;}
+	CountedString(const CountedString& copy) : m_text(copy.m_text) {s_constructed++;}
+	CountedString(CountedString&& move) : m_text(System::move(move.m_text)) {s_constructed++;}
+	~CountedString() {s_destroyed++;}
+
+	CountedString& operator=(const CountedString& copy) {m_text = copy.m_text; return *this;}
+	CountedString& operator=(CountedString&& move) {m_text = System::move(move.m_text); return *this;}
+
+	e_bool equals(const CountedString& other) const {return m_text.equals(other.m_text);}
+	e_int compare(const CountedString& other) const {return m_text.compare(other.m_text);}
+	e_int hashCode() const {return m_text.hashCode();}
+	String toString() const {return m_text;}
+}; // CountedString
+
+e_int CountedString::s_constructed = 0;
+e_int CountedString::s_destroyed   = 0;
+
+static CountedString counted(e_int i) {
+	return CountedString{String{L"counted string number "} + Integer{i}};
+}
+
+static e_bool sameAsRange(const Vector<CountedString>& vector, e_int count) {
+	if (vector.size() != count) return false;
+	for (e_int i=0; i<count; i++) {
+		if (!vector[i].equals(counted(i))) return false;
+	}
+	return true;
+}
+
+e_void testVector() {
+	Console::outln(Bool{!IsTriviallyRelocatable<CountedString>::value && IsTriviallyRelocatable<Integer>::value});
+	{
+		// 参数引用接受者中的元素, 添加时正好扩容.
+		Vector<CountedString> vector;
+		for (e_int i=0; i<vector.capacity(); i++) vector.emplace(counted(i));
+		e_int capacity = vector.capacity();
+		vector.emplace(vector[3]);
+		Console::outln(Bool{vector.capacity() > capacity && vector[capacity].equals(counted(3))});
+		vector.emplace(vector[capacity]);
+		Console::outln(Bool{vector[capacity+1].equals(counted(3))});
+
+		// 在中间构造, 参数也引用接受者中的元素.
+		Vector<CountedString> middle;
+		for (e_int i=0; i<10; i++) middle.emplace(counted(i < 5 ? i : i + 1));
+		middle.emplaceAt(5, String{L"counted string number 5"});
+		Console::outln(Bool{sameAsRange(middle, 11)});
+		middle.emplaceAt(2, middle[7]);
+		Console::outln(Bool{middle[2].equals(counted(7)) && middle[3].equals(counted(2)) && middle[8].equals(counted(7))});
+		middle.remove(2);
+		Console::outln(Bool{sameAsRange(middle, 11)});
+
+		// 预留之后直到 capacity 都不重新分配.
+		Vector<CountedString> reserved;
+		reserved.reserve(100);
+		reserved.emplace(counted(0));
+		CountedString* first = &reserved[0];
+		for (e_int i=1; i<100; i++) reserved.emplace(counted(i));
+		Console::outln(Bool{reserved.capacity() == 100 && &reserved[0] == first});
+		for (e_int i=100; i<1000; i++) reserved.emplace(counted(i));
+		Console::outln(Bool{reserved.capacity() >= 1000 && sameAsRange(reserved, 1000)});
+
+		// 删除首尾和中间的元素.
+		reserved.remove(999);
+		reserved.remove(0);
+		reserved.remove(reserved.size() / 2);
+		Console::outln(Bool{reserved.size() == 997 && reserved[0].equals(counted(1)) && reserved[996].equals(counted(998))});
+		reserved.remove(counted(1));
+		Console::outln(Bool{!reserved.contains(counted(1)) && reserved.size() == 996});
+
+		// 自赋值不改变内容.
+		Vector<CountedString>& alias = reserved;
+		reserved = alias;
+		Console::outln(Bool{reserved.size() == 996 && reserved[0].equals(counted(2))});
+		Vector<CountedString> copy{reserved};
+		Vector<CountedString>& copyAlias = copy;
+		copy = System::move(copyAlias);
+		Console::outln(Bool{copy.size() == 996 && copy.equals(reserved)});
+
+		reserved.shrinkToFit();
+		Console::outln(Bool{reserved.capacity() == 996 && reserved.equals(copy)});
+	}
+	Console::outln(Bool{CountedString::s_constructed == CountedString::s_destroyed});
+}
+
+template<class A>
+e_void benchNodePool(const String& name) {
+	const e_int COUNT = 1000000;
+	Random& random = Random::current();
+	TimeCounter tc;
+
+	Queue<Integer, A> queue;
+	tc.start();
+	for (e_int i=0; i<COUNT; i++) {
+		queue.enqueue(Integer{i});
+		if (i % 4 != 3) queue.enqueue(Integer{i});
+		queue.dequeue();
+	}
+	tc.stop();
+	Console::outln(name + L" Queue churn: " + Long{tc.getTimeMillis()} + L"ms");
+
+	TreeMap<Integer, Integer, A> tree;
+	HashMap<Integer, Integer, A> hash;
+	tc.start();
+	for (e_int i=0; i<COUNT; i++) {
+		Integer key{random.nextInt(COUNT >> 4)};
+		if (tree.contains(key)) {
+			tree.remove(key);
+		} else {
+			tree.put(key, Integer{i});
+		}
+	}
+	tc.stop();
+	Console::outln(name + L" TreeMap put/remove: " + Long{tc.getTimeMillis()} + L"ms");
+
+	tc.start();
+	for (e_int i=0; i<COUNT; i++) {
+		Integer key{random.nextInt(COUNT >> 4)};
+		if (hash.contains(key)) {
+			hash.remove(key);
+		} else {
+			hash.put(key, Integer{i});
+		}
+	}
+	tc.stop();
+	Console::outln(name + L" HashMap put/remove: " + Long{tc.getTimeMillis()} + L"ms");
+}
+
+e_void testNodePool() {
+	benchNodePool<HeapAllocator>(String{L"Heap"});
+	benchNodePool<PoolAllocator>(String{L"Pool"});
+	benchNodePool<ThreadLocalPoolAllocator>(String{L"ThreadLocalPool"});
+
+	NodePoolStats stats = ThreadLocalPoolAllocator::stats();
+	Console::outln(String{L"allocations: "} + Long{stats.m_allocations} + L", frees: " + Long{stats.m_frees}
+			+ L", reused: " + Long{stats.m_reused} + L", slabs: " + Long{stats.m_slabs});
+}
+
 e_int e_main(Array<String>& args) {
 	Console::outln("Hello World.");
 	return 0;